@@ -0,0 +1,418 @@
+/*
+ * Copyright (C) PrivateWeb Software (https://github.com/PrivateWebSoftware) - All Rights Reserved
+ *
+ * Licensed under the Apache License 2.0 (the "License"). You may not use
+ * this file except in compliance with the License. You can obtain a copy
+ * in the file LICENSE in the source distribution
+ *
+ * Written by PrivateWeb Software <privatewebsoftware@protonmail.com>, October 2026
+ */
+
+#include "PWLottieBench.h"
+
+#include <QDir>
+#include <QEventLoop>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QMetaEnum>
+#include <QQuickItem>
+#include <QSysInfo>
+#include <QTimer>
+#include <QtMath>
+
+#include <algorithm>
+
+#include "include/PWLottieCache/PWLottieCache.h"
+#include "include/PWLottieRenderScheduler/PWLottieRenderScheduler.h"
+
+PWLottieBench::PWLottieBench(const Options& options, QObject* parent)
+    : QObject { parent }
+    , m_options(options)
+{
+}
+
+///
+/// \brief PWLottieBench::run - Function measures scene with every controller.
+/// \return Returns JSON document with results of all runs.
+///
+QJsonObject PWLottieBench::run()
+{
+    QJsonObject result;
+
+    if (!prepareCorpus()) {
+        result.insert("error", "Lottie corpus is empty");
+
+        return result;
+    }
+
+    PWLottieRenderScheduler::instance()->setThreadCount(m_options.threadCount);
+
+    /* Every item is inside of window, so culling doesn't hide any work */
+    const qint32 columns = qCeil(qSqrt(qreal(m_options.itemsCount)));
+    const qint32 rows = (m_options.itemsCount + columns - 1) / columns;
+
+    m_window = std::make_unique<QQuickWindow>();
+    m_window->resize(columns * m_options.itemSize, rows * m_options.itemSize);
+    m_window->show();
+
+    QJsonArray runs;
+
+    for (const PWControllerMediator::ControllerType controllerType : std::as_const(m_options.controllers)) {
+        runs.append(measure(controllerType));
+    }
+
+    m_window.reset();
+
+    result.insert("benchmark", "PWLottieBench");
+    result.insert("qtVersion", qVersion());
+    result.insert("platform", QSysInfo::prettyProductName());
+    result.insert("cpu", QSysInfo::currentCpuArchitecture());
+    result.insert("renderThreads", PWLottieRenderScheduler::instance()->threadCount());
+    result.insert("items", m_options.itemsCount);
+    result.insert("itemSize", m_options.itemSize);
+    result.insert("frameRate", m_options.frameRate);
+    result.insert("duration", m_options.duration);
+    result.insert("corpus", m_corpusInfo);
+    result.insert("runs", runs);
+
+    return result;
+}
+
+///
+/// \brief PWLottieBench::prepareCorpus - Function collects real lottie files and generates synthetic ones.
+/// \return Returns false if corpus is empty.
+///
+bool PWLottieBench::prepareCorpus()
+{
+    /* Real animations */
+    if (!m_options.corpusPath.isEmpty()) {
+        const QFileInfoList corpusFiles = QDir(m_options.corpusPath).entryInfoList({ "*.json" }, QDir::Files, QDir::Name);
+
+        for (const QFileInfo& corpusFile : corpusFiles) {
+            m_corpus.append(corpusFile.absoluteFilePath());
+        }
+    }
+
+    /* Generated animations grow in complexity, the last one has holds of identical frames */
+    for (qint32 generatedIndex = 0; generatedIndex < m_options.generatedCount && m_generatedDir.isValid(); ++generatedIndex) {
+        const bool holdFrames = generatedIndex == m_options.generatedCount - 1 && m_options.generatedCount > 1;
+        const qint32 layersCount = 4 << (2 * qMin(generatedIndex, 3));
+        const QString generatedPath = m_generatedDir.filePath(QString("generated-%1-layers%2.json").arg(layersCount).arg(holdFrames ? "-holds" : ""));
+
+        QFile generatedFile(generatedPath);
+        if (!generatedFile.open(QFile::WriteOnly)) {
+            continue;
+        }
+
+        generatedFile.write(generateLottie(layersCount, holdFrames));
+        m_corpus.append(generatedPath);
+    }
+
+    /* Parse corpus before measuring, so loading isn't part of results */
+    for (qsizetype corpusIndex = 0; corpusIndex < m_corpus.size();) {
+        const std::shared_ptr<const PWLottieModel> model = PWLottieCache::instance()->model(m_corpus.at(corpusIndex));
+
+        if (!model) {
+            m_corpus.removeAt(corpusIndex);
+
+            continue;
+        }
+
+        QJsonObject corpusInfo;
+        corpusInfo.insert("name", QFileInfo(m_corpus.at(corpusIndex)).fileName());
+        corpusInfo.insert("bytes", QFileInfo(m_corpus.at(corpusIndex)).size());
+        corpusInfo.insert("frames", model->totalFrames());
+        corpusInfo.insert("frameRate", model->frameRate());
+        m_corpusInfo.append(corpusInfo);
+
+        ++corpusIndex;
+    }
+
+    return !m_corpus.isEmpty();
+}
+
+///
+/// \brief PWLottieBench::generateLottie - Function generates lottie animation with rotating shapes.
+/// \param layersCount - Count of shape layers.
+/// \param holdFrames - Whether half of animation is a hold of identical frames.
+/// \return Returns lottie JSON.
+///
+QByteArray PWLottieBench::generateLottie(const qint32 layersCount, const bool holdFrames)
+{
+    const qint32 side = 512;
+    const qint32 totalFrames = 120;
+    const qint32 motionFrames = holdFrames ? totalFrames / 2 : totalFrames;
+
+    const auto staticValue = [](const QJsonValue& value) {
+        return QJsonObject { { "a", 0 }, { "k", value } };
+    };
+
+    const auto animatedValue = [motionFrames](const qreal from, const qreal to) {
+        const QJsonObject easing = { { "x", QJsonArray { 0.5 } }, { "y", QJsonArray { 0.5 } } };
+
+        return QJsonObject {
+            { "a", 1 },
+            { "k", QJsonArray {
+                       QJsonObject { { "t", 0 }, { "s", QJsonArray { from } }, { "i", easing }, { "o", easing } },
+                       QJsonObject { { "t", motionFrames }, { "s", QJsonArray { to } } },
+                   } },
+        };
+    };
+
+    QJsonArray layers;
+
+    for (qint32 layerIndex = 0; layerIndex < layersCount; ++layerIndex) {
+        const qreal angle = 2 * M_PI * layerIndex / layersCount;
+        const qreal radius = side / 3.0 * (1 + layerIndex % 3) / 3.0;
+        const qreal shapeSide = qMax(8.0, side / qSqrt(qreal(layersCount)) / 2);
+        const qreal hue = qreal(layerIndex) / layersCount;
+
+        const QJsonArray shapes = {
+            QJsonObject {
+                { "ty", "gr" },
+                { "it", QJsonArray {
+                            QJsonObject { { "ty", layerIndex % 2 ? "el" : "rc" }, { "d", 1 }, { "s", staticValue(QJsonArray { shapeSide, shapeSide }) }, { "p", staticValue(QJsonArray { 0, 0 }) }, { "r", staticValue(shapeSide / 4) } },
+                            QJsonObject { { "ty", "fl" }, { "c", staticValue(QJsonArray { hue, 1 - hue, 0.5, 1 }) }, { "o", staticValue(80) }, { "r", 1 } },
+                            QJsonObject { { "ty", "st" }, { "c", staticValue(QJsonArray { 0, 0, 0, 1 }) }, { "o", staticValue(100) }, { "w", staticValue(2) }, { "lc", 2 }, { "lj", 2 } },
+                            QJsonObject { { "ty", "tr" }, { "p", staticValue(QJsonArray { 0, 0 }) }, { "a", staticValue(QJsonArray { 0, 0 }) }, { "s", staticValue(QJsonArray { 100, 100 }) }, { "r", staticValue(0) }, { "o", staticValue(100) } },
+                        } },
+            },
+        };
+
+        layers.append(QJsonObject {
+            { "ddd", 0 },
+            { "ind", layerIndex + 1 },
+            { "ty", 4 },
+            { "nm", QString("Layer %1").arg(layerIndex + 1) },
+            { "sr", 1 },
+            { "ks", QJsonObject {
+                        { "o", staticValue(100) },
+                        { "r", animatedValue(0, 360 * (layerIndex % 2 ? 1 : -1)) },
+                        { "p", staticValue(QJsonArray { side / 2 + radius * qCos(angle), side / 2 + radius * qSin(angle), 0 }) },
+                        { "a", staticValue(QJsonArray { 0, 0, 0 }) },
+                        { "s", staticValue(QJsonArray { 100, 100, 100 }) },
+                    } },
+            { "ao", 0 },
+            { "shapes", shapes },
+            { "ip", 0 },
+            { "op", totalFrames },
+            { "st", 0 },
+            { "bm", 0 },
+        });
+    }
+
+    const QJsonObject lottie = {
+        { "v", "5.7.4" },
+        { "fr", 60 },
+        { "ip", 0 },
+        { "op", totalFrames },
+        { "w", side },
+        { "h", side },
+        { "nm", QString("Generated %1 layers").arg(layersCount) },
+        { "ddd", 0 },
+        { "assets", QJsonArray() },
+        { "layers", layers },
+    };
+
+    return QJsonDocument(lottie).toJson(QJsonDocument::Compact);
+}
+
+///
+/// \brief PWLottieBench::measure - Function shows scene with the given controller and measures it.
+/// \param controllerType - Controller of all items.
+/// \return Returns results of run.
+///
+QJsonObject PWLottieBench::measure(const PWControllerMediator::ControllerType controllerType)
+{
+    /* Build scene */
+    const qint32 columns = qCeil(qSqrt(qreal(m_options.itemsCount)));
+
+    for (qint32 itemIndex = 0; itemIndex < m_options.itemsCount; ++itemIndex) {
+        PWLottieItem* const lottieItem = new PWLottieItem();
+
+        lottieItem->setParentItem(m_window->contentItem());
+        lottieItem->setPosition(QPointF((itemIndex % columns) * m_options.itemSize, (itemIndex / columns) * m_options.itemSize));
+        lottieItem->setSize(QSizeF(m_options.itemSize, m_options.itemSize));
+        lottieItem->setAsynchronous(false);
+        lottieItem->setFrameRate(m_options.frameRate);
+        lottieItem->setController(controllerType);
+        lottieItem->setSourceSize(QSizeF(m_options.itemSize, m_options.itemSize));
+        lottieItem->setSource(m_corpus.at(itemIndex % m_corpus.size()));
+
+        m_lottieItems.append(lottieItem);
+    }
+
+    /* Controllers, frame analysis and sprite sheets settle before measuring */
+    wait(benchWarmUpTime);
+
+    QList<quint64> renderedFrames;
+    quint64 droppedFrames = 0;
+    quint64 coalescedFrames = 0;
+
+    for (const PWLottieItem* const lottieItem : std::as_const(m_lottieItems)) {
+        renderedFrames.append(lottieItem->renderedFrames());
+        droppedFrames -= lottieItem->droppedFrames();
+        coalescedFrames -= lottieItem->coalescedFrames();
+    }
+
+    resetPeakMemory();
+
+    /* Every display frame collects render times of items that have shown new frames since previous one */
+    RunSamples runSamples;
+    QList<quint64> sampledFrames = renderedFrames;
+    QElapsedTimer runTimer;
+
+    const QMetaObject::Connection frameSwappedConnection = connect(m_window.get(), &QQuickWindow::frameSwapped, this, [this, &runSamples, &sampledFrames, &runTimer]() {
+        const qint64 frameTime = runTimer.nsecsElapsed();
+
+        if (runSamples.lastFrameTime >= 0) {
+            runSamples.displayFrameIntervals.append(frameTime - runSamples.lastFrameTime);
+        }
+
+        runSamples.lastFrameTime = frameTime;
+
+        for (qsizetype itemIndex = 0; itemIndex < m_lottieItems.size(); ++itemIndex) {
+            const quint64 itemFrames = m_lottieItems.at(itemIndex)->renderedFrames();
+
+            if (itemFrames != sampledFrames.at(itemIndex)) {
+                runSamples.renderTimes.append(m_lottieItems.at(itemIndex)->lastRenderTime());
+                sampledFrames[itemIndex] = itemFrames;
+            }
+        }
+    });
+
+    QTimer threadsTimer;
+    connect(&threadsTimer, &QTimer::timeout, this, [&runSamples]() {
+        runSamples.maxThreadsCount = qMax<qint32>(runSamples.maxThreadsCount, processStatus("Threads"));
+    });
+
+    runTimer.start();
+    threadsTimer.start(100);
+
+    wait(m_options.duration * 1000);
+
+    threadsTimer.stop();
+    disconnect(frameSwappedConnection);
+
+    const qreal runTime = runTimer.nsecsElapsed() / qreal(1000000000);
+
+    /* Collect results */
+    quint64 totalFrames = 0;
+
+    for (qsizetype itemIndex = 0; itemIndex < m_lottieItems.size(); ++itemIndex) {
+        totalFrames += m_lottieItems.at(itemIndex)->renderedFrames() - renderedFrames.at(itemIndex);
+        droppedFrames += m_lottieItems.at(itemIndex)->droppedFrames();
+        coalescedFrames += m_lottieItems.at(itemIndex)->coalescedFrames();
+    }
+
+    QJsonObject result;
+    result.insert("controller", QMetaEnum::fromType<PWControllerMediator::ControllerType>().valueToKey(controllerType));
+    result.insert("framesPerSecond", totalFrames / runTime);
+    result.insert("itemFramesPerSecond", totalFrames / runTime / m_lottieItems.size());
+    result.insert("displayFramesPerSecond", (runSamples.displayFrameIntervals.size() + 1) / runTime);
+    result.insert("renderTime", percentiles(runSamples.renderTimes));
+    result.insert("displayFrameInterval", percentiles(runSamples.displayFrameIntervals));
+    result.insert("droppedFrames", qint64(droppedFrames));
+    result.insert("coalescedFrames", qint64(coalescedFrames));
+    result.insert("peakRssKiB", processStatus("VmHWM"));
+    result.insert("maxThreads", runSamples.maxThreadsCount > 0 ? runSamples.maxThreadsCount : -1);
+
+    /* Tear down scene, rendering jobs that are still running finish before items are deleted */
+    for (PWLottieItem* const lottieItem : std::as_const(m_lottieItems)) {
+        lottieItem->pause();
+    }
+
+    wait(benchSettleTime);
+
+    qDeleteAll(m_lottieItems);
+    m_lottieItems.clear();
+
+    wait(benchSettleTime);
+
+    return result;
+}
+
+///
+/// \brief PWLottieBench::wait - Function processes events for the given time.
+/// \param time - Time in milliseconds.
+///
+void PWLottieBench::wait(const qint32 time)
+{
+    QEventLoop eventLoop;
+    QTimer::singleShot(time, &eventLoop, &QEventLoop::quit);
+
+    eventLoop.exec();
+}
+
+///
+/// \brief PWLottieBench::percentiles - Function gets percentiles of samples.
+/// \param samples - Samples in nanoseconds.
+/// \return Returns JSON object with percentiles in milliseconds.
+///
+QJsonObject PWLottieBench::percentiles(QList<qint64> samples)
+{
+    QJsonObject result;
+    result.insert("samples", samples.size());
+
+    if (samples.isEmpty()) {
+        return result;
+    }
+
+    std::sort(samples.begin(), samples.end());
+
+    const auto percentile = [&samples](const qreal rank) {
+        return samples.at(qMin(samples.size() - 1, qsizetype(rank * samples.size()))) / qreal(1000000);
+    };
+
+    result.insert("p50", percentile(0.50));
+    result.insert("p90", percentile(0.90));
+    result.insert("p99", percentile(0.99));
+    result.insert("max", samples.last() / qreal(1000000));
+
+    return result;
+}
+
+///
+/// \brief PWLottieBench::processStatus - Function reads value from '/proc/self/status'.
+/// \param name - Name of value.
+/// \return Returns value or '-1' if it can't be read.
+///
+qint64 PWLottieBench::processStatus(const QByteArray& name)
+{
+    /* Files in '/proc' report zero size, readAll() still reads them till the end */
+    QFile statusFile("/proc/self/status");
+    if (!statusFile.open(QFile::ReadOnly)) {
+        return -1;
+    }
+
+    const QList<QByteArray> statusLines = statusFile.readAll().split('\n');
+
+    for (const QByteArray& statusLine : statusLines) {
+        if (!statusLine.startsWith(name + ':')) {
+            continue;
+        }
+
+        /* Values look like 'VmHWM:    12345 kB' or 'Threads:    12' */
+        const QList<QByteArray> values = statusLine.mid(name.size() + 1).simplified().split(' ');
+
+        bool converted = false;
+        const qint64 value = values.first().toLongLong(&converted);
+
+        return converted ? value : -1;
+    }
+
+    return -1;
+}
+
+///
+/// \brief PWLottieBench::resetPeakMemory - Function resets peak resident memory of process, so it's measured per run.
+///
+void PWLottieBench::resetPeakMemory()
+{
+    /* Linux resets 'VmHWM' to current resident memory, other systems just keep peak of the whole process */
+    QFile clearRefsFile("/proc/self/clear_refs");
+    if (clearRefsFile.open(QFile::WriteOnly)) {
+        clearRefsFile.write("5");
+    }
+}
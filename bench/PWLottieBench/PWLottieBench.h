@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) PrivateWeb Software (https://github.com/PrivateWebSoftware) - All Rights Reserved
+ *
+ * Licensed under the Apache License 2.0 (the "License"). You may not use
+ * this file except in compliance with the License. You can obtain a copy
+ * in the file LICENSE in the source distribution
+ *
+ * Written by PrivateWeb Software <privatewebsoftware@protonmail.com>, October 2026
+ */
+
+#ifndef PWLOTTIEBENCH_H
+#define PWLOTTIEBENCH_H
+
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QList>
+#include <QObject>
+#include <QQuickWindow>
+#include <QString>
+#include <QStringList>
+#include <QTemporaryDir>
+
+#include <memory>
+
+#include <PWLottieItem.h>
+
+///
+/// \brief The PWLottieBench class - Headless benchmark of the render pipeline.
+///
+/// Bench shows a grid of PWLottieItems in offscreen window, all of them are visible, so nothing is culled.
+/// Sources are taken in turn from corpus of real and generated lottie files. The same scene is measured
+/// once per controller, results of every run are collected in one JSON document.
+///
+class PWLottieBench : public QObject {
+    Q_OBJECT
+
+#define benchWarmUpTime 1000
+#define benchSettleTime 250
+
+public:
+    ///
+    /// \brief The Options struct - Options of benchmark, they are set from command line.
+    ///
+    struct Options {
+        qint32 itemsCount = 48;
+        qint32 itemSize = 128;
+        qint32 duration = 10;
+        qint32 frameRate = 60;
+        qint32 generatedCount = 3;
+        qint32 threadCount = 0;
+        QString corpusPath;
+        QList<PWControllerMediator::ControllerType> controllers = {};
+    };
+
+    explicit PWLottieBench(const Options& options, QObject* parent = nullptr);
+
+    /*************/
+    /* Functions */
+    /*************/
+
+    ///
+    /// \brief run - Function measures scene with every controller.
+    /// \return Returns JSON document with results of all runs.
+    ///
+    [[nodiscard]] QJsonObject run();
+
+private:
+    ///
+    /// \brief The RunSamples struct - Samples that are collected while scene is measured.
+    ///
+    struct RunSamples {
+        QList<qint64> renderTimes = {};
+        QList<qint64> displayFrameIntervals = {};
+        qint64 lastFrameTime = -1;
+        qint32 maxThreadsCount = 0;
+    };
+
+    /*************/
+    /* Functions */
+    /*************/
+
+    ///
+    /// \brief prepareCorpus - Function collects real lottie files and generates synthetic ones.
+    /// \return Returns false if corpus is empty.
+    ///
+    bool prepareCorpus();
+
+    ///
+    /// \brief generateLottie - Function generates lottie animation with rotating shapes.
+    /// \param layersCount - Count of shape layers.
+    /// \param holdFrames - Whether half of animation is a hold of identical frames.
+    /// \return Returns lottie JSON.
+    ///
+    [[nodiscard]] static QByteArray generateLottie(const qint32 layersCount, const bool holdFrames);
+
+    ///
+    /// \brief measure - Function shows scene with the given controller and measures it.
+    /// \param controllerType - Controller of all items.
+    /// \return Returns results of run.
+    ///
+    [[nodiscard]] QJsonObject measure(const PWControllerMediator::ControllerType controllerType);
+
+    ///
+    /// \brief wait - Function processes events for the given time.
+    /// \param time - Time in milliseconds.
+    ///
+    static void wait(const qint32 time);
+
+    ///
+    /// \brief percentiles - Function gets percentiles of samples.
+    /// \param samples - Samples in nanoseconds.
+    /// \return Returns JSON object with percentiles in milliseconds.
+    ///
+    [[nodiscard]] static QJsonObject percentiles(QList<qint64> samples);
+
+    ///
+    /// \brief processStatus - Function reads value from '/proc/self/status'.
+    /// \param name - Name of value.
+    /// \return Returns value or '-1' if it can't be read.
+    ///
+    [[nodiscard]] static qint64 processStatus(const QByteArray& name);
+
+    ///
+    /// \brief resetPeakMemory - Function resets peak resident memory of process, so it's measured per run.
+    ///
+    static void resetPeakMemory();
+
+    /*************/
+    /* Variables */
+    /*************/
+
+    Options m_options;
+
+    QTemporaryDir m_generatedDir;
+    QStringList m_corpus = {};
+    QJsonArray m_corpusInfo = {};
+
+    std::unique_ptr<QQuickWindow> m_window = nullptr;
+    QList<PWLottieItem*> m_lottieItems = {};
+};
+
+#endif // PWLOTTIEBENCH_H
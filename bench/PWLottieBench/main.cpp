@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) PrivateWeb Software (https://github.com/PrivateWebSoftware) - All Rights Reserved
+ *
+ * Licensed under the Apache License 2.0 (the "License"). You may not use
+ * this file except in compliance with the License. You can obtain a copy
+ * in the file LICENSE in the source distribution
+ *
+ * Written by PrivateWeb Software <privatewebsoftware@protonmail.com>, October 2026
+ */
+
+#include <QCommandLineParser>
+#include <QFile>
+#include <QGuiApplication>
+#include <QJsonDocument>
+#include <QMetaEnum>
+#include <QQuickWindow>
+#include <QTextStream>
+
+#include "PWLottieBench.h"
+
+int main(int argc, char* argv[])
+{
+    /* Bench is headless, scene is rendered by software backend in offscreen window */
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    QQuickWindow::setGraphicsApi(QSGRendererInterface::Software);
+
+    QGuiApplication app(argc, argv);
+    QGuiApplication::setApplicationName("PWLottieBench");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Headless benchmark of PWLottie render pipeline, results are written as JSON.");
+    parser.addHelpOption();
+
+    const QCommandLineOption itemsOption("items", "Count of lottie items in scene.", "count", "48");
+    const QCommandLineOption sizeOption("size", "Size of every item and it's source size in pixels.", "pixels", "128");
+    const QCommandLineOption durationOption("duration", "Measured time of every run in seconds.", "seconds", "10");
+    const QCommandLineOption frameRateOption("frame-rate", "Framerate of items.", "fps", "60");
+    const QCommandLineOption corpusOption("corpus", "Directory with real lottie files.", "path", PWLOTTIE_BENCH_CORPUS_PATH);
+    const QCommandLineOption generatedOption("generated", "Count of generated lottie files.", "count", "3");
+    const QCommandLineOption threadsOption("threads", "Count of render threads, '0' to use count of cores.", "count", "0");
+    const QCommandLineOption controllersOption("controllers", "Comma separated controllers that are compared.", "list", "NoController,BaseController,IconController,AdaptiveController,BudgetController");
+    const QCommandLineOption outputOption("output", "File where JSON results are written, standard output by default.", "file");
+
+    parser.addOptions({ itemsOption, sizeOption, durationOption, frameRateOption, corpusOption, generatedOption, threadsOption, controllersOption, outputOption });
+    parser.process(app);
+
+    PWLottieBench::Options options;
+    options.itemsCount = qMax(1, parser.value(itemsOption).toInt());
+    options.itemSize = qMax(1, parser.value(sizeOption).toInt());
+    options.duration = qMax(1, parser.value(durationOption).toInt());
+    options.frameRate = qMax(1, parser.value(frameRateOption).toInt());
+    options.corpusPath = parser.value(corpusOption);
+    options.generatedCount = qMax(0, parser.value(generatedOption).toInt());
+    options.threadCount = qMax(0, parser.value(threadsOption).toInt());
+
+    const QMetaEnum controllerTypes = QMetaEnum::fromType<PWControllerMediator::ControllerType>();
+
+    for (const QString& controllerName : parser.value(controllersOption).split(',', Qt::SkipEmptyParts)) {
+        bool found = false;
+        const qint32 controllerType = controllerTypes.keyToValue(controllerName.trimmed().toLatin1().constData(), &found);
+
+        if (!found) {
+            qCritical() << "Unknown controller:" << controllerName;
+
+            return 1;
+        }
+
+        options.controllers.append(PWControllerMediator::ControllerType(controllerType));
+    }
+
+    PWLottieBench bench(options);
+    const QJsonObject result = bench.run();
+    const QByteArray resultJson = QJsonDocument(result).toJson(QJsonDocument::Indented);
+
+    if (parser.isSet(outputOption)) {
+        QFile outputFile(parser.value(outputOption));
+        if (!outputFile.open(QFile::WriteOnly | QFile::Truncate)) {
+            qCritical() << "Couldn't open output file with error:" << outputFile.errorString();
+
+            return 1;
+        }
+
+        outputFile.write(resultJson);
+    } else {
+        QTextStream(stdout) << resultJson;
+    }
+
+    return result.contains("error") ? 1 : 0;
+}
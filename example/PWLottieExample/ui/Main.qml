@@ -68,7 +68,7 @@ ApplicationWindow {
 
             Material.accent: "#ff571a"
 
-            model: [ "NoController", "BaseController" ]
+            model: [ "NoController", "BaseController", "AdaptiveController" ]
 
             anchors {
                 top: parent.top
@@ -86,6 +86,8 @@ ApplicationWindow {
                                  lottieItemsListView.changeControllerChanged(ControllerType.NoController)
                              } else if (index === 1) {
                                  lottieItemsListView.changeControllerChanged(ControllerType.BaseController)
+                             } else if (index === 2) {
+                                 lottieItemsListView.changeControllerChanged(ControllerType.AdaptiveController)
                              }
                          }
         }
@@ -207,7 +209,7 @@ ApplicationWindow {
                     smooth: true
 
                     source: lottieSource
-                    controller: (controllerTypeComboBox.currentIndex === 1) ? ControllerType.BaseController : ControllerType.NoController
+                    controller: (controllerTypeComboBox.currentIndex === 1) ? ControllerType.BaseController : (controllerTypeComboBox.currentIndex === 2) ? ControllerType.AdaptiveController : ControllerType.NoController
 
                     frameRate: 60
                     loops: 0
@@ -11,18 +11,25 @@
 #ifndef PWCONTROLLERMEDIATOR_H
 #define PWCONTROLLERMEDIATOR_H
 
+#include <QList>
 #include <QObject>
-#include <QString>
+#include <QPointer>
 
+#include "include/PWLottieControllers/PWLottieAdaptiveController.h"
 #include "include/PWLottieControllers/PWLottieBaseController.h"
+#include "include/PWLottieControllers/PWLottieBudgetController.h"
 #include "include/PWLottieControllers/PWLottieIconController.h"
 
+class PWLottieItem;
+
 ///
 /// \brief The PWControllerMediator class - A class whose task is to reduce coupling between controllers and QML Item. Class provides functional for controllers.
 ///
 class PWControllerMediator : public QObject {
     Q_OBJECT
 
+#define controllerTypesCount 5
+
 public:
     explicit PWControllerMediator(QObject* parent = nullptr);
 
@@ -36,7 +43,9 @@ public:
     enum ControllerType {
         NoController = 0,
         BaseController = 1,
-        IconController = 2
+        IconController = 2,
+        AdaptiveController = 3,
+        BudgetController = 4
     };
     Q_ENUM(ControllerType)
 
@@ -57,34 +66,128 @@ public:
         return m_instance;
     }
 
+    ///
+    /// \brief registerLottieItem - Registers lottie item in registry, it's handle is used by controllers instead of item.
+    /// \param lottieItem - Lottie item that will be registered.
+    /// \return Returns handle of lottie item, it stays valid until item is unregistered.
+    ///
+    static PWLottieHandle registerLottieItem(PWLottieItem* lottieItem);
+
+    ///
+    /// \brief unregisterLottieItem - Unregisters lottie item from registry and from it's controller, handle can be reused after it.
+    /// \param lottieHandle - Handle of lottie item.
+    ///
+    static void unregisterLottieItem(const PWLottieHandle lottieHandle);
+
     ///
     /// \brief registerLottieAnimation - Registers lottie item in control system.
     /// \param controllerType - Controller type, that will register lottie item in it's own system.
-    /// \param lottieUuid - Unique lottie item ID with that ID lottie item will be registered.
+    /// \param lottieItemInfo - Handle with that lottie item will be registered, it's size and priority.
     /// \return Returns current fps of registred lotti animation.
     ///
-    static quint16 registerLottieAnimation(const ControllerType controllerType, const QString& lottieUuid);
+    static quint16 registerLottieAnimation(const ControllerType controllerType, const PWLottieItemInfo& lottieItemInfo);
+
+    ///
+    /// \brief updateLottieAnimation - Updates size and priority of lottie item in control system.
+    /// \param controllerType - Controller type, in which lottie item is registered.
+    /// \param lottieItemInfo - Handle of lottie item, it's size and priority.
+    ///
+    static void updateLottieAnimation(const ControllerType controllerType, const PWLottieItemInfo& lottieItemInfo);
 
     ///
     /// \brief unregisterLottieAnimation - Unregisters lottie item in control system.
     /// \attention unregisterLottieAnimation() must be always run if "registerLottieAnimation" was used before PWLottieItem delted.
     ///
     /// \param controllerType - Controller type, that will register lottie item in it's own system.
-    /// \param lottieUuid- Unique lottie item ID with that ID lottie item will be unregistered.
+    /// \param lottieHandle - Handle of lottie item that will be unregistered.
+    ///
+    static void unregisterLottieAnimation(const ControllerType controllerType, const PWLottieHandle lottieHandle);
+
+    ///
+    /// \brief reportRenderTime - Reports time of rendered frame of lottie item to it's controller.
+    /// \param controllerType - Controller type, in which lottie item is registered.
+    /// \param lottieHandle - Handle of lottie item.
+    /// \param renderTime - Time of rendering in nanoseconds.
+    ///
+    static void reportRenderTime(const ControllerType controllerType, const PWLottieHandle lottieHandle, const qint64 renderTime);
+
+    ///
+    /// \brief lottieItems - Function gets all registered lottie items.
+    /// \return Returns list of items, that are alive now.
+    ///
+    [[nodiscard]] static QList<PWLottieItem*> lottieItems();
+
+    ///
+    /// \brief iconController - Function gives access to icon controller, that keeps sprite sheets of icons and their budgets.
+    /// \return Returns pointer to PWLottieIconController.
     ///
-    static void unregisterLottieAnimation(const ControllerType controllerType, const QString& lottieUuid);
+    static inline PWLottieIconController* iconController()
+    {
+        return &m_lottieIconController;
+    }
 
-signals:
     ///
-    /// \brief fpsChanged - Signal that supports functional of PWLottieBaseController and PWLottieIconController
+    /// \brief adaptiveController - Function gives access to adaptive controller, that keeps it's mode and target framerate.
+    /// \return Returns pointer to PWLottieAdaptiveController.
     ///
-    void fpsChanged(const qint16 fps, const ControllerType controllerType, const QString& lottieUuid);
+    static inline PWLottieAdaptiveController* adaptiveController()
+    {
+        return &m_lottieAdaptiveController;
+    }
+
+    ///
+    /// \brief budgetController - Function gives access to budget controller, that keeps rasterisation budget and framerate range.
+    /// \return Returns pointer to PWLottieBudgetController.
+    ///
+    static inline PWLottieBudgetController* budgetController()
+    {
+        return &m_lottieBudgetController;
+    }
 
 private:
+    ///
+    /// \brief The RegistryEntry struct - Registered lottie item, it's controller and it's position in list of controller's items.
+    ///
+    struct RegistryEntry {
+        PWLottieItem* lottieItem = nullptr;
+        ControllerType controllerType = ControllerType::NoController;
+        qsizetype controllerIndex = -1;
+    };
+
+    /*************/
+    /* Functions */
+    /*************/
+
+    ///
+    /// \brief controller - Function gets controller of controller type.
+    /// \param controllerType - Controller type.
+    /// \return Returns controller or nullptr for 'NoController'.
+    ///
+    [[nodiscard]] static PWLottieAbstractController* controller(const ControllerType controllerType);
+
+    ///
+    /// \brief notifyFrameRate - Function sets framerate that controller calculated in one lottie item or in all items of controller.
+    /// \param controllerType - Controller type that calculated framerate.
+    /// \param fps - Framerate.
+    /// \param lottieHandle - Handle of lottie item or 'allLottiesHandle'.
+    ///
+    static void notifyFrameRate(const ControllerType controllerType, const quint16 fps, const PWLottieHandle lottieHandle);
+
+    /*************/
+    /* Variables */
+    /*************/
+
     inline static quint16 m_standardFps = 30;
 
+    /* Registry is indexed by handles, handles of deleted items are reused */
+    inline static QList<RegistryEntry> m_registry = {};
+    inline static QList<PWLottieHandle> m_freeHandles = {};
+    inline static QList<PWLottieHandle> m_controllerHandles[controllerTypesCount] = {};
+
     inline static PWLottieBaseController m_lottieBasicController;
     inline static PWLottieIconController m_lottieIconController;
+    inline static PWLottieAdaptiveController m_lottieAdaptiveController;
+    inline static PWLottieBudgetController m_lottieBudgetController;
 
     inline static QPointer<PWControllerMediator> m_instance;
 };
@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) PrivateWeb Software (https://github.com/PrivateWebSoftware) - All Rights Reserved
+ *
+ * Licensed under the Apache License 2.0 (the "License"). You may not use
+ * this file except in compliance with the License. You can obtain a copy
+ * in the file LICENSE in the source distribution
+ *
+ * Written by PrivateWeb Software <privatewebsoftware@protonmail.com>, October 2026
+ */
+
+#ifndef PWLOTTIEBUFFERPOOL_H
+#define PWLOTTIEBUFFERPOOL_H
+
+#include <QHash>
+#include <QImage>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSize>
+
+#include <vector>
+
+///
+/// \brief The PWLottieBufferPool class - Process-wide pool of pixel buffers shared by all lottie items.
+///
+/// Buffers are grouped in size classes, every power of two is split in four classes, so reused buffer is
+/// never more than a quarter bigger than needed. Images that are taken from pool give their buffer back
+/// when the last copy of image is destroyed, so buffers of deleted and resized items are recycled without
+/// any calls. Retention limit bounds only free buffers that are kept for reuse, they are kept while memory of pool
+/// stays under it. Memory limit is a cap of the whole pool: image that doesn't fit in it even after free buffers are
+/// freed gets it's own buffer outside of pool, that isn't counted and isn't reused, and every such image is counted
+/// as a limit hit. Buffers that are used are never taken away, so pool is over it's limit only after it was lowered.
+///
+class PWLottieBufferPool {
+
+#define defaultBufferPoolRetentionLimit 128 * 1024 * 1024
+#define defaultBufferPoolMemoryLimit 256 * 1024 * 1024
+#define bufferAlignment 64
+
+public:
+    /*************/
+    /* Functions */
+    /*************/
+
+    ///
+    /// \brief instance - Singleton instance funtion, cause we need only one buffer pool for hole application.
+    /// \return Instance to PWLottieBufferPool class.
+    ///
+    static PWLottieBufferPool* instance();
+
+    ///
+    /// \brief image - Function gets image with pooled buffer, it's content is undefined.
+    /// \attention Function is thread-safe and can be called from render workers.
+    ///
+    /// \param size - Size of image.
+    /// \param format - Format of image with 4 bytes per pixel.
+    /// \return Returns image, that gives it's buffer back to pool when it's destroyed.
+    ///
+    [[nodiscard]] QImage image(const QSize& size, const QImage::Format format);
+
+    ///
+    /// \brief clear - Function frees all buffers that aren't used now.
+    ///
+    void clear();
+
+    /*****************/
+    /* Memory limits */
+    /*****************/
+
+    [[nodiscard]] qint64 retentionLimit();
+
+    ///
+    /// \brief setRetentionLimit - Function sets memory above which released buffers are freed instead of kept, it doesn't limit used buffers.
+    /// \param retentionLimit - Retention limit in bytes.
+    ///
+    void setRetentionLimit(const qint64 retentionLimit);
+
+    [[nodiscard]] qint64 memoryLimit();
+
+    ///
+    /// \brief setMemoryLimit - Function sets cap of pool memory, images over it get buffers outside of pool.
+    /// \param memoryLimit - Memory limit in bytes.
+    ///
+    void setMemoryLimit(const qint64 memoryLimit);
+
+    ///
+    /// \brief memoryUsage - Function gets memory of all buffers, that are used or kept free.
+    /// \return Returns memory in bytes.
+    ///
+    [[nodiscard]] qint64 memoryUsage();
+
+    [[nodiscard]] qint64 peakMemoryUsage();
+    [[nodiscard]] qint64 freeMemory();
+
+    /**************/
+    /* Statistics */
+    /**************/
+
+    [[nodiscard]] quint64 reuses();
+    [[nodiscard]] quint64 allocations();
+    [[nodiscard]] quint64 limitHits();
+
+private:
+    PWLottieBufferPool() { }
+
+    /*************/
+    /* Functions */
+    /*************/
+
+    ///
+    /// \brief sizeClass - Function gets size class of buffer that fits the given size.
+    /// \param bytes - Needed size in bytes.
+    /// \return Returns size of buffer in bytes.
+    ///
+    [[nodiscard]] static qsizetype sizeClass(const qsizetype bytes);
+
+    ///
+    /// \brief releaseBuffer - Function is called by QImage when the last copy of image is destroyed.
+    /// \param buffer - Buffer of image.
+    ///
+    static void releaseBuffer(void* buffer);
+
+    ///
+    /// \brief trimFreeBuffers - Function frees free buffers until pool fits in the given memory, must be called under lock.
+    /// \param memoryLimit - Memory that can stay used after trimming.
+    ///
+    void trimFreeBuffers(const qint64 memoryLimit);
+
+    /*************/
+    /* Variables */
+    /*************/
+
+    QMutex m_mutex;
+
+    QHash<qsizetype, std::vector<uchar*>> m_freeBuffers = {};
+    QHash<uchar*, qsizetype> m_bufferSizes = {};
+
+    qint64 m_memoryUsage = 0;
+    qint64 m_peakMemoryUsage = 0;
+    qint64 m_freeMemory = 0;
+    qint64 m_retentionLimit = defaultBufferPoolRetentionLimit;
+    qint64 m_memoryLimit = defaultBufferPoolMemoryLimit;
+
+    quint64 m_reuses = 0;
+    quint64 m_allocations = 0;
+    quint64 m_limitHits = 0;
+};
+
+#endif // PWLOTTIEBUFFERPOOL_H
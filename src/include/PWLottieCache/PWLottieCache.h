@@ -0,0 +1,230 @@
+/*
+ * Copyright (C) PrivateWeb Software (https://github.com/PrivateWebSoftware) - All Rights Reserved
+ *
+ * Licensed under the Apache License 2.0 (the "License"). You may not use
+ * this file except in compliance with the License. You can obtain a copy
+ * in the file LICENSE in the source distribution
+ *
+ * Written by PrivateWeb Software <privatewebsoftware@protonmail.com>, October 2026
+ */
+
+#ifndef PWLOTTIECACHE_H
+#define PWLOTTIECACHE_H
+
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QJSEngine>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QObject>
+#include <QQmlEngine>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QWaitCondition>
+
+#include <functional>
+#include <memory>
+
+#include "include/PWLottieCache/PWLottieModel.h"
+
+///
+/// \brief The PWLottieCache class - Process-wide cache of parsed lottie animations.
+///
+/// Models are keyed by hash of their content, so two different assets with the same file name never collide,
+/// and the same asset loaded from different paths is parsed only once. Models that aren't used by any item
+/// are evicted in least recently used order when memory budget is exceeded.
+///
+class PWLottieCache : public QObject {
+    Q_OBJECT
+    QML_ELEMENT
+    QML_SINGLETON
+
+    Q_PROPERTY(qint64 memoryBudget READ memoryBudget WRITE setMemoryBudget NOTIFY memoryBudgetChanged)
+    Q_PROPERTY(qint64 memoryUsage READ memoryUsage NOTIFY memoryUsageChanged)
+
+#define defaultCacheMemoryBudget 64 * 1024 * 1024
+#define sourceCheckInterval 1000
+
+public:
+    /*************/
+    /* Functions */
+    /*************/
+
+    ///
+    /// \brief instance - Singleton instance funtion, cause we need only one cache for hole application.
+    /// \return Instance to PWLottieCache class.
+    ///
+    static PWLottieCache* instance();
+
+    ///
+    /// \brief create - Function that is used by QML engine to get singleton instance.
+    /// \return Instance to PWLottieCache class.
+    ///
+    static PWLottieCache* create(QQmlEngine* qmlEngine, QJSEngine* jsEngine);
+
+    ///
+    /// \brief model - Function gets model of lottie animation, it's loaded and parsed only if it isn't cached yet.
+    /// \attention Function is thread-safe and can be called from render workers.
+    ///
+    /// \param source - Source of lottie animation.
+    /// \param progressCallback - Callback that is called from loading thread with progress from '0.0' to '1.0'.
+    /// \return Returns shared model or nullptr if source can't be loaded.
+    ///
+    [[nodiscard]] std::shared_ptr<const PWLottieModel> model(const QString& source, const std::function<void(qreal)>& progressCallback = nullptr);
+
+    ///
+    /// \brief cachedModel - Function gets model of lottie animation only if it's already cached, it never does I/O.
+    /// \param source - Source of lottie animation.
+    /// \return Returns shared model or nullptr if it isn't cached.
+    ///
+    [[nodiscard]] std::shared_ptr<const PWLottieModel> cachedModel(const QString& source);
+
+    ///
+    /// \brief preload - Function loads lottie animations in background, so items are created without any I/O and parsing.
+    /// \param sources - Sources of lottie animations.
+    ///
+    Q_INVOKABLE void preload(const QStringList& sources);
+
+    ///
+    /// \brief clear - Function removes all models that aren't used by items now.
+    ///
+    Q_INVOKABLE void clear();
+
+    /*****************/
+    /* Memory budget */
+    /*****************/
+
+    [[nodiscard]] qint64 memoryBudget();
+
+    ///
+    /// \brief setMemoryBudget - Function sets memory that cache can use, unused models are evicted if it's exceeded.
+    /// \param memoryBudget - Memory budget in bytes.
+    ///
+    void setMemoryBudget(const qint64 memoryBudget);
+
+    [[nodiscard]] qint64 memoryUsage();
+
+    /******************/
+    /* Frame analysis */
+    /******************/
+
+    [[nodiscard]] bool frameAnalysis();
+
+    ///
+    /// \brief setFrameAnalysis - Function sets if holds of models, that are loaded after it, are found in background.
+    /// \param frameAnalysis - Tools that render only few frames of every animation disable it.
+    ///
+    void setFrameAnalysis(const bool frameAnalysis);
+
+    /**************/
+    /* Statistics */
+    /**************/
+
+    [[nodiscard]] quint64 hits();
+    [[nodiscard]] quint64 misses();
+
+signals:
+    void memoryBudgetChanged();
+    void memoryUsageChanged();
+
+private:
+    explicit PWLottieCache(QObject* parent = nullptr);
+
+    ///
+    /// \brief The CacheEntry struct - Cached model and time of it's last use.
+    ///
+    struct CacheEntry {
+        std::shared_ptr<const PWLottieModel> model;
+        quint64 lastUse = 0;
+    };
+
+    ///
+    /// \brief The SourceEntry struct - Resolved source, it's key and time when it was checked on disk.
+    ///
+    struct SourceEntry {
+        QString loadedSource;
+        QString key;
+        qint64 checkTime = 0;
+    };
+
+    /*************/
+    /* Functions */
+    /*************/
+
+    ///
+    /// \brief sourceKey - Function gets key of source file, that changes if file is changed.
+    /// \param source - Source of lottie animation.
+    /// \return Returns canonical path with size and modification time of file.
+    ///
+    [[nodiscard]] static QString sourceKey(const QString& source);
+
+    ///
+    /// \brief resolveSource - Function replaces lottie JSON with it's compiled asset, if it was added by 'pwlottie_add_precompiled_assets'.
+    /// \param source - Source of lottie animation.
+    /// \return Returns path of compiled asset or the given source.
+    ///
+    [[nodiscard]] static QString resolveSource(const QString& source);
+
+    ///
+    /// \brief resolvedSourceKey - Function gets loaded source and it's key, they are checked on disk only once in a while.
+    /// \param source - Source of lottie animation.
+    /// \param loadedSource - Compiled asset or the given source.
+    /// \return Returns key of loaded source.
+    ///
+    [[nodiscard]] QString resolvedSourceKey(const QString& source, QString& loadedSource);
+
+    ///
+    /// \brief notifyMemoryUsageChanged - Function emits change of memory usage in thread of cache, it can be called from render workers.
+    ///
+    void notifyMemoryUsageChanged();
+
+    ///
+    /// \brief loadModel - Function reads and parses source and puts it's model in cache.
+    /// \param source - Source of lottie animation.
+    /// \param key - Key of source file.
+    /// \param progressCallback - Callback that gets progress of loading.
+    /// \return Returns shared model or nullptr if source can't be loaded.
+    ///
+    [[nodiscard]] std::shared_ptr<const PWLottieModel> loadModel(const QString& source, const QString& key, const std::function<void(qreal)>& progressCallback);
+
+    ///
+    /// \brief findModel - Function finds model by it's content hash, must be called under lock.
+    /// \param contentHash - Hash of lottie JSON.
+    /// \return Returns model or nullptr if it isn't cached.
+    ///
+    [[nodiscard]] std::shared_ptr<const PWLottieModel> findModel(const QByteArray& contentHash);
+
+    ///
+    /// \brief evictModels - Function evicts least recently used models that aren't used by items, must be called under lock.
+    /// \param memoryBudget - Memory that can stay used after eviction.
+    ///
+    void evictModels(const qint64 memoryBudget);
+
+    /*************/
+    /* Variables */
+    /*************/
+
+    QMutex m_mutex;
+
+    QWaitCondition m_loadFinished;
+    QSet<QString> m_loadingSources = {};
+
+    QHash<QString, SourceEntry> m_sourceEntries = {};
+    QElapsedTimer m_sourceTimer;
+
+    QHash<QString, QByteArray> m_sourceHashes = {};
+    QHash<QByteArray, CacheEntry> m_cacheEntries = {};
+
+    quint64 m_useCounter = 0;
+    quint64 m_hits = 0;
+    quint64 m_misses = 0;
+
+    qint64 m_memoryUsage = 0;
+    qint64 m_memoryBudget = defaultCacheMemoryBudget;
+
+    bool m_frameAnalysis = true;
+};
+
+#endif // PWLOTTIECACHE_H
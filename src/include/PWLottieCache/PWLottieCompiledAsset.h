@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) PrivateWeb Software (https://github.com/PrivateWebSoftware) - All Rights Reserved
+ *
+ * Licensed under the Apache License 2.0 (the "License"). You may not use
+ * this file except in compliance with the License. You can obtain a copy
+ * in the file LICENSE in the source distribution
+ *
+ * Written by PrivateWeb Software <privatewebsoftware@protonmail.com>, October 2026
+ */
+
+#ifndef PWLOTTIECOMPILEDASSET_H
+#define PWLOTTIECOMPILEDASSET_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QList>
+#include <QString>
+
+#include <string>
+
+///
+/// \brief The PWLottieCompiledAsset class - Lottie animation that was validated and compiled at build time.
+///
+/// Compiled asset is a versioned container with content hash, canonical frames of holds and minified
+/// JSON with quantised numbers, that is checked to render like the source JSON. rlottie builds it's composition
+/// only from JSON, so the whole JSON is still copied out of asset and parsed at runtime. Asset saves only hashing
+/// and analysis of frames, and parsing is a bit faster only cause minified JSON is smaller.
+/// Assets are memory-mapped, both from disk and from uncompressed Qt resources.
+///
+/// Layout, all numbers are little-endian:
+///     magic "PWLC", version, count of frames, size of JSON, SHA-1 of JSON, SHA-1 of source JSON,
+///     canonical frame of every frame, JSON.
+///
+class PWLottieCompiledAsset {
+
+#define compiledAssetMagic "PWLC"
+#define compiledAssetVersion 3
+#define compiledAssetSuffix "pwlottie"
+#define compiledAssetHashSize 20
+#define compiledAssetHeaderSize 56
+#define defaultCompiledAssetPrecision 3
+#define compiledAssetCompareFrames 5
+#define compiledAssetCompareSide 128
+#define compiledAssetMaxChannelDifference 8
+#define compiledAssetMaxDifferentPixelsPerMille 2
+
+public:
+    PWLottieCompiledAsset() { }
+
+    PWLottieCompiledAsset(const PWLottieCompiledAsset&) = delete;
+    PWLottieCompiledAsset& operator=(const PWLottieCompiledAsset&) = delete;
+
+    /*************/
+    /* Functions */
+    /*************/
+
+    ///
+    /// \brief compile - Function validates lottie JSON and compiles it, it's used by 'pwlottie-compile' tool.
+    /// \param jsonData - Lottie JSON data.
+    /// \param resourcePath - Path where images of animation are located.
+    /// \param precision - Count of decimals that are kept in numbers.
+    /// \param error - Description of error if animation isn't valid.
+    /// \return Returns compiled asset or empty data if animation isn't valid.
+    ///
+    [[nodiscard]] static QByteArray compile(const QByteArray& jsonData, const QString& resourcePath, const qint32 precision, QString& error);
+
+    ///
+    /// \brief compiledSource - Function gets path of compiled asset that is placed next to lottie JSON and was compiled from it.
+    /// \param source - Source of lottie animation.
+    /// \return Returns path of compiled asset or empty string if it doesn't exist or is stale.
+    ///
+    [[nodiscard]] static QString compiledSource(const QString& source);
+
+    ///
+    /// \brief isCompiledSource - Function checks if source is compiled asset by it's suffix.
+    /// \param source - Source of lottie animation.
+    /// \return Returns true if source has compiled asset suffix.
+    ///
+    [[nodiscard]] static bool isCompiledSource(const QString& source);
+
+    ///
+    /// \brief open - Function maps compiled asset and validates it's header.
+    /// \param filePath - Path of compiled asset.
+    /// \return Returns true if asset can be used.
+    ///
+    [[nodiscard]] bool open(const QString& filePath);
+
+    ///
+    /// \brief isCompiledFrom - Function checks if asset was compiled from the current content of source.
+    /// \param source - Source lottie JSON.
+    /// \return Returns true if asset isn't stale.
+    ///
+    [[nodiscard]] bool isCompiledFrom(const QString& source) const;
+
+    ///
+    /// \brief jsonData - Function copies JSON out of mapped asset, rlottie takes it only as string.
+    /// \return Returns minified lottie JSON.
+    ///
+    [[nodiscard]] std::string jsonData() const;
+
+    ///
+    /// \brief canonicalFrames - Function gets frames of holds, that were found at build time.
+    /// \return Returns canonical frame of every frame.
+    ///
+    [[nodiscard]] QList<qint32> canonicalFrames() const;
+
+    /**************/
+    /* Properties */
+    /**************/
+
+    [[nodiscard]] inline QByteArray contentHash() const
+    {
+        return m_contentHash;
+    }
+
+private:
+    /*************/
+    /* Variables */
+    /*************/
+
+    QFile m_file;
+    QByteArray m_buffer;
+
+    const uchar* m_data = nullptr;
+    qint64 m_size = 0;
+
+    QByteArray m_contentHash;
+    QByteArray m_sourceHash;
+    qint32 m_totalFrames = 0;
+    qint64 m_jsonOffset = 0;
+    qint64 m_jsonSize = 0;
+};
+
+#endif // PWLOTTIECOMPILEDASSET_H
@@ -0,0 +1,169 @@
+/*
+ * Copyright (C) PrivateWeb Software (https://github.com/PrivateWebSoftware) - All Rights Reserved
+ *
+ * Licensed under the Apache License 2.0 (the "License"). You may not use
+ * this file except in compliance with the License. You can obtain a copy
+ * in the file LICENSE in the source distribution
+ *
+ * Written by PrivateWeb Software <privatewebsoftware@protonmail.com>, October 2026
+ */
+
+#ifndef PWLOTTIEFRAMECACHE_H
+#define PWLOTTIEFRAMECACHE_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QImage>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSet>
+#include <QSize>
+#include <QWaitCondition>
+
+#include <functional>
+#include <list>
+
+///
+/// \brief The PWLottieFrameKey struct - Identifies rendered frame of lottie model in the given size and pixel format.
+///
+struct PWLottieFrameKey {
+    QByteArray contentHash;
+    QSize size;
+    qint32 frame = -1;
+    QImage::Format format = QImage::Format_ARGB32_Premultiplied;
+
+    [[nodiscard]] inline bool operator==(const PWLottieFrameKey& other) const
+    {
+        return frame == other.frame && size == other.size && format == other.format && contentHash == other.contentHash;
+    }
+};
+
+[[nodiscard]] inline size_t qHash(const PWLottieFrameKey& frameKey, size_t seed = 0)
+{
+    return qHashMulti(seed, frameKey.contentHash, frameKey.size.width(), frameKey.size.height(), frameKey.frame, qint32(frameKey.format));
+}
+
+///
+/// \brief The PWLottieFrameCache class - Process-wide cache of rendered frames shared by items with the same source and size.
+///
+/// Items that show the same model in the same size and format register themselves as users of it. When there are
+/// several users, the first item that needs a frame renders it and other items reuse the same pixels,
+/// even if they play out of phase. Frames are evicted in least recently used order when memory budget is exceeded.
+///
+class PWLottieFrameCache {
+
+#define defaultFrameCacheMemoryBudget 64 * 1024 * 1024
+
+public:
+    /*************/
+    /* Functions */
+    /*************/
+
+    ///
+    /// \brief instance - Singleton instance funtion, cause we need only one frame cache for hole application.
+    /// \return Instance to PWLottieFrameCache class.
+    ///
+    static PWLottieFrameCache* instance();
+
+    ///
+    /// \brief addUser - Function registers item that shows model in the given size.
+    /// \param contentHash - Content hash of model.
+    /// \param size - Size in which model is rendered.
+    /// \param format - Pixel format of frames.
+    ///
+    void addUser(const QByteArray& contentHash, const QSize& size, const QImage::Format format);
+
+    ///
+    /// \brief removeUser - Function unregisters item that showed model in the given size, it's frames are dropped if it was the last user.
+    /// \param contentHash - Content hash of model.
+    /// \param size - Size in which model was rendered.
+    /// \param format - Pixel format of frames.
+    ///
+    void removeUser(const QByteArray& contentHash, const QSize& size, const QImage::Format format);
+
+    ///
+    /// \brief isShared - Function checks if frames of model in the given size are needed by several items.
+    /// \param contentHash - Content hash of model.
+    /// \param size - Size in which model is rendered.
+    /// \param format - Pixel format of frames.
+    /// \return Returns true if frames should be taken from cache.
+    ///
+    [[nodiscard]] bool isShared(const QByteArray& contentHash, const QSize& size, const QImage::Format format);
+
+    ///
+    /// \brief frame - Function gets cached frame or renders it. If frame is rendering by another thread, function waits for it.
+    /// \attention Function is thread-safe and is called from render workers.
+    ///
+    /// \param frameKey - Key of frame.
+    /// \param renderFrame - Function that renders frame, it's called only if frame isn't cached.
+    /// \return Returns rendered frame, it must not be modified.
+    ///
+    [[nodiscard]] QImage frame(const PWLottieFrameKey& frameKey, const std::function<QImage()>& renderFrame);
+
+    ///
+    /// \brief clear - Function removes all cached frames.
+    ///
+    void clear();
+
+    /*****************/
+    /* Memory budget */
+    /*****************/
+
+    [[nodiscard]] qint64 memoryBudget();
+
+    ///
+    /// \brief setMemoryBudget - Function sets memory that cached frames can use, '0' disables frame sharing.
+    /// \param memoryBudget - Memory budget in bytes.
+    ///
+    void setMemoryBudget(const qint64 memoryBudget);
+
+    [[nodiscard]] qint64 memoryUsage();
+
+    /**************/
+    /* Statistics */
+    /**************/
+
+    [[nodiscard]] quint64 hits();
+    [[nodiscard]] quint64 misses();
+
+private:
+    PWLottieFrameCache() { }
+
+    ///
+    /// \brief The CacheEntry struct - Cached frame and it's position in least recently used list.
+    ///
+    struct CacheEntry {
+        QImage image;
+        std::list<PWLottieFrameKey>::iterator usePosition;
+    };
+
+    /*************/
+    /* Functions */
+    /*************/
+
+    ///
+    /// \brief evictFrames - Function evicts least recently used frames, must be called under lock.
+    /// \param memoryBudget - Memory that can stay used after eviction.
+    ///
+    void evictFrames(const qint64 memoryBudget);
+
+    /*************/
+    /* Variables */
+    /*************/
+
+    QMutex m_mutex;
+    QWaitCondition m_frameRendered;
+
+    QHash<PWLottieFrameKey, qint32> m_users = {};
+    QHash<PWLottieFrameKey, CacheEntry> m_cacheEntries = {};
+    QSet<PWLottieFrameKey> m_renderingFrames = {};
+    std::list<PWLottieFrameKey> m_useOrder = {};
+
+    quint64 m_hits = 0;
+    quint64 m_misses = 0;
+
+    qint64 m_memoryUsage = 0;
+    qint64 m_memoryBudget = defaultFrameCacheMemoryBudget;
+};
+
+#endif // PWLOTTIEFRAMECACHE_H
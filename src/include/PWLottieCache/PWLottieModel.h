@@ -0,0 +1,170 @@
+/*
+ * Copyright (C) PrivateWeb Software (https://github.com/PrivateWebSoftware) - All Rights Reserved
+ *
+ * Licensed under the Apache License 2.0 (the "License"). You may not use
+ * this file except in compliance with the License. You can obtain a copy
+ * in the file LICENSE in the source distribution
+ *
+ * Written by PrivateWeb Software <privatewebsoftware@protonmail.com>, October 2026
+ */
+
+#ifndef PWLOTTIEMODEL_H
+#define PWLOTTIEMODEL_H
+
+#include <QByteArray>
+#include <QList>
+#include <QMutex>
+#include <QSize>
+#include <QString>
+
+#include <atomic>
+#include <memory>
+#include <string>
+
+#include <rlottie.h>
+
+///
+/// \brief The PWLottieModel class - Immutable parsed lottie animation that is shared between all items with the same content.
+///
+/// Model owns the only parsed rlottie::Animation of it's content, JSON isn't kept after parsing and rlottie
+/// model cache is disabled, so memory of composition is freed together with model. Animation can't render
+/// from several threads at once, so frames of one model are rendered one after another, while different
+/// models render in parallel.
+///
+/// After loading, frames of model are analysed once in background, so frames of holds, that look exactly
+/// like the frame before them in default size of animation, are mapped to the first frame of hold and
+/// aren't rendered again. Frames rendered bigger than default size don't use holds.
+///
+class PWLottieModel {
+
+#define maxFrameAnalysisSide 256
+
+public:
+    PWLottieModel(const QString& source, const QByteArray& contentHash, const qint64 jsonSize, std::unique_ptr<rlottie::Animation>&& animation);
+
+    /*************/
+    /* Functions */
+    /*************/
+
+    ///
+    /// \brief loadFromData - Function parses lottie JSON and creates model.
+    /// \param source - Source of lottie animation.
+    /// \param contentHash - Hash of lottie JSON.
+    /// \param jsonData - Lottie JSON data, it's moved to rlottie and freed after parsing.
+    /// \param resourcePath - Path where images of animation are located.
+    /// \return Returns created model or nullptr if data isn't valid lottie animation.
+    ///
+    [[nodiscard]] static std::shared_ptr<PWLottieModel> loadFromData(const QString& source, const QByteArray& contentHash, std::string&& jsonData, std::string&& resourcePath);
+
+    ///
+    /// \brief render - Function renders frame of model in the given surface.
+    /// \attention Function is thread-safe, renders of one model wait for each other.
+    ///
+    /// \param frame - Frame of animation.
+    /// \param surface - Surface with pixels and size of frame.
+    ///
+    void render(const qint32 frame, const rlottie::Surface& surface) const;
+
+    ///
+    /// \brief analyseFrames - Function finds frames that look exactly like the frame before them, it's called once from render worker.
+    ///
+    void analyseFrames();
+
+    ///
+    /// \brief setCanonicalFrames - Function sets frames of holds that were found before, like in compiled asset, it must be called before model is shared.
+    /// \param canonicalFrames - Canonical frame of every frame.
+    /// \return Returns true if frames match model and were set.
+    ///
+    bool setCanonicalFrames(QList<qint32>&& canonicalFrames);
+
+    ///
+    /// \brief canonicalFrame - Function gets the first frame of hold that the given frame belongs to.
+    /// \param frame - Frame of animation.
+    /// \param renderSize - Size in which frame is rendered.
+    /// \return Returns frame with the same image, or the given frame if frames aren't analysed yet.
+    ///
+    [[nodiscard]] qint32 canonicalFrame(const qint32 frame, const QSize& renderSize) const;
+
+    /**************/
+    /* Properties */
+    /**************/
+
+    [[nodiscard]] inline QString source() const
+    {
+        return m_source;
+    }
+
+    [[nodiscard]] inline QByteArray contentHash() const
+    {
+        return m_contentHash;
+    }
+
+    [[nodiscard]] inline qint32 totalFrames() const
+    {
+        return m_totalFrames;
+    }
+
+    [[nodiscard]] inline qreal frameRate() const
+    {
+        return m_frameRate;
+    }
+
+    [[nodiscard]] inline qreal duration() const
+    {
+        return m_duration;
+    }
+
+    [[nodiscard]] inline QSize defaultSize() const
+    {
+        return m_defaultSize;
+    }
+
+    ///
+    /// \brief isFramesAnalysed - Function checks if frames were analysed, frames aren't mapped before it.
+    /// \return Returns true if canonical frames are known.
+    ///
+    [[nodiscard]] inline bool isFramesAnalysed() const
+    {
+        return m_framesAnalysed.load(std::memory_order_acquire);
+    }
+
+    ///
+    /// \brief canonicalFrames - Function gets canonical frame of every frame.
+    /// \return Returns canonical frames, or empty list if frames aren't analysed yet.
+    ///
+    [[nodiscard]] inline QList<qint32> canonicalFrames() const
+    {
+        return isFramesAnalysed() ? m_canonicalFrames : QList<qint32>();
+    }
+
+    ///
+    /// \brief byteCost - Function gets estimated memory that is used by model.
+    /// \return Returns size of parsed composition in bytes.
+    ///
+    [[nodiscard]] inline qint64 byteCost() const
+    {
+        return m_byteCost;
+    }
+
+private:
+    /*************/
+    /* Variables */
+    /*************/
+
+    QString m_source;
+    QByteArray m_contentHash;
+
+    std::unique_ptr<rlottie::Animation> m_animation = nullptr;
+    mutable QMutex m_renderMutex;
+
+    qint32 m_totalFrames = 0;
+    qreal m_frameRate = 0.0;
+    qreal m_duration = 0.0;
+    QSize m_defaultSize = { 0, 0 };
+    qint64 m_byteCost = 0;
+
+    QList<qint32> m_canonicalFrames = {};
+    std::atomic<bool> m_framesAnalysed = false;
+};
+
+#endif // PWLOTTIEMODEL_H
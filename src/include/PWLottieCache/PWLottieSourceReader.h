@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) PrivateWeb Software (https://github.com/PrivateWebSoftware) - All Rights Reserved
+ *
+ * Licensed under the Apache License 2.0 (the "License"). You may not use
+ * this file except in compliance with the License. You can obtain a copy
+ * in the file LICENSE in the source distribution
+ *
+ * Written by PrivateWeb Software <privatewebsoftware@protonmail.com>, October 2026
+ */
+
+#ifndef PWLOTTIESOURCEREADER_H
+#define PWLOTTIESOURCEREADER_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QString>
+
+#include <functional>
+#include <string>
+
+///
+/// \brief The PWLottieSourceReader class - Reader of lottie sources, that gives rlottie JSON with all images in memory.
+///
+/// Sources are memory-mapped and their format is detected by content: plain JSON, Telegram stickers (.tgs, gzip)
+/// and dotLottie archives (.lottie, zip). Compressed sources are inflated by chunks straight into JSON string,
+/// sizes stored in the source are only trusted up to a limit, so corrupt source can't allocate gigabytes.
+/// Images of dotLottie archives and Qt resources are embedded into JSON as data URIs, rlottie can't read them
+/// from paths. Only values of image assets are replaced, the rest of JSON is kept as it is. Images of other
+/// sources are resolved next to the source file.
+/// Compressed sources need zlib, they are rejected when library is built without it.
+///
+class PWLottieSourceReader {
+
+#define sourceReadChunkSize 256 * 1024
+#define maxArchiveCommentSize 0xFFFF
+#define maxInflatedSourceSize 256 * 1024 * 1024
+#define maxInflationRatio 16
+
+public:
+    ///
+    /// \brief The SourceFormat enum - Format of source detected by it's first bytes.
+    ///
+    enum class SourceFormat {
+        Json,
+        Gzip,
+        Zip
+    };
+
+    /*************/
+    /* Functions */
+    /*************/
+
+    ///
+    /// \brief read - Function reads source, inflates it if it's compressed and reports progress of reading.
+    /// \param source - Source of lottie animation.
+    /// \param jsonData - Lottie JSON.
+    /// \param progressCallback - Callback that gets progress of reading.
+    /// \return Returns true if source was read.
+    ///
+    [[nodiscard]] static bool read(const QString& source, std::string& jsonData, const std::function<void(qreal)>& progressCallback);
+
+    ///
+    /// \brief resourcePath - Function gets path where rlottie finds images, that aren't embedded into JSON.
+    /// \param source - Source of lottie animation.
+    /// \return Returns directory of source file.
+    ///
+    [[nodiscard]] static std::string resourcePath(const QString& source);
+
+    ///
+    /// \brief sourceFormat - Function detects format of source by it's first bytes.
+    /// \param data - Source data.
+    /// \param size - Size of source data.
+    /// \return Returns format of source.
+    ///
+    [[nodiscard]] static SourceFormat sourceFormat(const uchar* data, const qint64 size);
+
+private:
+    PWLottieSourceReader() { }
+
+    ///
+    /// \brief The ArchiveEntry struct - File of zip archive.
+    ///
+    struct ArchiveEntry {
+        qint64 offset = 0;
+        qint64 compressedSize = 0;
+        qint64 size = 0;
+        quint16 method = 0;
+    };
+
+    ///
+    /// \brief The ImageAsset struct - Spans of members of image asset in JSON, '-1' if member is missing.
+    ///
+    struct ImageAsset {
+        qsizetype directoryStart = -1;
+        qsizetype directoryEnd = -1;
+        qsizetype fileStart = -1;
+        qsizetype fileEnd = -1;
+        qsizetype embeddedStart = -1;
+        qsizetype embeddedEnd = -1;
+        qsizetype assetEnd = -1;
+    };
+
+    /*************/
+    /* Functions */
+    /*************/
+
+    ///
+    /// \brief inflateData - Function inflates deflate stream by chunks.
+    /// \param data - Compressed data.
+    /// \param size - Size of compressed data.
+    /// \param windowBits - Window bits of zlib, they select gzip or raw deflate stream.
+    /// \param inflatedSize - Size of inflated data that source claims, buffer grows if it's bigger.
+    /// \param output - Inflated data.
+    /// \param progressCallback - Callback that gets progress of inflating.
+    /// \return Returns true if stream was inflated.
+    ///
+    [[nodiscard]] static bool inflateData(const uchar* data, const qint64 size, const int windowBits, const qint64 inflatedSize, std::string& output, const std::function<void(qreal)>& progressCallback);
+
+    ///
+    /// \brief readArchive - Function reads animation of dotLottie archive and embeds it's images.
+    /// \param data - Archive data.
+    /// \param size - Size of archive data.
+    /// \param jsonData - Lottie JSON.
+    /// \param progressCallback - Callback that gets progress of reading.
+    /// \return Returns true if animation was read.
+    ///
+    [[nodiscard]] static bool readArchive(const uchar* data, const qint64 size, std::string& jsonData, const std::function<void(qreal)>& progressCallback);
+
+    ///
+    /// \brief archiveEntries - Function reads central directory of zip archive.
+    /// \param data - Archive data.
+    /// \param size - Size of archive data.
+    /// \param entries - Files of archive by their names.
+    /// \return Returns true if archive is valid.
+    ///
+    [[nodiscard]] static bool archiveEntries(const uchar* data, const qint64 size, QHash<QString, ArchiveEntry>& entries);
+
+    ///
+    /// \brief readArchiveEntry - Function reads file of zip archive, stored and deflated files are supported.
+    /// \param data - Archive data.
+    /// \param entry - File of archive.
+    /// \param output - Content of file.
+    /// \param progressCallback - Callback that gets progress of reading.
+    /// \return Returns true if file was read.
+    ///
+    [[nodiscard]] static bool readArchiveEntry(const uchar* data, const ArchiveEntry& entry, std::string& output, const std::function<void(qreal)>& progressCallback);
+
+    ///
+    /// \brief embedImages - Function embeds images of animation into JSON as data URIs.
+    /// \param jsonData - Lottie JSON.
+    /// \param readImage - Function that reads image by it's path in JSON.
+    ///
+    static void embedImages(std::string& jsonData, const std::function<bool(const QString&, QByteArray&)>& readImage);
+};
+
+#endif // PWLOTTIESOURCEREADER_H
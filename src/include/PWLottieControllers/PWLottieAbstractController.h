@@ -13,7 +13,21 @@
 
 #include <QObject>
 #include <QSet>
-#include <QString>
+#include <QSize>
+
+///
+/// \brief PWLottieHandle - Compact handle of lottie item, it's index in registry of PWControllerMediator.
+///
+using PWLottieHandle = qint32;
+
+///
+/// \brief The PWLottieItemInfo struct - Lottie item properties that controllers need for calculating framerate.
+///
+struct PWLottieItemInfo {
+    PWLottieHandle lottieHandle = -1;
+    QSize size;
+    qreal priority = 1.0;
+};
 
 ///
 /// \brief The PWLottieAbstractController class - Abstract Controller for all other controllers.
@@ -21,7 +35,7 @@
 class PWLottieAbstractController : public QObject {
     Q_OBJECT
 
-#define allLottiesDefiner "all"
+#define allLottiesHandle -1
 
 public:
     explicit PWLottieAbstractController(QObject* parent = nullptr) { }
@@ -32,16 +46,36 @@ public:
 
     ///
     /// \brief addLottieItem - Function adds lottie item to controller.
-    /// \param lottieUuid - Unique lottie UUID for it's controlling.
+    /// \param lottieItemInfo - Lottie handle, size and priority of lottie item.
     /// \return Returns current fps of registred lotti animation.
     ///
-    virtual quint16 addLottieItem(const QString& lottieUuid) = 0;
+    virtual quint16 addLottieItem(const PWLottieItemInfo& lottieItemInfo) = 0;
 
     ///
     /// \brief removeLottieItem - Function removes lottie item from controller.
-    /// \param lottieUuid - Unique lottie UUID for it's controlling.
+    /// \param lottieHandle - Lottie handle for it's controlling.
+    ///
+    virtual void removeLottieItem(const PWLottieHandle lottieHandle) = 0;
+
     ///
-    virtual void removeLottieItem(const QString& lottieUuid) = 0;
+    /// \brief updateLottieItem - Function takes changed size or priority of lottie item, controllers that don't use them ignore it.
+    /// \param lottieItemInfo - Lottie handle, size and priority of lottie item.
+    ///
+    virtual void updateLottieItem(const PWLottieItemInfo& lottieItemInfo)
+    {
+        Q_UNUSED(lottieItemInfo)
+    }
+
+    ///
+    /// \brief reportRenderTime - Function takes time of the last rendered frame of lottie item, controllers that don't measure load ignore it.
+    /// \param lottieHandle - Lottie handle for it's controlling.
+    /// \param renderTime - Time of rendering in nanoseconds.
+    ///
+    virtual void reportRenderTime(const PWLottieHandle lottieHandle, const qint64 renderTime)
+    {
+        Q_UNUSED(lottieHandle)
+        Q_UNUSED(renderTime)
+    }
 
     ///
     /// \brief getTotalLottieCount - Function gets count of all registred lottie animations in controller.
@@ -53,7 +87,7 @@ public:
     }
 
 protected:
-    QSet<QString> lottieItemsList = {};
+    QSet<PWLottieHandle> lottieItemsList = {};
 };
 
 #endif // PWLOTTIEABSTRACTCONTROLLER_H
@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) PrivateWeb Software (https://github.com/PrivateWebSoftware) - All Rights Reserved
+ *
+ * Licensed under the Apache License 2.0 (the "License"). You may not use
+ * this file except in compliance with the License. You can obtain a copy
+ * in the file LICENSE in the source distribution
+ *
+ * Written by PrivateWeb Software <privatewebsoftware@protonmail.com>, October 2026
+ */
+
+#ifndef PWLOTTIEADAPTIVECONTROLLER_H
+#define PWLOTTIEADAPTIVECONTROLLER_H
+
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QTimer>
+
+#include "include/PWLottieControllers/PWLottieAbstractController.h"
+
+///
+/// \brief The PWLottieAdaptiveController class - Controller that adjusts framerate by measured render cost and display frame time.
+///
+/// Controller periodically compares two loads with target: display frame interval of frame clock against target
+/// frame interval, which is refresh interval of screen by default, and time that render workers spend on rendering against their capacity. Framerate is lowered
+/// right away when load is high, but it's raised only after several calm evaluations and only if predicted load
+/// stays low, so framerate doesn't oscillate between levels.
+///
+class PWLottieAdaptiveController : public PWLottieAbstractController {
+    Q_OBJECT
+
+#define adaptiveEvaluationInterval 500
+#define adaptiveCalmEvaluations 4
+#define adaptiveHighFrameLoad 1.2
+#define adaptiveLowFrameLoad 1.1
+#define adaptiveHighRenderLoad 0.85
+#define adaptiveLowRenderLoad 0.5
+
+public:
+    PWLottieAdaptiveController() { }
+    explicit PWLottieAdaptiveController(QObject* parent);
+
+    /*********/
+    /* Enums */
+    /*********/
+
+    ///
+    /// \brief The Mode enum - Whether all items share one framerate or every item gets it's own.
+    ///
+    enum class Mode {
+        Global = 0,
+        PerItem = 1
+    };
+
+    /*************/
+    /* Functions */
+    /*************/
+
+    ///
+    /// \brief addLottieItem - Function adds lottie item to controller.
+    /// \param lottieItemInfo - Lottie handle, size and priority of lottie item.
+    /// \return Returns current fps of registred lotti animation.
+    ///
+    quint16 addLottieItem(const PWLottieItemInfo& lottieItemInfo) override;
+
+    ///
+    /// \brief removeLottieItem - Function removes lottie item from controller.
+    /// \param lottieHandle - Lottie handle for it's controlling.
+    ///
+    void removeLottieItem(const PWLottieHandle lottieHandle) override;
+
+    ///
+    /// \brief reportRenderTime - Function takes time of the last rendered frame of lottie item.
+    /// \param lottieHandle - Lottie handle for it's controlling.
+    /// \param renderTime - Time of rendering in nanoseconds.
+    ///
+    void reportRenderTime(const PWLottieHandle lottieHandle, const qint64 renderTime) override;
+
+    /**************/
+    /* Properties */
+    /**************/
+
+    [[nodiscard]] inline Mode mode() const
+    {
+        return m_mode;
+    }
+
+    ///
+    /// \brief setMode - Function sets whether framerate is adjusted for all items at once or for every item separately.
+    /// \param mode - Mode that will be installed.
+    ///
+    void setMode(const Mode mode);
+
+    [[nodiscard]] inline quint16 targetFrameRate() const
+    {
+        return m_targetFrameRate;
+    }
+
+    ///
+    /// \brief setTargetFrameRate - Function sets display framerate that controller tries to hold.
+    /// \param targetFrameRate - Display framerate, '0' holds refresh rate of screen.
+    ///
+    inline void setTargetFrameRate(const quint16 targetFrameRate)
+    {
+        m_targetFrameRate = targetFrameRate;
+    }
+
+signals:
+    void fpsChanged(const quint16 fps, const PWLottieHandle lottieHandle = allLottiesHandle);
+
+private:
+    ///
+    /// \brief The ItemLoad struct - Smoothed render time of lottie item and it's framerate level.
+    ///
+    struct ItemLoad {
+        qreal renderTime = 0.0;
+        qint32 level = 0;
+    };
+
+    /*************/
+    /* Functions */
+    /*************/
+
+    ///
+    /// \brief evaluate - Function measures loads and changes framerate levels, it's called by evaluation timer.
+    ///
+    void evaluate();
+
+    ///
+    /// \brief renderLoad - Function predicts part of render workers capacity that is used by items.
+    /// \param levelShift - Shift of framerate levels of all items for prediction.
+    /// \return Returns '1.0' if workers are fully loaded.
+    ///
+    [[nodiscard]] qreal renderLoad(const qint32 levelShift = 0) const;
+
+    ///
+    /// \brief lowerPerItemLevels - Function lowers levels of the most expensive items until render load goes down to target.
+    /// \param targetRenderLoad - Render load that should be reached.
+    /// \return Returns true if any level was changed.
+    ///
+    bool lowerPerItemLevels(const qreal targetRenderLoad);
+
+    ///
+    /// \brief raisePerItemLevels - Function raises levels of the cheapest items while render load stays low.
+    /// \return Returns true if any level was changed.
+    ///
+    bool raisePerItemLevels();
+
+    ///
+    /// \brief displayFrameRate - Function gets display framerate that is held, it's target framerate or refresh rate of screen.
+    /// \return Returns framerate.
+    ///
+    [[nodiscard]] qreal displayFrameRate() const;
+
+    ///
+    /// \brief levelFrameRate - Function gets framerate of level.
+    /// \param level - Framerate level, '0' is the highest framerate.
+    /// \return Returns framerate.
+    ///
+    [[nodiscard]] quint16 levelFrameRate(const qint32 level) const;
+
+    /*************/
+    /* Variables */
+    /*************/
+
+    const QList<quint16> m_frameRateLevels = { 60, 45, 30, 24, 20, 15, 10 };
+
+    QHash<PWLottieHandle, ItemLoad> m_itemLoads = {};
+    QTimer* m_evaluationTimer = nullptr;
+
+    Mode m_mode = Mode::Global;
+    quint16 m_targetFrameRate = 0;
+
+    qint32 m_globalLevel = 0;
+    qint32 m_calmEvaluations = 0;
+};
+
+#endif // PWLOTTIEADAPTIVECONTROLLER_H
@@ -23,8 +23,6 @@
 class PWLottieBaseController : public PWLottieAbstractController {
     Q_OBJECT
 
-#define allLottiesDefiner "all"
-
 public:
     PWLottieBaseController() { }
     explicit PWLottieBaseController(QObject* parent);
@@ -35,19 +33,19 @@ public:
 
     ///
     /// \brief addLottieItem - Function adds lottie item to controller.
-    /// \param lottieUuid - Unique lottie UUID for it's controlling.
+    /// \param lottieItemInfo - Lottie handle, size and priority of lottie item.
     /// \return Returns current fps of registred lotti animation.
     ///
-    quint16 addLottieItem(const QString& lottieUuid) override;
+    quint16 addLottieItem(const PWLottieItemInfo& lottieItemInfo) override;
 
     ///
     /// \brief removeLottieItem - Function removes lottie item from controller.
-    /// \param lottieUuid - Unique lottie UUID for it's controlling.
+    /// \param lottieHandle - Lottie handle for it's controlling.
     ///
-    void removeLottieItem(const QString& lottieUuid) override;
+    void removeLottieItem(const PWLottieHandle lottieHandle) override;
 
 signals:
-    void fpsChanged(const quint16 fps, const QString& lottieUuid = allLottiesDefiner);
+    void fpsChanged(const quint16 fps, const PWLottieHandle lottieHandle = allLottiesHandle);
 
 protected:
     /*************/
@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) PrivateWeb Software (https://github.com/PrivateWebSoftware) - All Rights Reserved
+ *
+ * Licensed under the Apache License 2.0 (the "License"). You may not use
+ * this file except in compliance with the License. You can obtain a copy
+ * in the file LICENSE in the source distribution
+ *
+ * Written by PrivateWeb Software <privatewebsoftware@protonmail.com>, October 2026
+ */
+
+#ifndef PWLOTTIEBUDGETCONTROLLER_H
+#define PWLOTTIEBUDGETCONTROLLER_H
+
+#include <QHash>
+#include <QObject>
+
+#include "include/PWLottieControllers/PWLottieAbstractController.h"
+
+///
+/// \brief The PWLottieBudgetController class - Controller that shares global rasterisation budget between items by their priority and area.
+///
+/// Budget is count of pixels that can be rasterised per second. Framerate of every item is proportional to it's
+/// priority multiplied by square root of it's area, so with the same priority big item plays smoother than small one,
+/// while small item still costs much less. Budget that isn't used by items which already play at maximal framerate
+/// is shared between other items.
+///
+class PWLottieBudgetController : public PWLottieAbstractController {
+    Q_OBJECT
+
+#define defaultBudgetPixelsPerSecond 32 * 1024 * 1024
+#define defaultBudgetMinFrameRate 10
+#define defaultBudgetMaxFrameRate 60
+
+public:
+    PWLottieBudgetController() { }
+    explicit PWLottieBudgetController(QObject* parent);
+
+    /*************/
+    /* Functions */
+    /*************/
+
+    ///
+    /// \brief addLottieItem - Function adds lottie item to controller.
+    /// \param lottieItemInfo - Lottie handle, size and priority of lottie item.
+    /// \return Returns current fps of registred lotti animation.
+    ///
+    quint16 addLottieItem(const PWLottieItemInfo& lottieItemInfo) override;
+
+    ///
+    /// \brief removeLottieItem - Function removes lottie item from controller.
+    /// \param lottieHandle - Lottie handle for it's controlling.
+    ///
+    void removeLottieItem(const PWLottieHandle lottieHandle) override;
+
+    ///
+    /// \brief updateLottieItem - Function takes changed size or priority of lottie item.
+    /// \param lottieItemInfo - Lottie handle, size and priority of lottie item.
+    ///
+    void updateLottieItem(const PWLottieItemInfo& lottieItemInfo) override;
+
+    /**********/
+    /* Budget */
+    /**********/
+
+    [[nodiscard]] inline qint64 pixelsPerSecond() const
+    {
+        return m_pixelsPerSecond;
+    }
+
+    ///
+    /// \brief setPixelsPerSecond - Function sets count of pixels that all items can rasterise per second.
+    /// \param pixelsPerSecond - Rasterisation budget.
+    ///
+    void setPixelsPerSecond(const qint64 pixelsPerSecond);
+
+    [[nodiscard]] inline quint16 minFrameRate() const
+    {
+        return m_minFrameRate;
+    }
+
+    [[nodiscard]] inline quint16 maxFrameRate() const
+    {
+        return m_maxFrameRate;
+    }
+
+    ///
+    /// \brief setFrameRateRange - Function sets framerates between which framerate of every item is kept.
+    /// \param minFrameRate - The lowest framerate, it's kept even if budget is exceeded.
+    /// \param maxFrameRate - The highest framerate.
+    ///
+    void setFrameRateRange(const quint16 minFrameRate, const quint16 maxFrameRate);
+
+signals:
+    void fpsChanged(const quint16 fps, const PWLottieHandle lottieHandle = allLottiesHandle);
+
+private:
+    ///
+    /// \brief The ItemBudget struct - Rendered pixels and priority of lottie item and it's assigned framerate.
+    ///
+    struct ItemBudget {
+        qint64 pixels = 0;
+        qreal priority = 1.0;
+        quint16 frameRate = 0;
+    };
+
+    /*************/
+    /* Functions */
+    /*************/
+
+    ///
+    /// \brief frameWeight - Function gets weight of item's framerate, framerates of items are proportional to it.
+    /// \param itemBudget - Pixels and priority of item.
+    /// \return Returns priority multiplied by square root of pixels.
+    ///
+    [[nodiscard]] static qreal frameWeight(const ItemBudget& itemBudget);
+
+    ///
+    /// \brief scheduleAllocation - Function schedules allocation of budget, so many changes in a row are applied at once.
+    ///
+    void scheduleAllocation();
+
+    ///
+    /// \brief allocateBudget - Function shares budget between items and notifies items whose framerate was changed.
+    ///
+    void allocateBudget();
+
+    /*************/
+    /* Variables */
+    /*************/
+
+    QHash<PWLottieHandle, ItemBudget> m_itemBudgets = {};
+
+    qint64 m_pixelsPerSecond = defaultBudgetPixelsPerSecond;
+    quint16 m_minFrameRate = defaultBudgetMinFrameRate;
+    quint16 m_maxFrameRate = defaultBudgetMaxFrameRate;
+
+    bool m_allocationScheduled = false;
+};
+
+#endif // PWLOTTIEBUDGETCONTROLLER_H
@@ -11,34 +11,135 @@
 #ifndef PWLOTTIEICONCONTROLLER_H
 #define PWLOTTIEICONCONTROLLER_H
 
+#include <QHash>
 #include <QObject>
 #include <QPointer>
 #include <QSet>
 
+#include <memory>
+
+#include "include/PWLottieCache/PWLottieFrameCache.h"
+#include "include/PWLottieCache/PWLottieModel.h"
 #include "include/PWLottieControllers/PWLottieAbstractController.h"
+#include "include/PWLottieControllers/PWLottieSpriteSheet.h"
 
+///
+/// \brief The PWLottieIconController class - Controller for small looping icons, that plays them from pre-rasterised sprite sheets.
+///
+/// Every frame of small animation is rendered once in background, after that items only pick frames from
+/// sprite sheet and rlottie isn't used at all. Animations that are too big, too long or don't fit in memory
+/// budget are rendered live as usual.
+///
 class PWLottieIconController : public PWLottieAbstractController {
     Q_OBJECT
 
+#define iconFrameRate 30
+#define defaultIconMaxFramePixels 96 * 96
+#define defaultIconMaxFrames 300
+#define defaultIconMemoryBudget 32 * 1024 * 1024
+
 public:
     PWLottieIconController() { }
     explicit PWLottieIconController(QObject* parent);
 
+    /*************/
+    /* Functions */
+    /*************/
+
     ///
     /// \brief addLottieItem - Function adds lottie item to controller.
-    /// \param lottieUuid - Unique lottie UUID for it's controlling.
+    /// \param lottieItemInfo - Lottie handle, size and priority of lottie item.
     /// \return Returns current fps of registred lotti animation.
     ///
-    quint16 addLottieItem(const QString& lottieUuid) override { return 0; }
+    quint16 addLottieItem(const PWLottieItemInfo& lottieItemInfo) override;
 
     ///
     /// \brief removeLottieItem - Function removes lottie item from controller.
-    /// \param lottieUuid - Unique lottie UUID for it's controlling.
+    /// \param lottieHandle - Lottie handle for it's controlling.
+    ///
+    void removeLottieItem(const PWLottieHandle lottieHandle) override;
+
+    ///
+    /// \brief spriteSheet - Function gets sprite sheet of model in the given size, it's rendered in background if it wasn't requested before.
+    /// \param model - Model of lottie animation.
+    /// \param sourceSize - Size of item, budgets of icons are checked by it.
+    /// \param frameSize - Size of frames in pixels of screen.
+    /// \param format - Format of frames.
+    /// \return Returns shared sprite sheet or nullptr if animation must be rendered live.
+    ///
+    [[nodiscard]] std::shared_ptr<const PWLottieSpriteSheet> spriteSheet(const std::shared_ptr<const PWLottieModel>& model, const QSize& sourceSize, const QSize& frameSize, const QImage::Format format);
+
+    ///
+    /// \brief evictUnusedSpriteSheets - Function frees sprite sheets that aren't shown by any item.
+    ///
+    void evictUnusedSpriteSheets();
+
+    /***********/
+    /* Budgets */
+    /***********/
+
+    [[nodiscard]] inline qint64 maxFramePixels() const
+    {
+        return m_maxFramePixels;
+    }
+
     ///
-    void removeLottieItem(const QString& lottieUuid) override { }
+    /// \brief setMaxFramePixels - Function sets the biggest frame (width * height) that is played from sprite sheet.
+    /// \param maxFramePixels - Count of pixels in one frame.
+    ///
+    inline void setMaxFramePixels(const qint64 maxFramePixels)
+    {
+        m_maxFramePixels = maxFramePixels;
+    }
+
+    [[nodiscard]] inline qint32 maxFrames() const
+    {
+        return m_maxFrames;
+    }
+
+    ///
+    /// \brief setMaxFrames - Function sets the longest animation that is played from sprite sheet.
+    /// \param maxFrames - Count of frames in animation.
+    ///
+    inline void setMaxFrames(const qint32 maxFrames)
+    {
+        m_maxFrames = maxFrames;
+    }
+
+    [[nodiscard]] inline qint64 memoryBudget() const
+    {
+        return m_memoryBudget;
+    }
+
+    ///
+    /// \brief setMemoryBudget - Function sets memory that all sprite sheets can use, sheets that are shown already are kept.
+    /// \param memoryBudget - Memory budget in bytes.
+    ///
+    inline void setMemoryBudget(const qint64 memoryBudget)
+    {
+        m_memoryBudget = qMax<qint64>(0, memoryBudget);
+    }
+
+    [[nodiscard]] inline qint64 memoryUsage() const
+    {
+        return m_memoryUsage;
+    }
 
 signals:
-    void fpsChanged(const quint16 fps, const QString& lottieUuid = allLottiesDefiner);
+    void fpsChanged(const quint16 fps, const PWLottieHandle lottieHandle = allLottiesHandle);
+    void memoryUsageChanged(const qint64 memoryUsage);
+
+private:
+    /*************/
+    /* Variables */
+    /*************/
+
+    QHash<PWLottieFrameKey, std::shared_ptr<PWLottieSpriteSheet>> m_spriteSheets = {};
+
+    qint64 m_maxFramePixels = defaultIconMaxFramePixels;
+    qint32 m_maxFrames = defaultIconMaxFrames;
+    qint64 m_memoryBudget = defaultIconMemoryBudget;
+    qint64 m_memoryUsage = 0;
 };
 
 #endif // PWLOTTIEICONCONTROLLER_H
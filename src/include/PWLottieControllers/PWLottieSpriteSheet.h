@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) PrivateWeb Software (https://github.com/PrivateWebSoftware) - All Rights Reserved
+ *
+ * Licensed under the Apache License 2.0 (the "License"). You may not use
+ * this file except in compliance with the License. You can obtain a copy
+ * in the file LICENSE in the source distribution
+ *
+ * Written by PrivateWeb Software <privatewebsoftware@protonmail.com>, October 2026
+ */
+
+#ifndef PWLOTTIESPRITESHEET_H
+#define PWLOTTIESPRITESHEET_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QImage>
+#include <QMutex>
+#include <QPointer>
+#include <QQuickWindow>
+#include <QRectF>
+#include <QSGTexture>
+#include <QSize>
+
+#include <atomic>
+
+#include "include/PWLottieCache/PWLottieModel.h"
+
+///
+/// \brief The PWLottieSpriteSheet class - Every frame of lottie model rasterised once in one packed image.
+///
+/// Frames are laid out in a grid row by row, every frame is surrounded by gutter with copies of it's edge pixels,
+/// so linear filtering never blends neighbouring frames into it. Sheet is allocated when it's created, rendered
+/// in background once and never modified after that, so it can be shown by any count of items without any synchronization.
+/// Sheet is uploaded once per window, items that show it share one texture and only pick their frame by source rect.
+///
+class PWLottieSpriteSheet {
+
+#define maxSpriteSheetSide 4096
+#define spriteSheetGutter 2
+
+public:
+    PWLottieSpriteSheet(const QByteArray& contentHash, const QSize& frameSize, const qint32 totalFrames, const QImage::Format format);
+    ~PWLottieSpriteSheet();
+
+    /*************/
+    /* Functions */
+    /*************/
+
+    ///
+    /// \brief sheetSize - Function gets size of sheet with all frames of animation.
+    /// \param frameSize - Size of one frame.
+    /// \param totalFrames - Count of frames.
+    /// \return Returns size of packed sheet with gutters.
+    ///
+    [[nodiscard]] static QSize sheetSize(const QSize& frameSize, const qint32 totalFrames);
+
+    ///
+    /// \brief sheetByteCost - Function gets memory that is used by sheet of the given size.
+    /// \param sheetSize - Size of packed sheet.
+    /// \return Returns size of sheet pixels and of it's texture in bytes.
+    ///
+    [[nodiscard]] static qint64 sheetByteCost(const QSize& sheetSize);
+
+    ///
+    /// \brief render - Function rasterises every frame of model in sheet, it's called once from render worker.
+    /// \param model - Model of lottie animation.
+    ///
+    void render(const PWLottieModel& model);
+
+    ///
+    /// \brief frameRect - Function gets rect of frame in sheet.
+    /// \param frame - Frame of animation.
+    /// \return Returns rect in pixels of sheet, without gutter.
+    ///
+    [[nodiscard]] QRectF frameRect(const qint32 frame) const;
+
+    ///
+    /// \brief texture - Function gets texture of sheet in the given window, sheet is uploaded only once per window.
+    /// \attention Function must be called from render thread of window, like from 'updatePaintNode'.
+    ///
+    /// \param window - Window that shows sheet.
+    /// \return Returns texture that is owned by sheet, nodes mustn't delete it.
+    ///
+    [[nodiscard]] QSGTexture* texture(QQuickWindow* window) const;
+
+    /**************/
+    /* Properties */
+    /**************/
+
+    ///
+    /// \brief isReady - Function checks if all frames were rendered, image mustn't be used before it.
+    /// \return Returns true if sheet can be shown.
+    ///
+    [[nodiscard]] inline bool isReady() const
+    {
+        return m_ready.load(std::memory_order_acquire);
+    }
+
+    [[nodiscard]] inline const QImage& image() const
+    {
+        return m_image;
+    }
+
+    [[nodiscard]] inline QByteArray contentHash() const
+    {
+        return m_contentHash;
+    }
+
+    [[nodiscard]] inline QSize frameSize() const
+    {
+        return m_frameSize;
+    }
+
+    [[nodiscard]] inline QImage::Format format() const
+    {
+        return m_image.format();
+    }
+
+    ///
+    /// \brief byteCost - Function gets memory that is used by sheet.
+    /// \return Returns size of sheet pixels and of it's texture in bytes.
+    ///
+    [[nodiscard]] inline qint64 byteCost() const
+    {
+        return m_byteCost;
+    }
+
+private:
+    ///
+    /// \brief The WindowTexture struct - Texture of sheet in one window, it's deleted with scene graph of window.
+    ///
+    struct WindowTexture {
+        QPointer<QQuickWindow> window;
+        QPointer<QSGTexture> texture;
+    };
+
+    /*************/
+    /* Variables */
+    /*************/
+
+    QByteArray m_contentHash;
+    QSize m_frameSize;
+    qint32 m_totalFrames = 0;
+    qint32 m_columns = 0;
+    qint64 m_byteCost = 0;
+
+    QImage m_image;
+    std::atomic<bool> m_ready = false;
+
+    mutable QMutex m_textureMutex;
+    mutable QHash<QQuickWindow*, WindowTexture> m_textures = {};
+};
+
+#endif // PWLOTTIESPRITESHEET_H
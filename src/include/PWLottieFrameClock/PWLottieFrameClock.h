@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) PrivateWeb Software (https://github.com/PrivateWebSoftware) - All Rights Reserved
+ *
+ * Licensed under the Apache License 2.0 (the "License"). You may not use
+ * this file except in compliance with the License. You can obtain a copy
+ * in the file LICENSE in the source distribution
+ *
+ * Written by PrivateWeb Software <privatewebsoftware@protonmail.com>, October 2026
+ */
+
+#ifndef PWLOTTIEFRAMECLOCK_H
+#define PWLOTTIEFRAMECLOCK_H
+
+#include <QAbstractAnimation>
+#include <QCoreApplication>
+#include <QHash>
+#include <QList>
+#include <QPointer>
+
+class PWLottieItem;
+
+///
+/// \brief The PWLottieFrameClock class - Central animation clock that drives all running lottie items.
+///
+/// Clock is an endless QAbstractAnimation, so it is advanced by the same QAnimationDriver that
+/// Qt Quick render loop drives with window's vsync. On every display frame clock ticks only
+/// those items whose frame rate interval has passed. Items that aren't visible are ticked only
+/// a few times per second, just to check if they became visible again.
+/// Clock runs only while at least one item is registered.
+///
+class PWLottieFrameClock : public QAbstractAnimation {
+    Q_OBJECT
+
+#define culledItemCheckInterval 250
+
+public:
+    explicit PWLottieFrameClock(QObject* parent = nullptr);
+
+    /*************/
+    /* Functions */
+    /*************/
+
+    ///
+    /// \brief instance - Singleton instance funtion, cause we need only one clock for hole application.
+    /// \return Instance to PWLottieFrameClock class.
+    ///
+    static inline QPointer<PWLottieFrameClock> instance()
+    {
+        if (!m_instance) {
+            m_instance = QPointer<PWLottieFrameClock>(new PWLottieFrameClock(QCoreApplication::instance()));
+        }
+
+        return m_instance;
+    }
+
+    ///
+    /// \brief registerLottieItem - Function registers lottie item, so it will be ticked by clock.
+    /// \param lottieItem - Lottie item that will be registered.
+    ///
+    void registerLottieItem(PWLottieItem* lottieItem);
+
+    ///
+    /// \brief unregisterLottieItem - Function unregisters lottie item, so it won't be ticked anymore.
+    /// \param lottieItem - Lottie item that will be unregistered.
+    ///
+    void unregisterLottieItem(PWLottieItem* lottieItem);
+
+    ///
+    /// \brief duration - Overrided QAbstractAnimation function 'duration'. Clock never ends.
+    /// \return Returns '-1'.
+    ///
+    [[nodiscard]] inline int duration() const override
+    {
+        return -1;
+    }
+
+    ///
+    /// \brief displayFrameInterval - Function gets measured interval between display frames.
+    /// \return Returns interval in milliseconds.
+    ///
+    [[nodiscard]] inline qreal displayFrameInterval() const
+    {
+        return m_displayFrameInterval;
+    }
+
+    ///
+    /// \brief hasDisplayFrameInterval - Function checks whether display frame interval was measured since clock was started.
+    /// \return Returns false if clock is stopped, then measured interval is outdated.
+    ///
+    [[nodiscard]] inline bool hasDisplayFrameInterval() const
+    {
+        return state() == QAbstractAnimation::Running && m_displayFrameMeasured;
+    }
+
+protected:
+    ///
+    /// \brief updateCurrentTime - Overrided QAbstractAnimation function 'updateCurrentTime'. It's called once per display frame.
+    /// \param currentTime - Current time of clock in milliseconds.
+    ///
+    void updateCurrentTime(int currentTime) override;
+
+private:
+    ///
+    /// \brief The ClockEntry struct - Registered lottie item and time of it's next tick.
+    ///
+    struct ClockEntry {
+        PWLottieItem* lottieItem = nullptr;
+        qreal nextTickTime = 0.0;
+    };
+
+    /*************/
+    /* Variables */
+    /*************/
+
+    QList<ClockEntry> m_clockEntries = {};
+    QHash<PWLottieItem*, qsizetype> m_clockIndexes = {};
+    QList<PWLottieItem*> m_dueLottieItems = {};
+
+    qint32 m_lastTickTime = -1;
+    qreal m_displayFrameInterval = qreal(1000) / 60;
+    bool m_displayFrameMeasured = false;
+
+    inline static QPointer<PWLottieFrameClock> m_instance;
+};
+
+#endif // PWLOTTIEFRAMECLOCK_H
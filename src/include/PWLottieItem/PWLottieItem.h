@@ -11,31 +11,39 @@
 #ifndef LOTTIEITEM_H
 #define LOTTIEITEM_H
 
+#include <QCoreApplication>
 #include <QDebug>
+#include <QElapsedTimer>
 #include <QFile>
 #include <QImage>
+#include <QLineF>
 #include <QMutex>
 #include <QMutexLocker>
 #include <QObject>
-#include <QPainter>
-#include <QQuickPaintedItem>
-#include <QScopedArrayPointer>
-#include <QScopedPointer>
-#include <QThreadPool>
-#include <QTimer>
-#include <QUuid>
-#include <QtConcurrent>
+#include <QPointer>
+#include <QQuickItem>
+#include <QQuickWindow>
+#include <QSGImageNode>
+#include <QUrl>
+#include <QtMath>
 
 #include <rlottie.h>
 #include <rlottie_capi.h>
 #include <rlottiecommon.h>
 
 #include "include/PWControllerMediator/PWControllerMediator.h"
+#include "include/PWLottieCache/PWLottieBufferPool.h"
+#include "include/PWLottieCache/PWLottieCache.h"
+#include "include/PWLottieCache/PWLottieFrameCache.h"
+#include "include/PWLottiePixels/PWLottiePixels.h"
+#include "include/PWLottieRenderScheduler/PWLottieRenderScheduler.h"
+#include "include/PWLottieStats/PWLottieStats.h"
+#include "include/PWLottieTrace/PWLottieTrace.h"
 
 ///
-/// \brief The PWLottieItem class - QQuickItem, that paints images rendered by rlottie engine.
+/// \brief The PWLottieItem class - QQuickItem, that shows images rendered by rlottie engine as scene graph textures.
 ///
-class PWLottieItem : public QQuickPaintedItem {
+class PWLottieItem : public QQuickItem {
     Q_OBJECT
     QML_ELEMENT
 
@@ -45,25 +53,69 @@ class PWLottieItem : public QQuickPaintedItem {
     Q_PROPERTY(qreal duration READ duration NOTIFY durationChanged)
     Q_PROPERTY(QSizeF sourceSize READ sourceSize WRITE setSourceSize NOTIFY sourceSizeChanged)
     Q_PROPERTY(QString source READ source WRITE setSource NOTIFY sourceChanged)
+    Q_PROPERTY(bool asynchronous READ asynchronous WRITE setAsynchronous NOTIFY asynchronousChanged)
+    Q_PROPERTY(Status status READ status NOTIFY statusChanged)
+    Q_PROPERTY(qreal progress READ progress NOTIFY progressChanged)
     Q_PROPERTY(PWControllerMediator::ControllerType controller READ controller WRITE setController NOTIFY controllerChanged)
+    Q_PROPERTY(qreal priority READ priority WRITE setPriority NOTIFY priorityChanged)
+    Q_PROPERTY(bool autoRenderScale READ autoRenderScale WRITE setAutoRenderScale NOTIFY autoRenderScaleChanged)
+    Q_PROPERTY(qreal maxRenderScale READ maxRenderScale WRITE setMaxRenderScale NOTIFY maxRenderScaleChanged)
+    Q_PROPERTY(qreal renderScale READ renderScale NOTIFY renderScaleChanged)
+    Q_PROPERTY(OutputFormat outputFormat READ outputFormat WRITE setOutputFormat NOTIFY outputFormatChanged)
 
-#define lottieRgbFormatSize 32
-#define lottieRgbChannelSize 8
-#define maxRenderThreads 1
+#define frameImagesCount 3
+#define sharedFrameImageIndex frameImagesCount
+
+#define defaultMaxRenderScale 2.0
+#define renderLevelsCount 3
+#define fastMotionVelocity 1000.0
+#define overloadedDisplayFrameInterval 20.0
+#define renderLevelRestoreDelay 500
 
 #define initializePWLottieControllers qmlRegisterUncreatableType<PWControllerMediator>("PrivateWeb.PWLottie.Controllers", 2, 0, "ControllerType", "Cannot initialize PWLottie Controllers in QML");
 
 public:
     PWLottieItem();
+
+    /*********/
+    /* Enums */
+    /*********/
+
+    ///
+    /// \brief The Status enum - Loading status of lottie animation source.
+    ///
+    enum Status {
+        Null = 0,
+        Ready = 1,
+        Loading = 2,
+        Error = 3
+    };
+    Q_ENUM(Status)
+
+    ///
+    /// \brief The OutputFormat enum - Pixel format of frames that are handed over to scene graph.
+    ///
+    enum OutputFormat {
+        ARGB32Premultiplied = 0,
+        RGBA8888Premultiplied = 1,
+        ARGB32 = 2,
+        RGBA8888 = 3
+    };
+    Q_ENUM(OutputFormat)
+
     ~PWLottieItem()
     {
         /* Stop animation */
         this->pause();
 
-        /* Unregister Lottie Animation in controllers */
-        if (m_controllerType != PWControllerMediator::ControllerType::NoController) {
-            PWControllerMediator::unregisterLottieAnimation(m_controllerType, m_lottieUuid);
-        }
+        /* Jobs that are still queued skip rendering, they keep their own references to frame buffers */
+        m_renderQueue->cancel();
+
+        /* Sprite sheet is released before unregistration, so icon controller can free it */
+        m_spriteSheet = nullptr;
+
+        /* Unregister Lottie Animation in registry and in it's controller */
+        PWControllerMediator::unregisterLottieItem(m_lottieHandle);
     }
 
     /*****************/
@@ -84,18 +136,11 @@ public:
         return m_frameRate;
     }
 
-    inline void setFrameRate(const qint32 frameRate)
-    {
-        m_frameRate = frameRate;
-
-        /*
-         * Set up needed framerate render changes per one second
-         * 1000 - One Second
-         */
-        m_renderTimer.setInterval(qRound(qreal(1000) / m_frameRate));
-
-        emit frameRateChanged(m_frameRate);
-    }
+    ///
+    /// \brief setFrameRate - Function sets framerate of lottie animation.
+    /// \param frameRate - Framerate that will be installed.
+    ///
+    void setFrameRate(const qint32 frameRate);
 
     /*********/
     /* Loops */
@@ -146,6 +191,92 @@ public:
         return m_source;
     }
 
+    /****************/
+    /* Asynchronous */
+    /****************/
+
+    [[nodiscard]] inline bool asynchronous() const
+    {
+        return m_asynchronous;
+    }
+
+    ///
+    /// \brief setAsynchronous - Function sets whether source is loaded in render scheduler instead of GUI thread.
+    /// \param asynchronous - Asynchronous loading state that will be applied for the next source.
+    ///
+    inline void setAsynchronous(const bool asynchronous)
+    {
+        if (m_asynchronous != asynchronous) {
+            m_asynchronous = asynchronous;
+
+            emit asynchronousChanged();
+        }
+    }
+
+    /**********/
+    /* Status */
+    /**********/
+
+    [[nodiscard]] inline Status status() const
+    {
+        return m_status;
+    }
+
+    [[nodiscard]] inline qreal progress() const
+    {
+        return m_progress;
+    }
+
+    /****************/
+    /* Render scale */
+    /****************/
+
+    [[nodiscard]] inline bool autoRenderScale() const
+    {
+        return m_autoRenderScale;
+    }
+
+    ///
+    /// \brief setAutoRenderScale - Function sets whether resolution of rendered frames is lowered automatically when item is small, moving or system is overloaded.
+    /// \param autoRenderScale - Automatic render scale state.
+    ///
+    void setAutoRenderScale(const bool autoRenderScale);
+
+    [[nodiscard]] inline qreal maxRenderScale() const
+    {
+        return m_maxRenderScale;
+    }
+
+    ///
+    /// \brief setMaxRenderScale - Function sets the biggest scale of rendered frames relative to source size.
+    /// \param maxRenderScale - Maximal render scale.
+    ///
+    void setMaxRenderScale(const qreal maxRenderScale);
+
+    ///
+    /// \brief renderScale - Function gets scale relative to source size in which frames are rendered now.
+    /// \return Returns current render scale.
+    ///
+    [[nodiscard]] inline qreal renderScale() const
+    {
+        return m_renderScale;
+    }
+
+    /*****************/
+    /* Output format */
+    /*****************/
+
+    [[nodiscard]] inline OutputFormat outputFormat() const
+    {
+        return m_outputFormat;
+    }
+
+    ///
+    /// \brief setOutputFormat - Function sets pixel format of frames, it's applied from the next rendered frame.
+    /// \param outputFormat - Output format that will be installed.
+    ///
+    void setOutputFormat(const OutputFormat outputFormat);
+
     /**************/
     /* Controller */
     /**************/
@@ -161,8 +292,19 @@ public:
     ///
     void setController(const PWControllerMediator::ControllerType controllerType);
 
+    [[nodiscard]] inline qreal priority() const
+    {
+        return m_priority;
+    }
+
+    ///
+    /// \brief setPriority - Function sets priority of lottie animation, controllers give more resources to items with higher priority.
+    /// \param priority - Priority that will be installed.
     ///
-    /// \brief setSource -Functions sets source size and loads rlottie::Animation and it's properties/
+    void setPriority(const qreal priority);
+
+    ///
+    /// \brief setSource - Functions sets source and loads model of lottie animation and it's properties, in render scheduler if item is asynchronous.
     /// \param source - Source of image that will be applied for item.
     ///
     void setSource(const QString& source);
@@ -172,16 +314,105 @@ public:
     /*********/
 
     ///
-    /// \brief paint - Overrided QQuickPaintedItem function 'paint'. It paints image in qml.
-    /// \param painter - Painting device.
+    /// \brief updatePaintNode - Overrided QQuickItem function 'updatePaintNode'. It hands rendered frame to scene graph as texture.
+    /// \param oldNode - Node that was returned on previous call.
+    /// \param updatePaintNodeData - Transformation data of item.
+    /// \return Returns node that shows current frame.
     ///
-    void paint(QPainter* painter) override;
+    QSGNode* updatePaintNode(QSGNode* oldNode, UpdatePaintNodeData* updatePaintNodeData) override;
 
     ///
     /// \brief render - Function renders in thread Lottie Image data before it's painting.
     ///
     void render();
 
+    /***********/
+    /* Culling */
+    /***********/
+
+    ///
+    /// \brief culled - Function checks if item isn't rendered now because it can't be seen.
+    /// \return Returns true if item is culled.
+    ///
+    [[nodiscard]] inline bool culled() const
+    {
+        return m_culled;
+    }
+
+    /**************/
+    /* Statistics */
+    /**************/
+
+    ///
+    /// \brief droppedFrames - Function gets count of animation frames that were skipped to keep playback in real time.
+    /// \return Returns count of dropped frames.
+    ///
+    [[nodiscard]] inline quint64 droppedFrames() const
+    {
+        return m_droppedFrames;
+    }
+
+    ///
+    /// \brief coalescedFrames - Function gets count of ticks that came while previous frame was still rendering.
+    /// \return Returns count of coalesced frames.
+    ///
+    [[nodiscard]] inline quint64 coalescedFrames() const
+    {
+        return m_coalescedFrames;
+    }
+
+    ///
+    /// \brief skippedFrames - Function gets count of ticks that didn't render anything, cause their frame was already shown.
+    /// \return Returns count of skipped frames.
+    ///
+    [[nodiscard]] inline quint64 skippedFrames() const
+    {
+        return m_skippedFrames;
+    }
+
+    ///
+    /// \brief cancelledFrames - Function gets count of frames that were cancelled by change of source, size, format or culling, before or after they were rendered.
+    /// \return Returns count of cancelled frames.
+    ///
+    [[nodiscard]] inline quint64 cancelledFrames() const
+    {
+        return m_cancelledFrames;
+    }
+
+    ///
+    /// \brief renderedFrames - Function gets count of frames that were rendered or picked from sprite sheet and shown.
+    /// \return Returns count of shown frames.
+    ///
+    [[nodiscard]] inline quint64 renderedFrames() const
+    {
+        return m_renderedFrames;
+    }
+
+    ///
+    /// \brief lastRenderTime - Function gets time that rendering of the last frame took.
+    /// \return Returns time in nanoseconds.
+    ///
+    [[nodiscard]] inline qint64 lastRenderTime() const
+    {
+        return m_lastRenderTime;
+    }
+
+    [[nodiscard]] inline const PWLottieTimeSamples& renderTimeSamples() const
+    {
+        return m_renderTimeSamples;
+    }
+
+    [[nodiscard]] inline const PWLottieTimeSamples& schedulingLatencySamples() const
+    {
+        return m_schedulingLatencySamples;
+    }
+
+    ///
+    /// \brief stats - Function gets snapshot of counters of item.
+    /// \return Returns counters, timing is filled only while PWLottieStats are enabled.
+    ///
+    [[nodiscard]] PWLottieItemStats stats() const;
+
 public slots:
     ///
     /// \brief resume - Function resumes rendering of lottie animation.
@@ -192,7 +423,7 @@ public slots:
             m_running = true;
 
             /* Start rendering */
-            this->render();
+            updateFrameClockRegistration();
         }
     }
 
@@ -202,6 +433,9 @@ public slots:
     void pause()
     {
         m_running = false;
+
+        /* Paused item doesn't need ticks of frame clock */
+        updateFrameClockRegistration();
     }
 
 signals:
@@ -213,35 +447,273 @@ signals:
     void sourceSizeChanged();
     void sourceChanged();
     void controllerChanged();
+    void asynchronousChanged();
+    void statusChanged();
+    void progressChanged(const qreal progress);
+    void priorityChanged();
+    void autoRenderScaleChanged();
+    void maxRenderScaleChanged();
+    void renderScaleChanged();
+    void outputFormatChanged();
 
 private:
+    /*************/
+    /* Functions */
+    /*************/
+
+    ///
+    /// \brief updateFrameClockRegistration - Function registers item in PWLottieFrameClock when it can be rendered and unregisters it otherwise.
+    ///
+    void updateFrameClockRegistration();
+
+    ///
+    /// \brief playbackPosition - Function gets position of animation in seconds from the start of playback.
+    /// \return Returns position that includes all played loops.
+    ///
+    [[nodiscard]] qreal playbackPosition() const;
+
+    ///
+    /// \brief isFrameShown - Function checks if frame is already shown in the given size and output format.
+    /// \param frame - Frame of animation.
+    /// \param frameSize - Size of shown frame image.
+    /// \return Returns true if frame doesn't need rendering and uploading.
+    ///
+    [[nodiscard]] bool isFrameShown(const qint32 frame, const QSize& frameSize) const;
+
+    ///
+    /// \brief applyModel - Function applies loaded model of lottie animation and starts rendering.
+    /// \param model - Loaded model or nullptr if source couldn't be loaded.
+    ///
+    void applyModel(std::shared_ptr<const PWLottieModel> model);
+
+    ///
+    /// \brief setStatus - Function sets loading status of source.
+    /// \param status - Status that will be installed.
+    ///
+    void setStatus(const Status status);
+
+    ///
+    /// \brief setProgress - Function sets loading progress of source.
+    /// \param progress - Progress from '0.0' to '1.0'.
+    ///
+    void setProgress(const qreal progress);
+
+    ///
+    /// \brief renderOwnFrame - Function renders frame in item's own frame image.
+    /// \param frame - Frame of animation.
+    /// \param frameSize - Size in which frame is rendered.
+    /// \param outputSize - Size to which frame is downscaled.
+    /// \param finished - Whether it's the last frame of the last loop.
+    ///
+    void renderOwnFrame(const qint32 frame, const QSize& frameSize, const QSize& outputSize, const bool finished);
+
+    ///
+    /// \brief renderSharedFrame - Function takes frame from PWLottieFrameCache, it's rendered only by the first item that needs it.
+    /// \param frame - Frame of animation.
+    /// \param frameSize - Size in which frame is rendered.
+    /// \param finished - Whether it's the last frame of the last loop.
+    ///
+    void renderSharedFrame(const qint32 frame, const QSize& frameSize, const bool finished);
+
+    ///
+    /// \brief finishRender - Function shows rendered frame, it's called in GUI thread when rendering is finished.
+    /// \param frameImageIndex - Index of frame image with rendered frame.
+    /// \param frame - Rendered frame of animation.
+    /// \param finished - Whether it's the last frame of the last loop.
+    /// \param renderTime - Time of rendering in nanoseconds.
+    /// \param renderVersion - Version of render queue when frame was submitted.
+    ///
+    void finishRender(const qint32 frameImageIndex, const qint32 frame, const bool finished, const qint64 renderTime, const quint64 renderVersion);
+
+    ///
+    /// \brief releaseFrameImages - Function gives buffers of frames that aren't shown back to PWLottieBufferPool.
+    ///
+    void releaseFrameImages();
+
+    ///
+    /// \brief updateFrameCacheUser - Function registers item in PWLottieFrameCache as user of model in the given size.
+    /// \param contentHash - Content hash of model, empty to unregister item.
+    /// \param frameSize - Size in which model is rendered.
+    /// \param frameFormat - Pixel format of frames.
+    ///
+    void updateFrameCacheUser(const QByteArray& contentHash, const QSize& frameSize, const QImage::Format frameFormat);
+
+    ///
+    /// \brief updateSpriteSheet - Function requests sprite sheet from icon controller when item is an icon and releases it otherwise.
+    ///
+    void updateSpriteSheet();
+
+    ///
+    /// \brief spriteSheetFrameSize - Function gets size of frames in sprite sheet, it's source size in pixels of screen.
+    /// \return Returns size of one frame of sheet.
+    ///
+    [[nodiscard]] QSize spriteSheetFrameSize() const;
+
+    ///
+    /// \brief lottieItemInfo - Function gets properties of item that controllers use.
+    /// \return Returns UUID, size on screen in pixels and priority of item, culled item has empty size.
+    ///
+    [[nodiscard]] PWLottieItemInfo lottieItemInfo() const;
+
+    ///
+    /// \brief updateLottieItemInfo - Function gives changed size, visibility or priority of item to it's controller.
+    ///
+    void updateLottieItemInfo();
+
+    ///
+    /// \brief updateRenderScale - Function selects scale of the next rendered frame by size of item on screen, it's motion and load of system.
+    /// \return Returns size in which the next frame is rendered.
+    ///
+    [[nodiscard]] QSize updateRenderScale();
+
+    ///
+    /// \brief frameOutputSize - Function gets size of shown frame, own frames are downscaled when they are rendered much bigger than item is shown.
+    /// \param frameSize - Size in which frame is rendered.
+    /// \return Returns size of frame image.
+    ///
+    [[nodiscard]] QSize frameOutputSize(const QSize& frameSize) const;
+
+    ///
+    /// \brief frameFormat - Function gets image format of frames for output format of item.
+    /// \return Returns format of frame images.
+    ///
+    [[nodiscard]] QImage::Format frameFormat() const;
+
+    ///
+    /// \brief isEffectivelyVisible - Function checks if item can be seen: it's visible, not transparent, it's window is exposed and it's inside of clipping parents and window.
+    /// \return Returns true if item can be seen.
+    ///
+    [[nodiscard]] bool isEffectivelyVisible() const;
+
+    ///
+    /// \brief updateCulling - Function culls item that can't be seen and unculls it when it can be seen again.
+    ///
+    void updateCulling();
+
+    ///
+    /// \brief checkCulling - Function updates culling right away and renders current frame of item that can be seen again.
+    ///
+    void checkCulling();
+
+    ///
+    /// \brief updateAncestorConnections - Function follows moves, resizes and clipping of parents, that change visible part of item without any change of item itself.
+    ///
+    void updateAncestorConnections();
+
+protected:
+    ///
+    /// \brief itemChange - Overrided QQuickItem function 'itemChange'. Item is checked for visibility right away when it's visibility, opacity, parent or window is changed.
+    /// \param change - Type of change.
+    /// \param value - Data of change.
+    ///
+    void itemChange(ItemChange change, const ItemChangeData& value) override;
+
+    ///
+    /// \brief geometryChange - Overrided QQuickItem function 'geometryChange'. Controllers get new size of item on screen, moved item is checked for visibility.
+    /// \param newGeometry - New geometry of item.
+    /// \param oldGeometry - Previous geometry of item.
+    ///
+    void geometryChange(const QRectF& newGeometry, const QRectF& oldGeometry) override;
+
+private:
+
     /******************/
     /* QML properties */
     /******************/
 
     bool m_running = true;
-    qint32 m_currentFrame = 0;
+    qint32 m_currentFrame = -1;
     qint32 m_totalFrames = 0;
     qint32 m_loops = 0;
     qint32 m_frameRate = 60;
     qreal m_duration = 0.0;
     QSizeF m_sourceSize = { 0, 0 };
     QString m_source;
+    bool m_asynchronous = true;
+    Status m_status = Status::Null;
+    qreal m_progress = 0.0;
     PWControllerMediator::ControllerType m_controllerType = PWControllerMediator::ControllerType::NoController;
+    qreal m_priority = 1.0;
+    bool m_autoRenderScale = false;
+    qreal m_maxRenderScale = defaultMaxRenderScale;
+    qreal m_renderScale = 1.0;
+    OutputFormat m_outputFormat = OutputFormat::ARGB32Premultiplied;
 
     /*******************/
     /* Lottie privates */
     /*******************/
 
-    QString m_lottieUuid;
-    qint32 m_currentLoops = 0;
+    PWLottieHandle m_lottieHandle = -1;
 
-    std::unique_ptr<rlottie::Animation> m_animation = nullptr;
-    QScopedArrayPointer<char> m_frameBuffer;
-    QImage m_currentImage;
+    quint64 m_sourceVersion = 0;
+
+    std::shared_ptr<const PWLottieModel> m_model = nullptr;
+
+    /*
+     * Frame images: front one is the latest rendered frame, pinned one was handed
+     * to scene graph and can still be uploaded, next frame is rendered in the third one.
+     * Pixels pointers are taken once on allocation, because textures share image data.
+     * The last image holds frame from PWLottieFrameCache, it's never rendered in.
+     * Buffers come from PWLottieBufferPool and go back to it when images are released.
+     */
+    QImage m_frameImages[frameImagesCount + 1];
+    uchar* m_frameBits[frameImagesCount] = {};
+    qint32 m_frontFrameIndex = -1;
+    qint32 m_pinnedFrameIndex = -1;
+    qint32 m_renderingFrameIndex = -1;
+    bool m_frameDirty = false;
+
+    /* Icons show frames of shared sprite sheet as soon as it's rendered */
+    std::shared_ptr<const PWLottieSpriteSheet> m_spriteSheet = nullptr;
+    bool m_showSprite = false;
+
+    /*******************/
+    /* Render privates */
+    /*******************/
 
-    QTimer m_renderTimer;
-    QThreadPool m_renderThreadPool;
+    PWLottieRenderScheduler::RenderQueuePtr m_renderQueue = PWLottieRenderScheduler::createQueue();
+
+    bool m_frameClockRegistered = false;
+    bool m_renderInFlight = false;
+    bool m_renderPending = false;
+    bool m_culled = false;
+
+    /* Scrolled views move their content item, so parents of item are followed to notice when it's scrolled in */
+    QList<QMetaObject::Connection> m_ancestorConnections;
+
+    QByteArray m_frameCacheContentHash;
+    QSize m_frameCacheSize;
+    QImage::Format m_frameCacheFormat = QImage::Format_Invalid;
+
+    /*************************/
+    /* Render scale privates */
+    /*************************/
+
+    /* Level of detail: '0' renders full resolution, every next level renders half of pixels of previous one */
+    qint32 m_renderLevel = 0;
+    qint64 m_lastRenderTime = 0;
+    QPointF m_lastScenePosition;
+    QElapsedTimer m_motionTimer;
+    QElapsedTimer m_renderLevelTimer;
+
+    /*********************/
+    /* Playback privates */
+    /*********************/
+
+    QElapsedTimer m_playbackTimer;
+    qreal m_playbackPosition = 0.0;
+    qint64 m_lastFramePosition = -1;
+
+    quint64 m_droppedFrames = 0;
+    quint64 m_coalescedFrames = 0;
+    quint64 m_renderedFrames = 0;
+    quint64 m_skippedFrames = 0;
+    quint64 m_cancelledFrames = 0;
+
+    qint64 m_pendingTickTime = -1;
+    qint64 m_renderTickTime = -1;
+    PWLottieTimeSamples m_renderTimeSamples;
+    PWLottieTimeSamples m_schedulingLatencySamples;
 };
 
 #endif // LOTTIEITEM_H
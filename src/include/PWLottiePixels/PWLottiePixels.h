@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) PrivateWeb Software (https://github.com/PrivateWebSoftware) - All Rights Reserved
+ *
+ * Licensed under the Apache License 2.0 (the "License"). You may not use
+ * this file except in compliance with the License. You can obtain a copy
+ * in the file LICENSE in the source distribution
+ *
+ * Written by PrivateWeb Software <privatewebsoftware@protonmail.com>, October 2026
+ */
+
+#ifndef PWLOTTIEPIXELS_H
+#define PWLOTTIEPIXELS_H
+
+#include <QImage>
+#include <QSize>
+
+///
+/// \brief The PWLottiePixels class - Pixel kernels that prepare frames rendered by rlottie for the scene graph.
+///
+/// rlottie renders premultiplied ARGB32. Frames are converted in place to the output format of item and
+/// downscaled with 2x2 box filter when they are rendered much bigger than they are shown. Kernels use
+/// SSE2 and AVX2 on x86 (AVX2 is selected at runtime), NEON on ARM and scalar code everywhere else.
+/// Build with '-DPWLOTTIE_SIMD=OFF' to use only scalar kernels.
+///
+class PWLottiePixels {
+
+public:
+    /*************/
+    /* Functions */
+    /*************/
+
+    ///
+    /// \brief convert - Function converts pixels rendered by rlottie in place.
+    /// \param bits - Pixels in premultiplied ARGB32.
+    /// \param bytesPerLine - Bytes per line of pixels.
+    /// \param size - Size of pixels.
+    /// \param format - Format pixels are converted to: premultiplied or straight ARGB32 or RGBA8888.
+    ///
+    static void convert(uchar* bits, const qsizetype bytesPerLine, const QSize& size, const QImage::Format format);
+
+    ///
+    /// \brief downscaledSize - Function gets size to which frame is halved, until it's not smaller than displayed size.
+    /// \param frameSize - Size of rendered frame.
+    /// \param displaySize - Size of item on screen in pixels.
+    /// \return Returns size of frame after downscaling, or frame size if it isn't downscaled.
+    ///
+    [[nodiscard]] static QSize downscaledSize(const QSize& frameSize, const QSize& displaySize);
+
+    ///
+    /// \brief downscale - Function halves pixels with 2x2 box filter until they have the given size.
+    /// \attention Source pixels are overwritten when they are halved more than once.
+    ///
+    /// \param sourceBits - Pixels in premultiplied ARGB32.
+    /// \param sourceBytesPerLine - Bytes per line of source pixels.
+    /// \param sourceSize - Size of source pixels.
+    /// \param targetBits - Downscaled pixels.
+    /// \param targetBytesPerLine - Bytes per line of downscaled pixels.
+    /// \param targetSize - Size from downscaledSize().
+    ///
+    static void downscale(uchar* sourceBits, const qsizetype sourceBytesPerLine, const QSize& sourceSize, uchar* targetBits, const qsizetype targetBytesPerLine, const QSize& targetSize);
+
+private:
+    PWLottiePixels() { }
+};
+
+#endif // PWLOTTIEPIXELS_H
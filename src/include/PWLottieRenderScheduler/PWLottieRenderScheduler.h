@@ -0,0 +1,183 @@
+/*
+ * Copyright (C) PrivateWeb Software (https://github.com/PrivateWebSoftware) - All Rights Reserved
+ *
+ * Licensed under the Apache License 2.0 (the "License"). You may not use
+ * this file except in compliance with the License. You can obtain a copy
+ * in the file LICENSE in the source distribution
+ *
+ * Written by PrivateWeb Software <privatewebsoftware@protonmail.com>, October 2026
+ */
+
+#ifndef PWLOTTIERENDERSCHEDULER_H
+#define PWLOTTIERENDERSCHEDULER_H
+
+#include <QMutex>
+#include <QMutexLocker>
+#include <QReadWriteLock>
+#include <QThread>
+#include <QWaitCondition>
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <vector>
+
+///
+/// \brief The PWLottieRenderScheduler class - Process-wide render scheduler shared by all lottie items.
+///
+/// Scheduler owns a fixed set of worker threads (by default one per core) with work-stealing queues.
+/// Every worker takes it's own jobs in submission order, so long jobs are never starved by jobs that resubmit themselves.
+/// Jobs submitted through a RenderQueue are executed one at a time and strictly in submission order,
+/// so every lottie item gets its frames back in order, while different items render in parallel.
+///
+class PWLottieRenderScheduler {
+
+public:
+    using Job = std::function<void()>;
+
+    ///
+    /// \brief The RenderQueue struct - Ordered queue of jobs, usually one per lottie item.
+    ///
+    /// Every job is submitted for the current version of queue. Owner of queue cancels all submitted
+    /// jobs by moving to the next version, jobs check it before expensive work and skip it when they are stale.
+    ///
+    struct RenderQueue {
+        QMutex mutex;
+        std::deque<Job> jobs;
+        bool scheduled = false;
+
+        std::atomic<quint64> version = 0;
+
+        ///
+        /// \brief cancel - Function makes all jobs that were submitted before it stale.
+        ///
+        inline void cancel()
+        {
+            version.fetch_add(1, std::memory_order_acq_rel);
+        }
+
+        ///
+        /// \brief isStale - Function checks if job was cancelled, it's called from worker thread.
+        /// \param jobVersion - Version of queue when job was submitted.
+        /// \return Returns true if queue was cancelled after job was submitted.
+        ///
+        [[nodiscard]] inline bool isStale(const quint64 jobVersion) const
+        {
+            return version.load(std::memory_order_acquire) != jobVersion;
+        }
+    };
+
+    using RenderQueuePtr = std::shared_ptr<RenderQueue>;
+
+    ~PWLottieRenderScheduler();
+
+    /*************/
+    /* Functions */
+    /*************/
+
+    ///
+    /// \brief instance - Singleton instance funtion, cause we need only one render scheduler for hole application.
+    /// \return Instance to PWLottieRenderScheduler class.
+    ///
+    static PWLottieRenderScheduler* instance();
+
+    ///
+    /// \brief createQueue - Creates new ordered queue, jobs of this queue never run concurrently or out of order.
+    /// \return Returns created queue.
+    ///
+    [[nodiscard]] static inline RenderQueuePtr createQueue()
+    {
+        return std::make_shared<RenderQueue>();
+    }
+
+    ///
+    /// \brief threadCount - Function gets count of worker threads used by scheduler.
+    /// \return Returns count of worker threads.
+    ///
+    [[nodiscard]] qint32 threadCount();
+
+    ///
+    /// \brief setThreadCount - Function sets count of worker threads. Jobs that wait for execution are kept.
+    /// \param threadCount - Count of worker threads, '0' to use count of cores.
+    ///
+    void setThreadCount(const qint32 threadCount);
+
+    ///
+    /// \brief submit - Function submits job without any ordering guarantees.
+    /// \param job - Job that will be executed in one of worker threads.
+    ///
+    void submit(Job job);
+
+    ///
+    /// \brief submit - Function submits job in ordered queue.
+    /// \param queue - Queue that keeps order of jobs.
+    /// \param job - Job that will be executed after all jobs that were submitted before in this queue.
+    ///
+    void submit(const RenderQueuePtr& queue, Job job);
+
+private:
+    PWLottieRenderScheduler() { }
+
+    ///
+    /// \brief The Worker struct - Worker thread with it's own deque of jobs.
+    ///
+    struct Worker {
+        QMutex mutex;
+        std::deque<Job> jobs;
+        std::unique_ptr<QThread> thread;
+    };
+
+    /*************/
+    /* Functions */
+    /*************/
+
+    ///
+    /// \brief startWorkers - Function starts worker threads, must be called under write lock.
+    ///
+    void startWorkers();
+
+    ///
+    /// \brief stopWorkers - Function stops and joins worker threads.
+    /// \param cancelJobs - Whether jobs that weren't executed are dropped, otherwise they stay in workers deques for the next workers.
+    ///
+    void stopWorkers(const bool cancelJobs);
+
+    ///
+    /// \brief runWorker - Main loop of worker thread.
+    /// \param workerIndex - Index of worker.
+    ///
+    void runWorker(const qint32 workerIndex);
+
+    ///
+    /// \brief takeJob - Takes job from worker's own deque or steals it from another worker.
+    /// \param workerIndex - Index of worker that takes job.
+    /// \param job - Taken job.
+    /// \return Returns true if job was taken.
+    ///
+    bool takeJob(const qint32 workerIndex, Job& job);
+
+    ///
+    /// \brief drainQueue - Runs first job of ordered queue and schedules next one.
+    /// \param queue - Queue that will be drained.
+    ///
+    void drainQueue(const RenderQueuePtr& queue);
+
+    /*************/
+    /* Variables */
+    /*************/
+
+    std::atomic<qint32> m_threadCount = 0;
+
+    QReadWriteLock m_workersLock;
+    std::vector<std::unique_ptr<Worker>> m_workers;
+
+    QMutex m_sleepMutex;
+    QWaitCondition m_wakeCondition;
+
+    std::atomic<qint32> m_pendingJobs = 0;
+    std::atomic<quint32> m_nextWorker = 0;
+    std::atomic<bool> m_stopping = false;
+};
+
+#endif // PWLOTTIERENDERSCHEDULER_H
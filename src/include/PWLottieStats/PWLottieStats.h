@@ -0,0 +1,230 @@
+/*
+ * Copyright (C) PrivateWeb Software (https://github.com/PrivateWebSoftware) - All Rights Reserved
+ *
+ * Licensed under the Apache License 2.0 (the "License"). You may not use
+ * this file except in compliance with the License. You can obtain a copy
+ * in the file LICENSE in the source distribution
+ *
+ * Written by PrivateWeb Software <privatewebsoftware@protonmail.com>, October 2026
+ */
+
+#ifndef PWLOTTIESTATS_H
+#define PWLOTTIESTATS_H
+
+#include <QJSEngine>
+#include <QList>
+#include <QObject>
+#include <QQmlEngine>
+#include <QString>
+#include <QVariantMap>
+
+#include <array>
+#include <atomic>
+
+#include "include/PWLottieControllers/PWLottieAbstractController.h"
+
+class PWLottieItem;
+
+///
+/// \brief The PWLottieTimeStats struct - Average, 95th percentile and maximum of time samples in milliseconds.
+///
+struct PWLottieTimeStats {
+    qreal average = 0.0;
+    qreal p95 = 0.0;
+    qreal max = 0.0;
+};
+
+///
+/// \brief The PWLottieTimeSamples class - The latest time samples of item, older samples are overwritten.
+///
+class PWLottieTimeSamples {
+
+#define timeSamplesCount 128
+
+public:
+    ///
+    /// \brief add - Function adds time sample.
+    /// \param time - Time in nanoseconds.
+    ///
+    inline void add(const qint64 time)
+    {
+        m_samples[m_nextSample] = time;
+        m_nextSample = (m_nextSample + 1) % timeSamplesCount;
+        m_count = qMin(m_count + 1, timeSamplesCount);
+    }
+
+    ///
+    /// \brief append - Function appends samples to list, it's used to merge samples of all items.
+    /// \param samples - List of samples.
+    ///
+    void append(QList<qint64>& samples) const;
+
+    ///
+    /// \brief timeStats - Function calculates stats of the given samples.
+    /// \param samples - Samples in nanoseconds.
+    /// \return Returns stats in milliseconds.
+    ///
+    [[nodiscard]] static PWLottieTimeStats timeStats(QList<qint64> samples);
+
+private:
+    std::array<qint64, timeSamplesCount> m_samples = {};
+    qint32 m_nextSample = 0;
+    qint32 m_count = 0;
+};
+
+///
+/// \brief The PWLottieItemStats struct - Snapshot of counters of one lottie item.
+///
+struct PWLottieItemStats {
+    PWLottieHandle lottieHandle = -1;
+    QString source;
+
+    qint32 frameRate = 0;
+    qreal renderScale = 1.0;
+    bool running = false;
+    bool culled = false;
+
+    PWLottieTimeStats renderTime;
+    PWLottieTimeStats schedulingLatency;
+
+    quint64 renderedFrames = 0;
+    quint64 droppedFrames = 0;
+    quint64 skippedFrames = 0;
+    quint64 coalescedFrames = 0;
+    quint64 cancelledFrames = 0;
+
+    qint64 bufferBytes = 0;
+};
+
+///
+/// \brief The PWLottieStatsSnapshot struct - Snapshot of counters of all lottie items and caches.
+///
+struct PWLottieStatsSnapshot {
+    QList<PWLottieItemStats> items = {};
+
+    qint32 runningItems = 0;
+    qint32 culledItems = 0;
+    qreal averageFrameRate = 0.0;
+
+    PWLottieTimeStats renderTime;
+    PWLottieTimeStats schedulingLatency;
+
+    quint64 renderedFrames = 0;
+    quint64 droppedFrames = 0;
+    quint64 skippedFrames = 0;
+    quint64 coalescedFrames = 0;
+    quint64 cancelledFrames = 0;
+
+    qint64 itemBufferBytes = 0;
+    qint64 frameCacheBytes = 0;
+    qint64 spriteSheetBytes = 0;
+    qint64 modelCacheBytes = 0;
+    qint64 bufferPoolBytes = 0;
+    qint64 bufferPoolPeakBytes = 0;
+    quint64 bufferPoolLimitHits = 0;
+
+    quint64 frameCacheHits = 0;
+    quint64 frameCacheMisses = 0;
+    quint64 modelCacheHits = 0;
+    quint64 modelCacheMisses = 0;
+};
+
+///
+/// \brief The PWLottieStats class - Runtime performance counters of lottie items.
+///
+/// Counters of frames and caches are always kept, they are plain increments. Timing samples are taken only
+/// while stats are enabled, disabled stats cost one relaxed atomic load per frame. If library is built
+/// with 'PWLOTTIE_STATS' option turned off, stats can't be enabled and timing code is removed by compiler.
+///
+class PWLottieStats : public QObject {
+    Q_OBJECT
+    QML_ELEMENT
+    QML_SINGLETON
+    Q_MOC_INCLUDE("include/PWLottieItem/PWLottieItem.h")
+
+    Q_PROPERTY(bool enabled READ enabled WRITE setEnabled NOTIFY enabledChanged)
+
+public:
+    /*************/
+    /* Functions */
+    /*************/
+
+    ///
+    /// \brief instance - Singleton instance funtion, cause we need only one stats object for hole application.
+    /// \return Instance to PWLottieStats class.
+    ///
+    static PWLottieStats* instance();
+
+    ///
+    /// \brief create - Function that is used by QML engine to get singleton instance.
+    /// \return Instance to PWLottieStats class.
+    ///
+    static PWLottieStats* create(QQmlEngine* qmlEngine, QJSEngine* jsEngine);
+
+    ///
+    /// \brief isEnabled - Function checks if timing samples are taken, it's called by items on every frame.
+    /// \return Returns true if stats are enabled.
+    ///
+    [[nodiscard]] static inline bool isEnabled()
+    {
+#ifdef PWLOTTIE_NO_STATS
+        return false;
+#else
+        return m_enabled.load(std::memory_order_relaxed);
+#endif
+    }
+
+    ///
+    /// \brief timestamp - Function gets monotonic time that is shared by all threads.
+    /// \return Returns time in nanoseconds.
+    ///
+    [[nodiscard]] static qint64 timestamp();
+
+    ///
+    /// \brief snapshot - Function collects counters of all items and caches, must be called from GUI thread.
+    /// \return Returns snapshot of counters.
+    ///
+    [[nodiscard]] static PWLottieStatsSnapshot snapshot();
+
+    ///
+    /// \brief snapshotMap - Function collects counters of all items and caches for QML.
+    /// \return Returns snapshot as JS object.
+    ///
+    Q_INVOKABLE QVariantMap snapshotMap() const;
+
+    ///
+    /// \brief itemStatsMap - Function collects counters of one item for QML.
+    /// \param lottieItem - Lottie item.
+    /// \return Returns counters as JS object, it's empty if item is null.
+    ///
+    Q_INVOKABLE QVariantMap itemStatsMap(PWLottieItem* lottieItem) const;
+
+    /**************/
+    /* Properties */
+    /**************/
+
+    [[nodiscard]] inline bool enabled() const
+    {
+        return isEnabled();
+    }
+
+    ///
+    /// \brief setEnabled - Function enables or disables timing samples.
+    /// \param enabled - Whether stats are enabled.
+    ///
+    void setEnabled(const bool enabled);
+
+signals:
+    void enabledChanged();
+
+private:
+    explicit PWLottieStats(QObject* parent = nullptr);
+
+    /*************/
+    /* Variables */
+    /*************/
+
+    inline static std::atomic<bool> m_enabled = false;
+};
+
+#endif // PWLOTTIESTATS_H
@@ -0,0 +1,220 @@
+/*
+ * Copyright (C) PrivateWeb Software (https://github.com/PrivateWebSoftware) - All Rights Reserved
+ *
+ * Licensed under the Apache License 2.0 (the "License"). You may not use
+ * this file except in compliance with the License. You can obtain a copy
+ * in the file LICENSE in the source distribution
+ *
+ * Written by PrivateWeb Software <privatewebsoftware@protonmail.com>, October 2026
+ */
+
+#ifndef PWLOTTIETRACE_H
+#define PWLOTTIETRACE_H
+
+#include <QByteArray>
+#include <QJSEngine>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QObject>
+#include <QQmlEngine>
+#include <QString>
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "include/PWLottieControllers/PWLottieAbstractController.h"
+#include "include/PWLottieStats/PWLottieStats.h"
+
+///
+/// \brief The PWLottieTraceEvent struct - Timestamped span or instant event, name must be string literal.
+///
+struct PWLottieTraceEvent {
+    const char* name = nullptr;
+    qint64 start = 0;
+    qint64 duration = -1;
+    PWLottieHandle lottieHandle = -1;
+    qint64 value = -1;
+};
+
+///
+/// \brief The PWLottieTrace class - Opt-in tracing of loading, rendering, uploading and framerate changes.
+///
+/// Every thread records events in it's own ring buffer without any locks, the oldest events are overwritten
+/// when ring is full. Events are dumped as Chrome trace JSON, that can be opened in Perfetto or 'chrome://tracing'.
+/// If 'PWLOTTIE_TRACE' environment variable is set, tracing is enabled at start and trace is written
+/// to the file from variable when application quits.
+///
+class PWLottieTrace : public QObject {
+    Q_OBJECT
+    QML_ELEMENT
+    QML_SINGLETON
+
+    Q_PROPERTY(bool enabled READ enabled WRITE setEnabled NOTIFY enabledChanged)
+
+#define traceRingCapacity 16384
+
+public:
+    ///
+    /// \brief The Span class - Records span from it's creation to it's destruction, if tracing is enabled.
+    ///
+    class Span {
+    public:
+        inline Span(const char* name, const PWLottieHandle lottieHandle = -1, const qint64 value = -1)
+            : m_name(name)
+            , m_lottieHandle(lottieHandle)
+            , m_value(value)
+            , m_start(isEnabled() ? PWLottieStats::timestamp() : -1)
+        {
+        }
+
+        inline ~Span()
+        {
+            if (m_start >= 0) {
+                PWLottieTrace::record({ m_name, m_start, PWLottieStats::timestamp() - m_start, m_lottieHandle, m_value });
+            }
+        }
+
+        Span(const Span&) = delete;
+        Span& operator=(const Span&) = delete;
+
+    private:
+        const char* m_name;
+        PWLottieHandle m_lottieHandle;
+        qint64 m_value;
+        qint64 m_start;
+    };
+
+    /*************/
+    /* Functions */
+    /*************/
+
+    ///
+    /// \brief instance - Singleton instance funtion, cause we need only one trace for hole application.
+    /// \return Instance to PWLottieTrace class.
+    ///
+    static PWLottieTrace* instance();
+
+    ///
+    /// \brief create - Function that is used by QML engine to get singleton instance.
+    /// \return Instance to PWLottieTrace class.
+    ///
+    static PWLottieTrace* create(QQmlEngine* qmlEngine, QJSEngine* jsEngine);
+
+    ///
+    /// \brief isEnabled - Function checks if events are recorded.
+    /// \return Returns true if tracing is enabled.
+    ///
+    [[nodiscard]] static inline bool isEnabled()
+    {
+#ifdef PWLOTTIE_NO_STATS
+        return false;
+#else
+        return m_enabled.load(std::memory_order_relaxed);
+#endif
+    }
+
+    ///
+    /// \brief record - Function records event in ring of current thread.
+    /// \param traceEvent - Recorded event.
+    ///
+    static void record(const PWLottieTraceEvent& traceEvent);
+
+    ///
+    /// \brief span - Function records span that started before, like time that job waited in queue.
+    /// \param name - Name of span, must be string literal.
+    /// \param start - Start of span from PWLottieStats::timestamp().
+    /// \param lottieHandle - Handle of item.
+    ///
+    static inline void span(const char* name, const qint64 start, const PWLottieHandle lottieHandle = -1)
+    {
+        if (isEnabled() && start >= 0) {
+            record({ name, start, PWLottieStats::timestamp() - start, lottieHandle });
+        }
+    }
+
+    ///
+    /// \brief instant - Function records instant event.
+    /// \param name - Name of event, must be string literal.
+    /// \param lottieHandle - Handle of item.
+    /// \param value - Value of event.
+    ///
+    static inline void instant(const char* name, const PWLottieHandle lottieHandle = -1, const qint64 value = -1)
+    {
+        if (isEnabled()) {
+            record({ name, PWLottieStats::timestamp(), -1, lottieHandle, value });
+        }
+    }
+
+    ///
+    /// \brief toJson - Function collects recorded events of all threads.
+    /// \return Returns Chrome trace JSON.
+    ///
+    [[nodiscard]] QByteArray toJson();
+
+    ///
+    /// \brief dump - Function writes recorded events of all threads in file.
+    /// \param filePath - Path of trace file.
+    /// \return Returns true if file was written.
+    ///
+    Q_INVOKABLE bool dump(const QString& filePath);
+
+    ///
+    /// \brief clear - Function removes all recorded events.
+    ///
+    Q_INVOKABLE void clear();
+
+    /**************/
+    /* Properties */
+    /**************/
+
+    [[nodiscard]] inline bool enabled() const
+    {
+        return isEnabled();
+    }
+
+    ///
+    /// \brief setEnabled - Function enables or disables recording of events.
+    /// \param enabled - Whether tracing is enabled.
+    ///
+    void setEnabled(const bool enabled);
+
+signals:
+    void enabledChanged();
+
+private:
+    explicit PWLottieTrace(QObject* parent = nullptr);
+
+    ///
+    /// \brief The TraceRing struct - Ring of events of one thread, only that thread writes in it.
+    ///
+    struct TraceRing {
+        qint32 threadId = 0;
+        QString threadName;
+        std::array<PWLottieTraceEvent, traceRingCapacity> events = {};
+        std::atomic<quint64> writeIndex = 0;
+        std::atomic<quint64> clearIndex = 0;
+    };
+
+    /*************/
+    /* Functions */
+    /*************/
+
+    ///
+    /// \brief threadRing - Function gets ring of current thread, it's created on the first event of thread.
+    /// \return Returns ring of current thread.
+    ///
+    [[nodiscard]] TraceRing* threadRing();
+
+    /*************/
+    /* Variables */
+    /*************/
+
+    QMutex m_mutex;
+    std::vector<std::unique_ptr<TraceRing>> m_rings = {};
+
+    static std::atomic<bool> m_enabled;
+};
+
+#endif // PWLOTTIETRACE_H
@@ -9,36 +9,126 @@
  */
 
 #include "include/PWControllerMediator/PWControllerMediator.h"
+#include "include/PWLottieItem/PWLottieItem.h"
+#include "include/PWLottieTrace/PWLottieTrace.h"
+
+#include <tuple>
 
 PWControllerMediator::PWControllerMediator(QObject* parent)
     : QObject { parent }
 {
-    /* Register all needed controllers signals in constructor */
-    connect(&m_lottieBasicController, &PWLottieBaseController::fpsChanged, this, [=](const quint16 fps, const QString& lottieUuid) {
-        emit instance()->fpsChanged(fps, PWControllerMediator::BaseController, lottieUuid);
+    /* Register all needed controllers signals in constructor, items are notified directly by their handles */
+    connect(&m_lottieBasicController, &PWLottieBaseController::fpsChanged, this, [=](const quint16 fps, const PWLottieHandle lottieHandle) {
+        notifyFrameRate(PWControllerMediator::BaseController, fps, lottieHandle);
+    });
+
+    connect(&m_lottieIconController, &PWLottieIconController::fpsChanged, this, [=](const quint16 fps, const PWLottieHandle lottieHandle) {
+        notifyFrameRate(PWControllerMediator::IconController, fps, lottieHandle);
+    });
+
+    connect(&m_lottieAdaptiveController, &PWLottieAdaptiveController::fpsChanged, this, [=](const quint16 fps, const PWLottieHandle lottieHandle) {
+        notifyFrameRate(PWControllerMediator::AdaptiveController, fps, lottieHandle);
     });
 
-    connect(&m_lottieIconController, &PWLottieIconController::fpsChanged, this, [=](const quint16 fps, const QString& lottieUuid) {
-        emit instance()->fpsChanged(fps, PWControllerMediator::BaseController, lottieUuid);
+    connect(&m_lottieBudgetController, &PWLottieBudgetController::fpsChanged, this, [=](const quint16 fps, const PWLottieHandle lottieHandle) {
+        notifyFrameRate(PWControllerMediator::BudgetController, fps, lottieHandle);
     });
 }
 
+///
+/// \brief PWControllerMediator::registerLottieItem - Registers lottie item in registry, it's handle is used by controllers instead of item.
+/// \param lottieItem - Lottie item that will be registered.
+/// \return Returns handle of lottie item, it stays valid until item is unregistered.
+///
+PWLottieHandle PWControllerMediator::registerLottieItem(PWLottieItem* lottieItem)
+{
+    /* Controllers signals are connected when mediator is created */
+    std::ignore = instance();
+
+    if (!m_freeHandles.isEmpty()) {
+        const PWLottieHandle lottieHandle = m_freeHandles.takeLast();
+        m_registry[lottieHandle] = { lottieItem };
+
+        return lottieHandle;
+    }
+
+    m_registry.append({ lottieItem });
+
+    return PWLottieHandle(m_registry.count() - 1);
+}
+
+///
+/// \brief PWControllerMediator::unregisterLottieItem - Unregisters lottie item from registry and from it's controller, handle can be reused after it.
+/// \param lottieHandle - Handle of lottie item.
+///
+void PWControllerMediator::unregisterLottieItem(const PWLottieHandle lottieHandle)
+{
+    if (lottieHandle < 0 || lottieHandle >= m_registry.count() || !m_registry.at(lottieHandle).lottieItem) {
+        return;
+    }
+
+    unregisterLottieAnimation(m_registry.at(lottieHandle).controllerType, lottieHandle);
+
+    m_registry[lottieHandle] = {};
+    m_freeHandles.append(lottieHandle);
+}
+
+///
+/// \brief PWControllerMediator::lottieItems - Function gets all registered lottie items.
+/// \return Returns list of items, that are alive now.
+///
+QList<PWLottieItem*> PWControllerMediator::lottieItems()
+{
+    QList<PWLottieItem*> lottieItems;
+    lottieItems.reserve(m_registry.count() - m_freeHandles.count());
+
+    for (const RegistryEntry& registryEntry : std::as_const(m_registry)) {
+        if (registryEntry.lottieItem) {
+            lottieItems.append(registryEntry.lottieItem);
+        }
+    }
+
+    return lottieItems;
+}
+
 ///
 /// \brief PWControllerMediator::registerLottieAnimation - Registers lottie item in control system.
 /// \param controllerType - Controller type, that will register lottie item in it's own system.
-/// \param lottieUuid - Unique lottie item ID with that ID lottie item will be registered.
+/// \param lottieItemInfo - Handle with that lottie item will be registered, it's size and priority.
 /// \return Returns current fps of registred lotti animation.
 ///
-quint16 PWControllerMediator::registerLottieAnimation(const ControllerType controllerType, const QString& lottieUuid)
+quint16 PWControllerMediator::registerLottieAnimation(const ControllerType controllerType, const PWLottieItemInfo& lottieItemInfo)
 {
-    /* Register lottie item in controller */
-    if (controllerType == ControllerType::BaseController) {
-        return m_lottieBasicController.addLottieItem(lottieUuid);
-    } else if (controllerType == ControllerType::IconController) {
-        return m_lottieIconController.addLottieItem(lottieUuid);
+    PWLottieAbstractController* const lottieController = controller(controllerType);
+    const PWLottieHandle lottieHandle = lottieItemInfo.lottieHandle;
+
+    if (!lottieController || lottieHandle < 0 || lottieHandle >= m_registry.count()) {
+        return m_standardFps;
     }
 
-    return m_standardFps;
+    /* Item can be registered only in one controller */
+    unregisterLottieAnimation(m_registry.at(lottieHandle).controllerType, lottieHandle);
+
+    QList<PWLottieHandle>& controllerHandles = m_controllerHandles[controllerType];
+
+    m_registry[lottieHandle].controllerType = controllerType;
+    m_registry[lottieHandle].controllerIndex = controllerHandles.count();
+    controllerHandles.append(lottieHandle);
+
+    /* Register lottie item in controller */
+    return lottieController->addLottieItem(lottieItemInfo);
+}
+
+///
+/// \brief PWControllerMediator::updateLottieAnimation - Updates size and priority of lottie item in control system.
+/// \param controllerType - Controller type, in which lottie item is registered.
+/// \param lottieItemInfo - Handle of lottie item, it's size and priority.
+///
+void PWControllerMediator::updateLottieAnimation(const ControllerType controllerType, const PWLottieItemInfo& lottieItemInfo)
+{
+    if (PWLottieAbstractController* const lottieController = controller(controllerType)) {
+        lottieController->updateLottieItem(lottieItemInfo);
+    }
 }
 
 ///
@@ -46,14 +136,93 @@ quint16 PWControllerMediator::registerLottieAnimation(const ControllerType contr
 /// \attention unregisterLottieAnimation() must be always run if "registerLottieAnimation" was used before PWLottieItem delted.
 ///
 /// \param controllerType - Controller type, that will register lottie item in it's own system.
-/// \param lottieUuid- Unique lottie item ID with that ID lottie item will be unregistered.
+/// \param lottieHandle - Handle of lottie item that will be unregistered.
+///
+void PWControllerMediator::unregisterLottieAnimation(const ControllerType controllerType, const PWLottieHandle lottieHandle)
+{
+    PWLottieAbstractController* const lottieController = controller(controllerType);
+
+    if (!lottieController || lottieHandle < 0 || lottieHandle >= m_registry.count() || m_registry.at(lottieHandle).controllerType != controllerType) {
+        return;
+    }
+
+    /* Remove handle from controller's items in O(1): the last handle takes it's place */
+    QList<PWLottieHandle>& controllerHandles = m_controllerHandles[controllerType];
+    const qsizetype controllerIndex = m_registry.at(lottieHandle).controllerIndex;
+    const PWLottieHandle lastHandle = controllerHandles.takeLast();
+
+    if (lastHandle != lottieHandle) {
+        controllerHandles[controllerIndex] = lastHandle;
+        m_registry[lastHandle].controllerIndex = controllerIndex;
+    }
+
+    m_registry[lottieHandle].controllerType = ControllerType::NoController;
+    m_registry[lottieHandle].controllerIndex = -1;
+
+    /* Remove lottie with it's handle from from controller */
+    lottieController->removeLottieItem(lottieHandle);
+}
+
+///
+/// \brief PWControllerMediator::reportRenderTime - Reports time of rendered frame of lottie item to it's controller.
+/// \param controllerType - Controller type, in which lottie item is registered.
+/// \param lottieHandle - Handle of lottie item.
+/// \param renderTime - Time of rendering in nanoseconds.
 ///
-void PWControllerMediator::unregisterLottieAnimation(const ControllerType controllerType, const QString& lottieUuid)
+void PWControllerMediator::reportRenderTime(const ControllerType controllerType, const PWLottieHandle lottieHandle, const qint64 renderTime)
 {
-    /* Remove lottie with it's UUID from from controller */
-    if (controllerType == PWControllerMediator::ControllerType::BaseController) {
-        m_lottieBasicController.removeLottieItem(lottieUuid);
-    } else if (controllerType == PWControllerMediator::ControllerType::IconController) {
-        m_lottieIconController.removeLottieItem(lottieUuid);
+    if (PWLottieAbstractController* const lottieController = controller(controllerType)) {
+        lottieController->reportRenderTime(lottieHandle, renderTime);
+    }
+}
+
+///
+/// \brief PWControllerMediator::controller - Function gets controller of controller type.
+/// \param controllerType - Controller type.
+/// \return Returns controller or nullptr for 'NoController'.
+///
+PWLottieAbstractController* PWControllerMediator::controller(const ControllerType controllerType)
+{
+    if (controllerType == ControllerType::BaseController) {
+        return &m_lottieBasicController;
+    } else if (controllerType == ControllerType::IconController) {
+        return &m_lottieIconController;
+    } else if (controllerType == ControllerType::AdaptiveController) {
+        return &m_lottieAdaptiveController;
+    } else if (controllerType == ControllerType::BudgetController) {
+        return &m_lottieBudgetController;
+    }
+
+    return nullptr;
+}
+
+///
+/// \brief PWControllerMediator::notifyFrameRate - Function sets framerate that controller calculated in one lottie item or in all items of controller.
+/// \param controllerType - Controller type that calculated framerate.
+/// \param fps - Framerate.
+/// \param lottieHandle - Handle of lottie item or 'allLottiesHandle'.
+///
+void PWControllerMediator::notifyFrameRate(const ControllerType controllerType, const quint16 fps, const PWLottieHandle lottieHandle)
+{
+    if (lottieHandle == allLottiesHandle) {
+        /* Only items of this controller are notified, list is copied because item can change it's controller while being notified */
+        const QList<PWLottieHandle> controllerHandles = m_controllerHandles[controllerType];
+
+        for (const PWLottieHandle controllerHandle : controllerHandles) {
+            if (m_registry.at(controllerHandle).controllerType == controllerType) {
+                PWLottieTrace::instant("fpsChanged", controllerHandle, fps);
+
+                m_registry.at(controllerHandle).lottieItem->setFrameRate(fps);
+            }
+        }
+
+        return;
+    }
+
+    /* Framerate of one item is changed without touching other items */
+    if (lottieHandle >= 0 && lottieHandle < m_registry.count() && m_registry.at(lottieHandle).controllerType == controllerType) {
+        PWLottieTrace::instant("fpsChanged", lottieHandle, fps);
+
+        m_registry.at(lottieHandle).lottieItem->setFrameRate(fps);
     }
 }
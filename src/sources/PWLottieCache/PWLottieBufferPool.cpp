@@ -0,0 +1,243 @@
+/*
+ * Copyright (C) PrivateWeb Software (https://github.com/PrivateWebSoftware) - All Rights Reserved
+ *
+ * Licensed under the Apache License 2.0 (the "License"). You may not use
+ * this file except in compliance with the License. You can obtain a copy
+ * in the file LICENSE in the source distribution
+ *
+ * Written by PrivateWeb Software <privatewebsoftware@protonmail.com>, October 2026
+ */
+
+#include "include/PWLottieCache/PWLottieBufferPool.h"
+
+#include <QtMath>
+
+#include <new>
+
+#define minBufferSizeClass 4096
+
+///
+/// \brief PWLottieBufferPool::instance - Singleton instance funtion, cause we need only one buffer pool for hole application.
+/// \return Instance to PWLottieBufferPool class.
+///
+PWLottieBufferPool* PWLottieBufferPool::instance()
+{
+    /* Pool is never destroyed, images can give their buffers back even while application exits */
+    static PWLottieBufferPool* bufferPool = new PWLottieBufferPool;
+
+    return bufferPool;
+}
+
+///
+/// \brief PWLottieBufferPool::image - Function gets image with pooled buffer, it's content is undefined.
+/// \attention Function is thread-safe and can be called from render workers.
+///
+/// \param size - Size of image.
+/// \param format - Format of image with 4 bytes per pixel.
+/// \return Returns image, that gives it's buffer back to pool when it's destroyed.
+///
+QImage PWLottieBufferPool::image(const QSize& size, const QImage::Format format)
+{
+    if (size.isEmpty()) {
+        return QImage();
+    }
+
+    const qsizetype bytesPerLine = qsizetype(size.width()) * 4;
+    const qsizetype bufferSize = sizeClass(bytesPerLine * size.height());
+
+    uchar* buffer = nullptr;
+
+    {
+        QMutexLocker locker(&m_mutex);
+
+        std::vector<uchar*>& freeBuffers = m_freeBuffers[bufferSize];
+
+        if (!freeBuffers.empty()) {
+            buffer = freeBuffers.back();
+            freeBuffers.pop_back();
+
+            m_freeMemory -= bufferSize;
+            m_reuses += 1;
+        } else {
+            /* New buffer makes room for itself from free buffers of other sizes, retention limit can be crossed only by used buffers */
+            trimFreeBuffers(qMin(m_retentionLimit, m_memoryLimit) - bufferSize);
+
+            /* Pool never grows over it's cap, image gets plain buffer that is freed with it */
+            if (m_memoryUsage + bufferSize > m_memoryLimit) {
+                m_limitHits += 1;
+                locker.unlock();
+
+                return QImage(size, format);
+            }
+
+            buffer = static_cast<uchar*>(::operator new(bufferSize, std::align_val_t(bufferAlignment)));
+
+            m_bufferSizes.insert(buffer, bufferSize);
+            m_memoryUsage += bufferSize;
+            m_peakMemoryUsage = qMax(m_peakMemoryUsage, m_memoryUsage);
+            m_allocations += 1;
+        }
+    }
+
+    return QImage(buffer, size.width(), size.height(), bytesPerLine, format, &PWLottieBufferPool::releaseBuffer, buffer);
+}
+
+///
+/// \brief PWLottieBufferPool::clear - Function frees all buffers that aren't used now.
+///
+void PWLottieBufferPool::clear()
+{
+    QMutexLocker locker(&m_mutex);
+
+    trimFreeBuffers(0);
+}
+
+qint64 PWLottieBufferPool::retentionLimit()
+{
+    QMutexLocker locker(&m_mutex);
+
+    return m_retentionLimit;
+}
+
+///
+/// \brief PWLottieBufferPool::setRetentionLimit - Function sets memory above which released buffers are freed instead of kept, it doesn't limit used buffers.
+/// \param retentionLimit - Retention limit in bytes.
+///
+void PWLottieBufferPool::setRetentionLimit(const qint64 retentionLimit)
+{
+    QMutexLocker locker(&m_mutex);
+
+    m_retentionLimit = qMax<qint64>(0, retentionLimit);
+    trimFreeBuffers(m_retentionLimit);
+}
+
+qint64 PWLottieBufferPool::memoryLimit()
+{
+    QMutexLocker locker(&m_mutex);
+
+    return m_memoryLimit;
+}
+
+///
+/// \brief PWLottieBufferPool::setMemoryLimit - Function sets cap of pool memory, images over it get buffers outside of pool.
+/// \param memoryLimit - Memory limit in bytes.
+///
+void PWLottieBufferPool::setMemoryLimit(const qint64 memoryLimit)
+{
+    QMutexLocker locker(&m_mutex);
+
+    /* Used buffers stay valid, pool gets under new limit as they are released */
+    m_memoryLimit = qMax<qint64>(0, memoryLimit);
+    trimFreeBuffers(m_memoryLimit);
+}
+
+///
+/// \brief PWLottieBufferPool::memoryUsage - Function gets memory of all buffers, that are used or kept free.
+/// \return Returns memory in bytes.
+///
+qint64 PWLottieBufferPool::memoryUsage()
+{
+    QMutexLocker locker(&m_mutex);
+
+    return m_memoryUsage;
+}
+
+qint64 PWLottieBufferPool::peakMemoryUsage()
+{
+    QMutexLocker locker(&m_mutex);
+
+    return m_peakMemoryUsage;
+}
+
+qint64 PWLottieBufferPool::freeMemory()
+{
+    QMutexLocker locker(&m_mutex);
+
+    return m_freeMemory;
+}
+
+quint64 PWLottieBufferPool::reuses()
+{
+    QMutexLocker locker(&m_mutex);
+
+    return m_reuses;
+}
+
+quint64 PWLottieBufferPool::allocations()
+{
+    QMutexLocker locker(&m_mutex);
+
+    return m_allocations;
+}
+
+quint64 PWLottieBufferPool::limitHits()
+{
+    QMutexLocker locker(&m_mutex);
+
+    return m_limitHits;
+}
+
+///
+/// \brief PWLottieBufferPool::sizeClass - Function gets size class of buffer that fits the given size.
+/// \param bytes - Needed size in bytes.
+/// \return Returns size of buffer in bytes.
+///
+qsizetype PWLottieBufferPool::sizeClass(const qsizetype bytes)
+{
+    if (bytes <= minBufferSizeClass) {
+        return minBufferSizeClass;
+    }
+
+    /* Every power of two is split in four classes */
+    const qsizetype powerOfTwo = qsizetype(qNextPowerOfTwo(quint64(bytes)) >> 1);
+    const qsizetype classStep = powerOfTwo / 4;
+
+    return (bytes + classStep - 1) / classStep * classStep;
+}
+
+///
+/// \brief PWLottieBufferPool::releaseBuffer - Function is called by QImage when the last copy of image is destroyed.
+/// \param buffer - Buffer of image.
+///
+void PWLottieBufferPool::releaseBuffer(void* buffer)
+{
+    PWLottieBufferPool* const bufferPool = instance();
+    uchar* const releasedBuffer = static_cast<uchar*>(buffer);
+
+    QMutexLocker locker(&bufferPool->m_mutex);
+
+    const qsizetype bufferSize = bufferPool->m_bufferSizes.value(releasedBuffer);
+
+    /* Buffer is kept for the next image of the same size class only if pool fits in both limits */
+    if (bufferPool->m_memoryUsage <= qMin(bufferPool->m_retentionLimit, bufferPool->m_memoryLimit)) {
+        bufferPool->m_freeBuffers[bufferSize].push_back(releasedBuffer);
+        bufferPool->m_freeMemory += bufferSize;
+
+        return;
+    }
+
+    bufferPool->m_bufferSizes.remove(releasedBuffer);
+    bufferPool->m_memoryUsage -= bufferSize;
+
+    ::operator delete(releasedBuffer, std::align_val_t(bufferAlignment));
+}
+
+///
+/// \brief PWLottieBufferPool::trimFreeBuffers - Function frees free buffers until pool fits in the given memory, must be called under lock.
+/// \param memoryLimit - Memory that can stay used after trimming.
+///
+void PWLottieBufferPool::trimFreeBuffers(const qint64 memoryLimit)
+{
+    for (auto freeBuffers = m_freeBuffers.begin(); freeBuffers != m_freeBuffers.end() && m_memoryUsage > memoryLimit; ++freeBuffers) {
+        while (!freeBuffers->empty() && m_memoryUsage > memoryLimit) {
+            uchar* const freeBuffer = freeBuffers->back();
+            freeBuffers->pop_back();
+
+            m_bufferSizes.remove(freeBuffer);
+            m_memoryUsage -= freeBuffers.key();
+            m_freeMemory -= freeBuffers.key();
+
+            ::operator delete(freeBuffer, std::align_val_t(bufferAlignment));
+        }
+    }
+}
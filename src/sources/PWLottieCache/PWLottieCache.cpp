@@ -0,0 +1,465 @@
+/*
+ * Copyright (C) PrivateWeb Software (https://github.com/PrivateWebSoftware) - All Rights Reserved
+ *
+ * Licensed under the Apache License 2.0 (the "License"). You may not use
+ * this file except in compliance with the License. You can obtain a copy
+ * in the file LICENSE in the source distribution
+ *
+ * Written by PrivateWeb Software <privatewebsoftware@protonmail.com>, October 2026
+ */
+
+#include "include/PWLottieCache/PWLottieCache.h"
+#include "include/PWLottieCache/PWLottieCompiledAsset.h"
+#include "include/PWLottieCache/PWLottieSourceReader.h"
+#include "include/PWLottieRenderScheduler/PWLottieRenderScheduler.h"
+#include "include/PWLottieTrace/PWLottieTrace.h"
+
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDebug>
+#include <QFileInfo>
+#include <QThread>
+
+#include <tuple>
+
+PWLottieCache::PWLottieCache(QObject* parent)
+    : QObject { parent }
+{
+    /* Parsed compositions are owned only by models, so memory budget of cache covers all of them */
+    rlottie::configureModelCacheSize(0);
+
+    m_sourceTimer.start();
+}
+
+///
+/// \brief PWLottieCache::instance - Singleton instance funtion, cause we need only one cache for hole application.
+/// \return Instance to PWLottieCache class.
+///
+PWLottieCache* PWLottieCache::instance()
+{
+    /* Cache can be requested from render workers first, so it's moved to main thread to be used in QML */
+    static PWLottieCache* cache = []() {
+        PWLottieCache* lottieCache = new PWLottieCache;
+
+        if (QCoreApplication::instance()) {
+            lottieCache->moveToThread(QCoreApplication::instance()->thread());
+        }
+
+        return lottieCache;
+    }();
+
+    return cache;
+}
+
+///
+/// \brief PWLottieCache::create - Function that is used by QML engine to get singleton instance.
+/// \return Instance to PWLottieCache class.
+///
+PWLottieCache* PWLottieCache::create(QQmlEngine* qmlEngine, QJSEngine* jsEngine)
+{
+    Q_UNUSED(qmlEngine)
+    Q_UNUSED(jsEngine)
+
+    /* Cache is used by items in C++, so QML engine must not delete it */
+    QJSEngine::setObjectOwnership(instance(), QJSEngine::CppOwnership);
+
+    return instance();
+}
+
+///
+/// \brief PWLottieCache::model - Function gets model of lottie animation, it's loaded and parsed only if it isn't cached yet.
+/// \attention Function is thread-safe and can be called from render workers.
+///
+/// \param source - Source of lottie animation.
+/// \param progressCallback - Callback that is called from loading thread with progress from '0.0' to '1.0'.
+/// \return Returns shared model or nullptr if source can't be loaded.
+///
+std::shared_ptr<const PWLottieModel> PWLottieCache::model(const QString& source, const std::function<void(qreal)>& progressCallback)
+{
+    QString loadedSource;
+    const QString key = resolvedSourceKey(source, loadedSource);
+
+    {
+        QMutexLocker locker(&m_mutex);
+
+        /* The same source is loaded by another thread, wait for it instead of parsing it twice */
+        while (m_loadingSources.contains(key)) {
+            m_loadFinished.wait(&m_mutex);
+        }
+
+        /* Source was loaded before and it's file wasn't changed, so model is returned without any I/O */
+        if (m_sourceHashes.contains(key)) {
+            if (std::shared_ptr<const PWLottieModel> model = findModel(m_sourceHashes.value(key))) {
+                m_hits += 1;
+
+                return model;
+            }
+        }
+
+        m_loadingSources.insert(key);
+    }
+
+    std::shared_ptr<const PWLottieModel> model = loadModel(loadedSource, key, progressCallback);
+
+    {
+        QMutexLocker locker(&m_mutex);
+
+        m_loadingSources.remove(key);
+        m_loadFinished.wakeAll();
+    }
+
+    notifyMemoryUsageChanged();
+
+    return model;
+}
+
+///
+/// \brief PWLottieCache::cachedModel - Function gets model of lottie animation only if it's already cached, it never does I/O.
+/// \param source - Source of lottie animation.
+/// \return Returns shared model or nullptr if it isn't cached.
+///
+std::shared_ptr<const PWLottieModel> PWLottieCache::cachedModel(const QString& source)
+{
+    QString loadedSource;
+    const QString key = resolvedSourceKey(source, loadedSource);
+
+    QMutexLocker locker(&m_mutex);
+
+    if (!m_sourceHashes.contains(key)) {
+        return nullptr;
+    }
+
+    std::shared_ptr<const PWLottieModel> model = findModel(m_sourceHashes.value(key));
+
+    if (model) {
+        m_hits += 1;
+    }
+
+    return model;
+}
+
+///
+/// \brief PWLottieCache::loadModel - Function reads and parses source and puts it's model in cache.
+/// \param source - Source of lottie animation.
+/// \param key - Key of source file.
+/// \param progressCallback - Callback that gets progress of loading.
+/// \return Returns shared model or nullptr if source can't be loaded.
+///
+std::shared_ptr<const PWLottieModel> PWLottieCache::loadModel(const QString& source, const QString& key, const std::function<void(qreal)>& progressCallback)
+{
+    QByteArray contentHash;
+    std::string jsonData;
+    QList<qint32> canonicalFrames;
+
+    /* Compiled asset is mapped and already has it's hash and holds, JSON is read and hashed */
+    if (PWLottieCompiledAsset::isCompiledSource(source)) {
+        PWLottieTrace::Span readSpan("mapCompiledAsset");
+
+        PWLottieCompiledAsset compiledAsset;
+        if (!compiledAsset.open(source)) {
+            qWarning() << "Couldn't open compiled lottie asset:" << source;
+
+            return nullptr;
+        }
+
+        contentHash = compiledAsset.contentHash();
+        jsonData = compiledAsset.jsonData();
+        canonicalFrames = compiledAsset.canonicalFrames();
+
+        if (progressCallback) {
+            progressCallback(0.5);
+        }
+    } else {
+        {
+            PWLottieTrace::Span readSpan("readSource");
+
+            /* Source is mapped, compressed sources are inflated straight into JSON that is given to rlottie */
+            if (!PWLottieSourceReader::read(source, jsonData, progressCallback)) {
+                return nullptr;
+            }
+        }
+
+        contentHash = QCryptographicHash::hash(QByteArrayView(jsonData.data(), qsizetype(jsonData.size())), QCryptographicHash::Sha1);
+    }
+
+    /* The same content can be already loaded from another path */
+    {
+        QMutexLocker locker(&m_mutex);
+
+        if (std::shared_ptr<const PWLottieModel> model = findModel(contentHash)) {
+            m_sourceHashes.insert(key, contentHash);
+            m_hits += 1;
+
+            return model;
+        }
+    }
+
+    /* Parse lottie animation without lock, so other sources are loaded in parallel */
+    std::shared_ptr<PWLottieModel> model;
+    {
+        PWLottieTrace::Span parseSpan("parse");
+
+        model = PWLottieModel::loadFromData(source, contentHash, std::move(jsonData), PWLottieSourceReader::resourcePath(source));
+    }
+
+    if (!model) {
+        qWarning() << "Couldn't parse lottie file:" << source;
+
+        return nullptr;
+    }
+
+    /* Holds of compiled asset were found at build time */
+    const bool framesAnalysed = !canonicalFrames.isEmpty() && model->setCanonicalFrames(std::move(canonicalFrames));
+
+    QMutexLocker locker(&m_mutex);
+
+    /* Model with the same content could be loaded from another path at the same time */
+    if (std::shared_ptr<const PWLottieModel> cachedModel = findModel(contentHash)) {
+        m_sourceHashes.insert(key, contentHash);
+        m_hits += 1;
+
+        return cachedModel;
+    }
+
+    m_misses += 1;
+
+    m_sourceHashes.insert(key, contentHash);
+    m_cacheEntries.insert(contentHash, { model, ++m_useCounter });
+    m_memoryUsage += model->byteCost();
+
+    evictModels(m_memoryBudget);
+
+    if (framesAnalysed || !m_frameAnalysis) {
+        return model;
+    }
+
+    /* Frames are analysed once per content, items play model right away and use the result when it's ready */
+    PWLottieRenderScheduler::instance()->submit([model]() {
+        PWLottieTrace::Span analyseSpan("analyseFrames", -1, model->totalFrames());
+
+        model->analyseFrames();
+    });
+
+    return model;
+}
+
+///
+/// \brief PWLottieCache::preload - Function loads lottie animations in background, so items are created without any I/O and parsing.
+/// \param sources - Sources of lottie animations.
+///
+void PWLottieCache::preload(const QStringList& sources)
+{
+    for (const QString& source : sources) {
+        PWLottieRenderScheduler::instance()->submit([this, source]() {
+            /* Model stays in cache, so items get it later without loading */
+            std::ignore = model(source);
+        });
+    }
+}
+
+///
+/// \brief PWLottieCache::clear - Function removes all models that aren't used by items now.
+///
+void PWLottieCache::clear()
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        evictModels(0);
+    }
+
+    notifyMemoryUsageChanged();
+}
+
+qint64 PWLottieCache::memoryBudget()
+{
+    QMutexLocker locker(&m_mutex);
+
+    return m_memoryBudget;
+}
+
+///
+/// \brief PWLottieCache::setMemoryBudget - Function sets memory that cache can use, unused models are evicted if it's exceeded.
+/// \param memoryBudget - Memory budget in bytes.
+///
+void PWLottieCache::setMemoryBudget(const qint64 memoryBudget)
+{
+    {
+        QMutexLocker locker(&m_mutex);
+
+        m_memoryBudget = qMax<qint64>(0, memoryBudget);
+        evictModels(m_memoryBudget);
+    }
+
+    emit memoryBudgetChanged();
+    notifyMemoryUsageChanged();
+}
+
+qint64 PWLottieCache::memoryUsage()
+{
+    QMutexLocker locker(&m_mutex);
+
+    return m_memoryUsage;
+}
+
+bool PWLottieCache::frameAnalysis()
+{
+    QMutexLocker locker(&m_mutex);
+
+    return m_frameAnalysis;
+}
+
+///
+/// \brief PWLottieCache::setFrameAnalysis - Function sets if holds of models, that are loaded after it, are found in background.
+/// \param frameAnalysis - Tools that render only few frames of every animation disable it.
+///
+void PWLottieCache::setFrameAnalysis(const bool frameAnalysis)
+{
+    QMutexLocker locker(&m_mutex);
+
+    m_frameAnalysis = frameAnalysis;
+}
+
+quint64 PWLottieCache::hits()
+{
+    QMutexLocker locker(&m_mutex);
+
+    return m_hits;
+}
+
+quint64 PWLottieCache::misses()
+{
+    QMutexLocker locker(&m_mutex);
+
+    return m_misses;
+}
+
+///
+/// \brief PWLottieCache::sourceKey - Function gets key of source file, that changes if file is changed.
+/// \param source - Source of lottie animation.
+/// \return Returns canonical path with size and modification time of file.
+///
+QString PWLottieCache::sourceKey(const QString& source)
+{
+    const QFileInfo sourceInfo(source);
+    const QString canonicalPath = sourceInfo.canonicalFilePath();
+
+    return QStringLiteral("%1|%2|%3").arg(canonicalPath.isEmpty() ? sourceInfo.absoluteFilePath() : canonicalPath).arg(sourceInfo.size()).arg(sourceInfo.lastModified().toMSecsSinceEpoch());
+}
+
+///
+/// \brief PWLottieCache::resolveSource - Function replaces lottie JSON with it's compiled asset, if it was added by 'pwlottie_add_precompiled_assets'.
+/// \param source - Source of lottie animation.
+/// \return Returns path of compiled asset or the given source.
+///
+QString PWLottieCache::resolveSource(const QString& source)
+{
+    const QString compiledSource = PWLottieCompiledAsset::compiledSource(source);
+
+    return compiledSource.isEmpty() ? source : compiledSource;
+}
+
+///
+/// \brief PWLottieCache::resolvedSourceKey - Function gets loaded source and it's key, they are checked on disk only once in a while.
+/// \param source - Source of lottie animation.
+/// \param loadedSource - Compiled asset or the given source.
+/// \return Returns key of loaded source.
+///
+QString PWLottieCache::resolvedSourceKey(const QString& source, QString& loadedSource)
+{
+    const qint64 currentTime = m_sourceTimer.elapsed();
+
+    /* Every delegate asks for it's source, so files aren't canonicalised and checked again for each of them */
+    {
+        QMutexLocker locker(&m_mutex);
+
+        const auto sourceEntry = m_sourceEntries.constFind(source);
+
+        /* Qt resources never change, files are checked again after a short interval */
+        if (sourceEntry != m_sourceEntries.constEnd() && (source.startsWith(':') || currentTime - sourceEntry->checkTime < sourceCheckInterval)) {
+            loadedSource = sourceEntry->loadedSource;
+
+            return sourceEntry->key;
+        }
+    }
+
+    loadedSource = resolveSource(source);
+    const QString key = sourceKey(loadedSource);
+
+    QMutexLocker locker(&m_mutex);
+    m_sourceEntries.insert(source, { loadedSource, key, currentTime });
+
+    return key;
+}
+
+///
+/// \brief PWLottieCache::notifyMemoryUsageChanged - Function emits change of memory usage in thread of cache, it can be called from render workers.
+///
+void PWLottieCache::notifyMemoryUsageChanged()
+{
+    if (QThread::currentThread() == thread()) {
+        emit memoryUsageChanged();
+
+        return;
+    }
+
+    QMetaObject::invokeMethod(
+        this, [this]() {
+            emit memoryUsageChanged();
+        },
+        Qt::QueuedConnection);
+}
+
+///
+/// \brief PWLottieCache::findModel - Function finds model by it's content hash, must be called under lock.
+/// \param contentHash - Hash of lottie JSON.
+/// \return Returns model or nullptr if it isn't cached.
+///
+std::shared_ptr<const PWLottieModel> PWLottieCache::findModel(const QByteArray& contentHash)
+{
+    const auto cacheEntry = m_cacheEntries.find(contentHash);
+
+    if (cacheEntry == m_cacheEntries.end()) {
+        return nullptr;
+    }
+
+    cacheEntry->lastUse = ++m_useCounter;
+
+    return cacheEntry->model;
+}
+
+///
+/// \brief PWLottieCache::evictModels - Function evicts least recently used models that aren't used by items, must be called under lock.
+/// \param memoryBudget - Memory that can stay used after eviction.
+///
+void PWLottieCache::evictModels(const qint64 memoryBudget)
+{
+    while (m_memoryUsage > memoryBudget) {
+        /* Models that are used by items can't be evicted, they are shared anyway */
+        auto leastRecentlyUsed = m_cacheEntries.end();
+
+        for (auto cacheEntry = m_cacheEntries.begin(); cacheEntry != m_cacheEntries.end(); ++cacheEntry) {
+            if (cacheEntry->model.use_count() == 1 && (leastRecentlyUsed == m_cacheEntries.end() || cacheEntry->lastUse < leastRecentlyUsed->lastUse)) {
+                leastRecentlyUsed = cacheEntry;
+            }
+        }
+
+        if (leastRecentlyUsed == m_cacheEntries.end()) {
+            return;
+        }
+
+        const QByteArray contentHash = leastRecentlyUsed.key();
+
+        m_memoryUsage -= leastRecentlyUsed->model->byteCost();
+        m_cacheEntries.erase(leastRecentlyUsed);
+
+        m_sourceHashes.removeIf([&contentHash](const QHash<QString, QByteArray>::iterator sourceHash) {
+            return sourceHash.value() == contentHash;
+        });
+    }
+
+    /* Sources of evicted models are checked on disk again when they are loaded next time */
+    m_sourceEntries.removeIf([this](const QHash<QString, SourceEntry>::iterator sourceEntry) {
+        return !m_sourceHashes.contains(sourceEntry->key) && !m_loadingSources.contains(sourceEntry->key);
+    });
+}
@@ -0,0 +1,380 @@
+/*
+ * Copyright (C) PrivateWeb Software (https://github.com/PrivateWebSoftware) - All Rights Reserved
+ *
+ * Licensed under the Apache License 2.0 (the "License"). You may not use
+ * this file except in compliance with the License. You can obtain a copy
+ * in the file LICENSE in the source distribution
+ *
+ * Written by PrivateWeb Software <privatewebsoftware@protonmail.com>, October 2026
+ */
+
+#include "include/PWLottieCache/PWLottieCompiledAsset.h"
+#include "include/PWLottieCache/PWLottieModel.h"
+
+#include <QCryptographicHash>
+#include <QFileInfo>
+#include <QImage>
+#include <QJsonDocument>
+#include <QtEndian>
+
+#include <cmath>
+#include <cstring>
+
+///
+/// \brief quantiseNumber - Function rounds fractional number token of JSON.
+/// \param number - Number token as it's written in JSON.
+/// \param precision - Count of decimals that are kept.
+/// \return Returns shortest token of rounded number.
+///
+static QByteArray quantiseNumber(const QByteArray& number, const qint32 precision)
+{
+    /* Integers are kept as they are, frames and indexes must not change */
+    if (!number.contains('.') && !number.contains('e') && !number.contains('E')) {
+        return number;
+    }
+
+    const double scale = std::pow(10.0, precision);
+    const double roundedNumber = std::round(number.toDouble() * scale) / scale;
+
+    if (roundedNumber == 0.0) {
+        return "0";
+    }
+
+    QByteArray quantisedNumber = QByteArray::number(roundedNumber, 'f', precision);
+
+    if (quantisedNumber.contains('.')) {
+        while (quantisedNumber.endsWith('0')) {
+            quantisedNumber.chop(1);
+        }
+
+        if (quantisedNumber.endsWith('.')) {
+            quantisedNumber.chop(1);
+        }
+    }
+
+    return quantisedNumber;
+}
+
+///
+/// \brief minifyJson - Function strips whitespaces of valid JSON and rounds it's fractional numbers.
+/// \param jsonData - Valid JSON data.
+/// \param precision - Count of decimals that are kept in numbers.
+/// \return Returns minified JSON.
+///
+static QByteArray minifyJson(const QByteArray& jsonData, const qint32 precision)
+{
+    /*
+     * JSON is rewritten token by token instead of going through QJsonDocument, cause QJsonObject
+     * sorts keys and rlottie needs keys like "ty" of shapes before the others. Strings are copied
+     * as they are, so keys, order of members and embedded images never change.
+     */
+    QByteArray minifiedJson;
+    minifiedJson.reserve(jsonData.size());
+
+    const char* const data = jsonData.constData();
+    const qsizetype size = jsonData.size();
+
+    for (qsizetype index = 0; index < size;) {
+        const char character = data[index];
+
+        if (character == '"') {
+            const qsizetype stringStart = index++;
+
+            while (index < size && data[index] != '"') {
+                index += data[index] == '\\' ? 2 : 1;
+            }
+
+            index = qMin(index + 1, size);
+            minifiedJson.append(data + stringStart, index - stringStart);
+        } else if (character == '-' || (character >= '0' && character <= '9')) {
+            const qsizetype numberStart = index;
+
+            while (index < size && (data[index] == '+' || data[index] == '-' || data[index] == '.' || data[index] == 'e' || data[index] == 'E' || (data[index] >= '0' && data[index] <= '9'))) {
+                ++index;
+            }
+
+            minifiedJson.append(quantiseNumber(QByteArray(data + numberStart, index - numberStart), precision));
+        } else {
+            if (character != ' ' && character != '\t' && character != '\n' && character != '\r') {
+                minifiedJson.append(character);
+            }
+
+            ++index;
+        }
+    }
+
+    return minifiedJson;
+}
+
+///
+/// \brief compareModels - Function renders few frames of both models and compares them.
+/// \param model - Model of source JSON.
+/// \param compiledModel - Model of minified JSON.
+/// \param error - Description of difference if models don't look the same.
+/// \return Returns true if all compared frames look the same.
+///
+static bool compareModels(const PWLottieModel& model, const PWLottieModel& compiledModel, QString& error)
+{
+    if (model.totalFrames() != compiledModel.totalFrames() || model.defaultSize() != compiledModel.defaultSize()) {
+        error = QString("Compiled animation has different frames or size");
+
+        return false;
+    }
+
+    const QSize defaultSize = model.defaultSize();
+    const QSize compareSize = defaultSize.boundedTo(defaultSize.scaled(compiledAssetCompareSide, compiledAssetCompareSide, Qt::KeepAspectRatio));
+
+    if (compareSize.isEmpty()) {
+        return true;
+    }
+
+    QImage frameImage(compareSize, QImage::Format_ARGB32_Premultiplied);
+    QImage compiledFrameImage(compareSize, QImage::Format_ARGB32_Premultiplied);
+
+    /* Rounded numbers can move antialiased edges a bit, but lost or reordered members change whole shapes */
+    const qint64 maxDifferentPixels = qint64(compareSize.width()) * compareSize.height() * compiledAssetMaxDifferentPixelsPerMille / 1000;
+    const qint32 lastFrame = model.totalFrames() - 1;
+
+    for (qint32 compareIndex = 0; compareIndex < compiledAssetCompareFrames; ++compareIndex) {
+        const qint32 frame = lastFrame * compareIndex / (compiledAssetCompareFrames - 1);
+
+        model.render(frame, rlottie::Surface(reinterpret_cast<uint32_t*>(frameImage.bits()), compareSize.width(), compareSize.height(), frameImage.bytesPerLine()));
+        compiledModel.render(frame, rlottie::Surface(reinterpret_cast<uint32_t*>(compiledFrameImage.bits()), compareSize.width(), compareSize.height(), compiledFrameImage.bytesPerLine()));
+
+        qint64 differentPixels = 0;
+
+        for (qint32 y = 0; y < compareSize.height(); ++y) {
+            const uchar* line = frameImage.constScanLine(y);
+            const uchar* compiledLine = compiledFrameImage.constScanLine(y);
+
+            for (qint32 x = 0; x < compareSize.width() * 4; x += 4) {
+                for (qint32 channel = 0; channel < 4; ++channel) {
+                    if (qAbs(qint32(line[x + channel]) - qint32(compiledLine[x + channel])) > compiledAssetMaxChannelDifference) {
+                        differentPixels += 1;
+
+                        break;
+                    }
+                }
+            }
+        }
+
+        if (differentPixels > maxDifferentPixels) {
+            error = QString("Compiled animation looks different at frame %1, %2 of %3 pixels differ").arg(frame).arg(differentPixels).arg(qint64(compareSize.width()) * compareSize.height());
+
+            return false;
+        }
+    }
+
+    return true;
+}
+
+///
+/// \brief PWLottieCompiledAsset::compile - Function validates lottie JSON and compiles it, it's used by 'pwlottie-compile' tool.
+/// \param jsonData - Lottie JSON data.
+/// \param resourcePath - Path where images of animation are located.
+/// \param precision - Count of decimals that are kept in numbers.
+/// \param error - Description of error if animation isn't valid.
+/// \return Returns compiled asset or empty data if animation isn't valid.
+///
+QByteArray PWLottieCompiledAsset::compile(const QByteArray& jsonData, const QString& resourcePath, const qint32 precision, QString& error)
+{
+    /* Document is parsed only to validate JSON, it's never written back */
+    QJsonParseError parseError;
+    const QJsonDocument document = QJsonDocument::fromJson(jsonData, &parseError);
+
+    if (!document.isObject()) {
+        error = parseError.error != QJsonParseError::NoError ? parseError.errorString() : QString("Root of lottie JSON isn't object");
+
+        return {};
+    }
+
+    std::shared_ptr<PWLottieModel> sourceModel = PWLottieModel::loadFromData(QString(), QCryptographicHash::hash(jsonData, QCryptographicHash::Sha1), jsonData.toStdString(), resourcePath.toStdString());
+
+    if (!sourceModel || sourceModel->totalFrames() <= 0) {
+        error = QString("rlottie couldn't load animation");
+
+        return {};
+    }
+
+    /* Minified JSON with short numbers is smaller and is parsed faster by rlottie */
+    const QByteArray minifiedJson = minifyJson(jsonData, qBound(0, precision, 6));
+    const QByteArray contentHash = QCryptographicHash::hash(minifiedJson, QCryptographicHash::Sha1);
+
+    std::shared_ptr<PWLottieModel> model = PWLottieModel::loadFromData(QString(), contentHash, minifiedJson.toStdString(), resourcePath.toStdString());
+
+    if (!model) {
+        error = QString("rlottie couldn't load compiled animation");
+
+        return {};
+    }
+
+    /* Build fails when compiled animation doesn't look like the source one */
+    if (!compareModels(*sourceModel, *model, error)) {
+        return {};
+    }
+
+    /* Holds are found once at build time instead of every launch */
+    model->analyseFrames();
+
+    const QList<qint32> canonicalFrames = model->canonicalFrames();
+
+    QByteArray compiledAsset(compiledAssetHeaderSize + canonicalFrames.size() * 4 + minifiedJson.size(), Qt::Uninitialized);
+    uchar* data = reinterpret_cast<uchar*>(compiledAsset.data());
+
+    std::memcpy(data, compiledAssetMagic, 4);
+    qToLittleEndian<quint32>(compiledAssetVersion, data + 4);
+    qToLittleEndian<quint32>(quint32(canonicalFrames.size()), data + 8);
+    qToLittleEndian<quint32>(quint32(minifiedJson.size()), data + 12);
+    std::memcpy(data + 16, contentHash.constData(), compiledAssetHashSize);
+
+    /* Hash of source lets runtime notice JSON that was changed after it was compiled */
+    std::memcpy(data + 16 + compiledAssetHashSize, QCryptographicHash::hash(jsonData, QCryptographicHash::Sha1).constData(), compiledAssetHashSize);
+
+    data += compiledAssetHeaderSize;
+
+    for (const qint32 canonicalFrame : canonicalFrames) {
+        qToLittleEndian<qint32>(canonicalFrame, data);
+        data += 4;
+    }
+
+    std::memcpy(data, minifiedJson.constData(), minifiedJson.size());
+
+    return compiledAsset;
+}
+
+///
+/// \brief PWLottieCompiledAsset::compiledSource - Function gets path of compiled asset that is placed next to lottie JSON and was compiled from it.
+/// \param source - Source of lottie animation.
+/// \return Returns path of compiled asset or empty string if it doesn't exist or is stale.
+///
+QString PWLottieCompiledAsset::compiledSource(const QString& source)
+{
+    if (isCompiledSource(source)) {
+        return source;
+    }
+
+    const QFileInfo sourceInfo(source);
+    const QString compiledPath = sourceInfo.path() + "/" + sourceInfo.completeBaseName() + "." + compiledAssetSuffix;
+
+    if (!QFileInfo::exists(compiledPath)) {
+        return QString();
+    }
+
+    /* Asset of another version or asset that wasn't compiled from this JSON is ignored, JSON is loaded instead */
+    PWLottieCompiledAsset compiledAsset;
+
+    if (!compiledAsset.open(compiledPath) || !compiledAsset.isCompiledFrom(source)) {
+        return QString();
+    }
+
+    return compiledPath;
+}
+
+///
+/// \brief PWLottieCompiledAsset::isCompiledSource - Function checks if source is compiled asset by it's suffix.
+/// \param source - Source of lottie animation.
+/// \return Returns true if source has compiled asset suffix.
+///
+bool PWLottieCompiledAsset::isCompiledSource(const QString& source)
+{
+    return source.endsWith("." compiledAssetSuffix, Qt::CaseInsensitive);
+}
+
+///
+/// \brief PWLottieCompiledAsset::open - Function maps compiled asset and validates it's header.
+/// \param filePath - Path of compiled asset.
+/// \return Returns true if asset can be used.
+///
+bool PWLottieCompiledAsset::open(const QString& filePath)
+{
+    m_file.setFileName(filePath);
+
+    if (!m_file.open(QFile::ReadOnly)) {
+        return false;
+    }
+
+    m_size = m_file.size();
+    m_data = m_file.map(0, m_size);
+
+    /* Compressed resources can't be mapped, they are read instead */
+    if (!m_data) {
+        m_buffer = m_file.readAll();
+        m_data = reinterpret_cast<const uchar*>(m_buffer.constData());
+        m_size = m_buffer.size();
+    }
+
+    if (m_size < compiledAssetHeaderSize || std::memcmp(m_data, compiledAssetMagic, 4) != 0) {
+        return false;
+    }
+
+    /* Assets of other versions are rejected, so source falls back to JSON */
+    if (qFromLittleEndian<quint32>(m_data + 4) != compiledAssetVersion) {
+        return false;
+    }
+
+    m_totalFrames = qint32(qFromLittleEndian<quint32>(m_data + 8));
+    m_jsonSize = qFromLittleEndian<quint32>(m_data + 12);
+    m_jsonOffset = compiledAssetHeaderSize + qint64(m_totalFrames) * 4;
+    m_contentHash = QByteArray(reinterpret_cast<const char*>(m_data + 16), compiledAssetHashSize);
+    m_sourceHash = QByteArray(reinterpret_cast<const char*>(m_data + 16 + compiledAssetHashSize), compiledAssetHashSize);
+
+    return m_totalFrames >= 0 && m_jsonSize > 0 && m_jsonOffset + m_jsonSize <= m_size;
+}
+
+///
+/// \brief PWLottieCompiledAsset::isCompiledFrom - Function checks if asset was compiled from the current content of source.
+/// \param source - Source lottie JSON.
+/// \return Returns true if asset isn't stale.
+///
+bool PWLottieCompiledAsset::isCompiledFrom(const QString& source) const
+{
+    /* Asset that is shipped without it's JSON is the only source of animation */
+    if (!QFileInfo::exists(source)) {
+        return true;
+    }
+
+    /* Resources are compiled together with their assets by 'pwlottie_add_precompiled_assets' and never change */
+    if (source.startsWith(':')) {
+        return true;
+    }
+
+    /* JSON on disk can be edited without compiling it again, so it's content is hashed, key of source keeps result for a while */
+    QFile sourceFile(source);
+
+    if (!sourceFile.open(QFile::ReadOnly)) {
+        return false;
+    }
+
+    QCryptographicHash sourceHash(QCryptographicHash::Sha1);
+
+    if (!sourceHash.addData(&sourceFile)) {
+        return false;
+    }
+
+    return sourceHash.result() == m_sourceHash;
+}
+
+///
+/// \brief PWLottieCompiledAsset::jsonData - Function copies JSON out of mapped asset, rlottie takes it only as string.
+/// \return Returns minified lottie JSON.
+///
+std::string PWLottieCompiledAsset::jsonData() const
+{
+    return std::string(reinterpret_cast<const char*>(m_data + m_jsonOffset), size_t(m_jsonSize));
+}
+
+///
+/// \brief PWLottieCompiledAsset::canonicalFrames - Function gets frames of holds, that were found at build time.
+/// \return Returns canonical frame of every frame.
+///
+QList<qint32> PWLottieCompiledAsset::canonicalFrames() const
+{
+    QList<qint32> canonicalFrames;
+    canonicalFrames.reserve(m_totalFrames);
+
+    for (qint32 frame = 0; frame < m_totalFrames; ++frame) {
+        canonicalFrames.append(qFromLittleEndian<qint32>(m_data + compiledAssetHeaderSize + frame * 4));
+    }
+
+    return canonicalFrames;
+}
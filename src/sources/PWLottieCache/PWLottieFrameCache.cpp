@@ -0,0 +1,201 @@
+/*
+ * Copyright (C) PrivateWeb Software (https://github.com/PrivateWebSoftware) - All Rights Reserved
+ *
+ * Licensed under the Apache License 2.0 (the "License"). You may not use
+ * this file except in compliance with the License. You can obtain a copy
+ * in the file LICENSE in the source distribution
+ *
+ * Written by PrivateWeb Software <privatewebsoftware@protonmail.com>, October 2026
+ */
+
+#include "include/PWLottieCache/PWLottieFrameCache.h"
+
+///
+/// \brief PWLottieFrameCache::instance - Singleton instance funtion, cause we need only one frame cache for hole application.
+/// \return Instance to PWLottieFrameCache class.
+///
+PWLottieFrameCache* PWLottieFrameCache::instance()
+{
+    static PWLottieFrameCache frameCache;
+
+    return &frameCache;
+}
+
+///
+/// \brief PWLottieFrameCache::addUser - Function registers item that shows model in the given size.
+/// \param contentHash - Content hash of model.
+/// \param size - Size in which model is rendered.
+/// \param format - Pixel format of frames.
+///
+void PWLottieFrameCache::addUser(const QByteArray& contentHash, const QSize& size, const QImage::Format format)
+{
+    QMutexLocker locker(&m_mutex);
+
+    m_users[{ contentHash, size, -1, format }] += 1;
+}
+
+///
+/// \brief PWLottieFrameCache::removeUser - Function unregisters item that showed model in the given size, it's frames are dropped if it was the last user.
+/// \param contentHash - Content hash of model.
+/// \param size - Size in which model was rendered.
+/// \param format - Pixel format of frames.
+///
+void PWLottieFrameCache::removeUser(const QByteArray& contentHash, const QSize& size, const QImage::Format format)
+{
+    QMutexLocker locker(&m_mutex);
+
+    const PWLottieFrameKey usersKey = { contentHash, size, -1, format };
+    const auto users = m_users.find(usersKey);
+
+    if (users == m_users.end()) {
+        return;
+    }
+
+    if (--users.value() > 0) {
+        return;
+    }
+
+    m_users.erase(users);
+
+    /* Nobody shows this model in this size anymore, so it's frames won't be reused */
+    for (auto cacheEntry = m_cacheEntries.begin(); cacheEntry != m_cacheEntries.end();) {
+        if (cacheEntry.key().size == size && cacheEntry.key().format == format && cacheEntry.key().contentHash == contentHash) {
+            m_memoryUsage -= cacheEntry->image.sizeInBytes();
+            m_useOrder.erase(cacheEntry->usePosition);
+
+            cacheEntry = m_cacheEntries.erase(cacheEntry);
+        } else {
+            ++cacheEntry;
+        }
+    }
+}
+
+///
+/// \brief PWLottieFrameCache::isShared - Function checks if frames of model in the given size are needed by several items.
+/// \param contentHash - Content hash of model.
+/// \param size - Size in which model is rendered.
+/// \param format - Pixel format of frames.
+/// \return Returns true if frames should be taken from cache.
+///
+bool PWLottieFrameCache::isShared(const QByteArray& contentHash, const QSize& size, const QImage::Format format)
+{
+    QMutexLocker locker(&m_mutex);
+
+    /* Single item renders in it's own frame images, caching it's frames would only cost memory */
+    return m_memoryBudget > 0 && m_users.value({ contentHash, size, -1, format }) > 1;
+}
+
+///
+/// \brief PWLottieFrameCache::frame - Function gets cached frame or renders it. If frame is rendering by another thread, function waits for it.
+/// \attention Function is thread-safe and is called from render workers.
+///
+/// \param frameKey - Key of frame.
+/// \param renderFrame - Function that renders frame, it's called only if frame isn't cached.
+/// \return Returns rendered frame, it must not be modified.
+///
+QImage PWLottieFrameCache::frame(const PWLottieFrameKey& frameKey, const std::function<QImage()>& renderFrame)
+{
+    {
+        QMutexLocker locker(&m_mutex);
+
+        /* The first item that needs frame renders it, others wait and reuse it */
+        while (m_renderingFrames.contains(frameKey)) {
+            m_frameRendered.wait(&m_mutex);
+        }
+
+        const auto cacheEntry = m_cacheEntries.find(frameKey);
+
+        if (cacheEntry != m_cacheEntries.end()) {
+            m_useOrder.splice(m_useOrder.end(), m_useOrder, cacheEntry->usePosition);
+            m_hits += 1;
+
+            return cacheEntry->image;
+        }
+
+        m_renderingFrames.insert(frameKey);
+        m_misses += 1;
+    }
+
+    const QImage image = renderFrame();
+
+    QMutexLocker locker(&m_mutex);
+
+    m_renderingFrames.remove(frameKey);
+    m_frameRendered.wakeAll();
+
+    if (!image.isNull() && image.sizeInBytes() <= m_memoryBudget && m_users.contains({ frameKey.contentHash, frameKey.size, -1, frameKey.format })) {
+        m_useOrder.push_back(frameKey);
+        m_cacheEntries.insert(frameKey, { image, std::prev(m_useOrder.end()) });
+        m_memoryUsage += image.sizeInBytes();
+
+        evictFrames(m_memoryBudget);
+    }
+
+    return image;
+}
+
+///
+/// \brief PWLottieFrameCache::clear - Function removes all cached frames.
+///
+void PWLottieFrameCache::clear()
+{
+    QMutexLocker locker(&m_mutex);
+
+    evictFrames(0);
+}
+
+qint64 PWLottieFrameCache::memoryBudget()
+{
+    QMutexLocker locker(&m_mutex);
+
+    return m_memoryBudget;
+}
+
+///
+/// \brief PWLottieFrameCache::setMemoryBudget - Function sets memory that cached frames can use, '0' disables frame sharing.
+/// \param memoryBudget - Memory budget in bytes.
+///
+void PWLottieFrameCache::setMemoryBudget(const qint64 memoryBudget)
+{
+    QMutexLocker locker(&m_mutex);
+
+    m_memoryBudget = qMax<qint64>(0, memoryBudget);
+    evictFrames(m_memoryBudget);
+}
+
+qint64 PWLottieFrameCache::memoryUsage()
+{
+    QMutexLocker locker(&m_mutex);
+
+    return m_memoryUsage;
+}
+
+quint64 PWLottieFrameCache::hits()
+{
+    QMutexLocker locker(&m_mutex);
+
+    return m_hits;
+}
+
+quint64 PWLottieFrameCache::misses()
+{
+    QMutexLocker locker(&m_mutex);
+
+    return m_misses;
+}
+
+///
+/// \brief PWLottieFrameCache::evictFrames - Function evicts least recently used frames, must be called under lock.
+/// \param memoryBudget - Memory that can stay used after eviction.
+///
+void PWLottieFrameCache::evictFrames(const qint64 memoryBudget)
+{
+    /* Items keep their own references to shown frames, so evicted pixels stay valid for them */
+    while (m_memoryUsage > memoryBudget && !m_useOrder.empty()) {
+        const auto cacheEntry = m_cacheEntries.find(m_useOrder.front());
+
+        m_memoryUsage -= cacheEntry->image.sizeInBytes();
+        m_cacheEntries.erase(cacheEntry);
+        m_useOrder.pop_front();
+    }
+}
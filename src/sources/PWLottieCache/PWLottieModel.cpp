@@ -0,0 +1,195 @@
+/*
+ * Copyright (C) PrivateWeb Software (https://github.com/PrivateWebSoftware) - All Rights Reserved
+ *
+ * Licensed under the Apache License 2.0 (the "License"). You may not use
+ * this file except in compliance with the License. You can obtain a copy
+ * in the file LICENSE in the source distribution
+ *
+ * Written by PrivateWeb Software <privatewebsoftware@protonmail.com>, October 2026
+ */
+
+#include "include/PWLottieCache/PWLottieModel.h"
+#include "include/PWLottieCache/PWLottieBufferPool.h"
+
+#include <QImage>
+
+#include <cstring>
+
+///
+/// NOTE: rlottie doesn't report memory of parsed composition, it usually
+///       takes about twice as much memory as JSON it was parsed from.
+///
+#define parsedModelCostFactor 2
+
+PWLottieModel::PWLottieModel(const QString& source, const QByteArray& contentHash, const qint64 jsonSize, std::unique_ptr<rlottie::Animation>&& animation)
+    : m_source(source)
+    , m_contentHash(contentHash)
+    , m_animation(std::move(animation))
+{
+    /* Set up lottie animation properties */
+    m_totalFrames = qint32(m_animation->totalFrame());
+    m_frameRate = m_animation->frameRate();
+    m_duration = m_animation->duration();
+
+    size_t width = 0;
+    size_t height = 0;
+    m_animation->size(width, height);
+    m_defaultSize = QSize(qint32(width), qint32(height));
+
+    m_byteCost = jsonSize * parsedModelCostFactor;
+}
+
+///
+/// \brief PWLottieModel::loadFromData - Function parses lottie JSON and creates model.
+/// \param source - Source of lottie animation.
+/// \param contentHash - Hash of lottie JSON.
+/// \param jsonData - Lottie JSON data, it's moved to rlottie and freed after parsing.
+/// \param resourcePath - Path where images of animation are located.
+/// \return Returns created model or nullptr if data isn't valid lottie animation.
+///
+std::shared_ptr<PWLottieModel> PWLottieModel::loadFromData(const QString& source, const QByteArray& contentHash, std::string&& jsonData, std::string&& resourcePath)
+{
+    if (jsonData.empty()) {
+        return nullptr;
+    }
+
+    const qint64 jsonSize = qint64(jsonData.size());
+
+    /* Composition isn't put in rlottie model cache, model is the only owner of it and frees it when it's evicted */
+    std::unique_ptr<rlottie::Animation> animation = rlottie::Animation::loadFromData(std::move(jsonData), contentHash.toHex().toStdString(), resourcePath, false);
+
+    if (!animation) {
+        return nullptr;
+    }
+
+    return std::make_shared<PWLottieModel>(source, contentHash, jsonSize, std::move(animation));
+}
+
+///
+/// \brief PWLottieModel::render - Function renders frame of model in the given surface.
+/// \attention Function is thread-safe, renders of one model wait for each other.
+///
+/// \param frame - Frame of animation.
+/// \param surface - Surface with pixels and size of frame.
+///
+void PWLottieModel::render(const qint32 frame, const rlottie::Surface& surface) const
+{
+    /* rlottie keeps render tree of the last frame in animation, so it can't render two frames at once */
+    QMutexLocker locker(&m_renderMutex);
+
+    m_animation->renderSync(size_t(frame), surface);
+}
+
+///
+/// \brief PWLottieModel::analyseFrames - Function finds frames that look exactly like the frame before them, it's called once from render worker.
+///
+void PWLottieModel::analyseFrames()
+{
+    if (m_totalFrames <= 0 || m_defaultSize.isEmpty()) {
+        return;
+    }
+
+    /*
+     * Frames are compared by their pixels, so only frames with exactly the same output are mapped to
+     * each other. All frames are compared in reduced size first, but sub-pixel motion can vanish there,
+     * so frames that look the same are confirmed in default size of animation, before they become a hold.
+     */
+    const QSize analysisSize = m_defaultSize.boundedTo(m_defaultSize.scaled(maxFrameAnalysisSide, maxFrameAnalysisSide, Qt::KeepAspectRatio));
+
+    if (analysisSize.isEmpty()) {
+        return;
+    }
+
+    PWLottieBufferPool* const bufferPool = PWLottieBufferPool::instance();
+    QImage frameImages[2] = { bufferPool->image(analysisSize, QImage::Format_ARGB32_Premultiplied), bufferPool->image(analysisSize, QImage::Format_ARGB32_Premultiplied) };
+
+    /* Frames in default size are rendered only for candidates of holds, the previous one is usually reused */
+    QImage defaultFrameImages[2];
+    qint32 defaultFrames[2] = { -1, -1 };
+
+    const auto defaultFrameImage = [this, bufferPool, &defaultFrameImages, &defaultFrames](const qint32 frame) -> const QImage& {
+        QImage& frameImage = defaultFrameImages[frame % 2];
+
+        if (defaultFrames[frame % 2] != frame) {
+            if (frameImage.isNull()) {
+                frameImage = bufferPool->image(m_defaultSize, QImage::Format_ARGB32_Premultiplied);
+            }
+
+            render(frame, rlottie::Surface(reinterpret_cast<uint32_t*>(frameImage.bits()), m_defaultSize.width(), m_defaultSize.height(), frameImage.bytesPerLine()));
+
+            defaultFrames[frame % 2] = frame;
+        }
+
+        return frameImage;
+    };
+
+    QList<qint32> canonicalFrames;
+    canonicalFrames.reserve(m_totalFrames);
+
+    for (qint32 frame = 0; frame < m_totalFrames; ++frame) {
+        QImage& frameImage = frameImages[frame % 2];
+        const QImage& previousFrameImage = frameImages[(frame + 1) % 2];
+
+        /* Animation is locked only for each frame, so items of this model keep rendering while frames are analysed */
+        render(frame, rlottie::Surface(reinterpret_cast<uint32_t*>(frameImage.bits()), analysisSize.width(), analysisSize.height(), frameImage.bytesPerLine()));
+
+        bool hold = frame > 0 && std::memcmp(frameImage.constBits(), previousFrameImage.constBits(), frameImage.sizeInBytes()) == 0;
+
+        if (hold && analysisSize != m_defaultSize) {
+            const QImage& previousDefaultFrameImage = defaultFrameImage(frame - 1);
+            const QImage& currentDefaultFrameImage = defaultFrameImage(frame);
+
+            hold = std::memcmp(currentDefaultFrameImage.constBits(), previousDefaultFrameImage.constBits(), currentDefaultFrameImage.sizeInBytes()) == 0;
+        }
+
+        /* Frame of hold is mapped to the first frame of it, so all of them share one rendered image */
+        canonicalFrames.append(hold ? canonicalFrames.constLast() : frame);
+    }
+
+    m_canonicalFrames = std::move(canonicalFrames);
+    m_framesAnalysed.store(true, std::memory_order_release);
+}
+
+///
+/// \brief PWLottieModel::setCanonicalFrames - Function sets frames of holds that were found before, like in compiled asset, it must be called before model is shared.
+/// \param canonicalFrames - Canonical frame of every frame.
+/// \return Returns true if frames match model and were set.
+///
+bool PWLottieModel::setCanonicalFrames(QList<qint32>&& canonicalFrames)
+{
+    if (canonicalFrames.size() != m_totalFrames) {
+        return false;
+    }
+
+    /* Frame can only be mapped to itself or to a frame before it */
+    for (qint32 frame = 0; frame < m_totalFrames; ++frame) {
+        if (canonicalFrames.at(frame) < 0 || canonicalFrames.at(frame) > frame) {
+            return false;
+        }
+    }
+
+    m_canonicalFrames = std::move(canonicalFrames);
+    m_framesAnalysed.store(true, std::memory_order_release);
+
+    return true;
+}
+
+///
+/// \brief PWLottieModel::canonicalFrame - Function gets the first frame of hold that the given frame belongs to.
+/// \param frame - Frame of animation.
+/// \param renderSize - Size in which frame is rendered.
+/// \return Returns frame with the same image, or the given frame if frames aren't analysed yet.
+///
+qint32 PWLottieModel::canonicalFrame(const qint32 frame, const QSize& renderSize) const
+{
+    if (!isFramesAnalysed() || frame < 0 || frame >= m_canonicalFrames.size()) {
+        return frame;
+    }
+
+    /* Holds are confirmed only in default size, motion that is too small for it can be visible in bigger frames */
+    if (renderSize.width() > m_defaultSize.width() || renderSize.height() > m_defaultSize.height()) {
+        return frame;
+    }
+
+    return m_canonicalFrames.at(frame);
+}
@@ -0,0 +1,690 @@
+/*
+ * Copyright (C) PrivateWeb Software (https://github.com/PrivateWebSoftware) - All Rights Reserved
+ *
+ * Licensed under the Apache License 2.0 (the "License"). You may not use
+ * this file except in compliance with the License. You can obtain a copy
+ * in the file LICENSE in the source distribution
+ *
+ * Written by PrivateWeb Software <privatewebsoftware@protonmail.com>, October 2026
+ */
+
+#include "include/PWLottieCache/PWLottieSourceReader.h"
+#include "include/PWLottieTrace/PWLottieTrace.h"
+
+#include <QDebug>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMimeDatabase>
+#include <QStringList>
+#include <QtEndian>
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <string_view>
+#include <tuple>
+
+#ifdef PWLOTTIE_ZLIB
+#include <zlib.h>
+#endif
+
+#define gzipWindowBits 15 + 16
+#define rawDeflateWindowBits -15
+#define zipLocalHeaderSignature 0x04034b50
+#define zipCentralHeaderSignature 0x02014b50
+#define zipEndSignature 0x06054b50
+#define zipLocalHeaderSize 30
+#define zipCentralHeaderSize 46
+#define zipEndSize 22
+#define zipStoredMethod 0
+#define zipDeflatedMethod 8
+
+///
+/// \brief PWLottieSourceReader::read - Function reads source, inflates it if it's compressed and reports progress of reading.
+/// \param source - Source of lottie animation.
+/// \param jsonData - Lottie JSON.
+/// \param progressCallback - Callback that gets progress of reading.
+/// \return Returns true if source was read.
+///
+bool PWLottieSourceReader::read(const QString& source, std::string& jsonData, const std::function<void(qreal)>& progressCallback)
+{
+    QFile sourceFile(source);
+    if (!sourceFile.open(QFile::ReadOnly)) {
+        qWarning() << "Couldn't open lottie file with error:" << sourceFile.errorString();
+
+        return false;
+    }
+
+    qint64 size = sourceFile.size();
+    const uchar* data = size > 0 ? sourceFile.map(0, size) : nullptr;
+
+    /* Compressed resources and files without size can't be mapped, they are read instead */
+    QByteArray sourceBuffer;
+    if (!data) {
+        sourceBuffer = sourceFile.readAll();
+        data = reinterpret_cast<const uchar*>(sourceBuffer.constData());
+        size = sourceBuffer.size();
+    }
+
+    switch (sourceFormat(data, size)) {
+    case SourceFormat::Gzip: {
+        /* Gzip trailer keeps size of inflated data, so JSON is usually allocated only once */
+        const qint64 inflatedSize = size >= 18 ? qint64(qFromLittleEndian<quint32>(data + size - 4)) : 0;
+
+        if (!inflateData(data, size, gzipWindowBits, inflatedSize, jsonData, progressCallback)) {
+            return false;
+        }
+
+        break;
+    }
+    case SourceFormat::Zip:
+        /* Images of archive are embedded while it's read */
+        return readArchive(data, size, jsonData, progressCallback);
+    case SourceFormat::Json:
+        jsonData.resize(size_t(size));
+
+        /* Pages of mapped file are read while they are copied, reading is reported as the first half of loading, parsing is the second one */
+        for (qint64 offset = 0; offset < size; offset += sourceReadChunkSize) {
+            const qint64 chunkSize = qMin<qint64>(sourceReadChunkSize, size - offset);
+
+            std::memcpy(jsonData.data() + offset, data + offset, size_t(chunkSize));
+
+            if (progressCallback) {
+                progressCallback(qreal(offset + chunkSize) / size / 2);
+            }
+        }
+
+        break;
+    }
+
+    /* rlottie reads images only from disk, so images of Qt resources are embedded */
+    if (source.startsWith(':')) {
+        const QString sourcePath = QFileInfo(source).path();
+
+        embedImages(jsonData, [&sourcePath](const QString& imagePath, QByteArray& imageData) {
+            QFile imageFile(sourcePath + "/" + imagePath);
+            if (!imageFile.open(QFile::ReadOnly)) {
+                return false;
+            }
+
+            imageData = imageFile.readAll();
+
+            return true;
+        });
+    }
+
+    return true;
+}
+
+///
+/// \brief PWLottieSourceReader::resourcePath - Function gets path where rlottie finds images, that aren't embedded into JSON.
+/// \param source - Source of lottie animation.
+/// \return Returns directory of source file.
+///
+std::string PWLottieSourceReader::resourcePath(const QString& source)
+{
+    /* rlottie appends path of image to it without separator */
+    return (QFileInfo(source).absolutePath() + "/").toStdString();
+}
+
+///
+/// \brief PWLottieSourceReader::sourceFormat - Function detects format of source by it's first bytes.
+/// \param data - Source data.
+/// \param size - Size of source data.
+/// \return Returns format of source.
+///
+PWLottieSourceReader::SourceFormat PWLottieSourceReader::sourceFormat(const uchar* data, const qint64 size)
+{
+    if (size >= 2 && data[0] == 0x1f && data[1] == 0x8b) {
+        return SourceFormat::Gzip;
+    }
+
+    if (size >= 4 && qFromLittleEndian<quint32>(data) == zipLocalHeaderSignature) {
+        return SourceFormat::Zip;
+    }
+
+    return SourceFormat::Json;
+}
+
+///
+/// \brief PWLottieSourceReader::inflateData - Function inflates deflate stream by chunks.
+/// \param data - Compressed data.
+/// \param size - Size of compressed data.
+/// \param windowBits - Window bits of zlib, they select gzip or raw deflate stream.
+/// \param inflatedSize - Size of inflated data that source claims, buffer grows if it's bigger.
+/// \param output - Inflated data.
+/// \param progressCallback - Callback that gets progress of inflating.
+/// \return Returns true if stream was inflated.
+///
+bool PWLottieSourceReader::inflateData(const uchar* data, const qint64 size, const int windowBits, const qint64 inflatedSize, std::string& output, const std::function<void(qreal)>& progressCallback)
+{
+#ifdef PWLOTTIE_ZLIB
+    PWLottieTrace::Span inflateSpan("inflate", -1, size);
+
+    z_stream stream {};
+    if (inflateInit2(&stream, windowBits) != Z_OK) {
+        qWarning() << "Couldn't initialise zlib stream";
+
+        return false;
+    }
+
+    /* Claimed size isn't trusted, corrupt source could ask for gigabytes, bigger streams grow the buffer */
+    output.resize(size_t(qBound<qint64>(1, qMin<qint64>(inflatedSize, size * maxInflationRatio), maxInflatedSourceSize)));
+
+    qint64 consumedSize = 0;
+    size_t writtenSize = 0;
+    int result = Z_OK;
+
+    /* Input is fed by chunks, so pages of mapped source are read only when they are inflated */
+    while (result != Z_STREAM_END) {
+        if (stream.avail_in == 0) {
+            if (consumedSize == size) {
+                break;
+            }
+
+            const qint64 chunkSize = qMin<qint64>(sourceReadChunkSize, size - consumedSize);
+
+            stream.next_in = const_cast<Bytef*>(data + consumedSize);
+            stream.avail_in = uInt(chunkSize);
+            consumedSize += chunkSize;
+
+            if (progressCallback) {
+                progressCallback(qreal(consumedSize) / size / 2);
+            }
+        }
+
+        /* Output grows only if source didn't tell it's inflated size, but never over the limit */
+        if (writtenSize == output.size()) {
+            if (output.size() >= size_t(maxInflatedSourceSize)) {
+                result = Z_MEM_ERROR;
+
+                break;
+            }
+
+            output.resize(qMin<size_t>(output.size() + qMax<size_t>(output.size() / 2, sourceReadChunkSize), maxInflatedSourceSize));
+        }
+
+        stream.next_out = reinterpret_cast<Bytef*>(output.data() + writtenSize);
+        stream.avail_out = uInt(qMin<size_t>(output.size() - writtenSize, UINT_MAX));
+
+        const uInt availableOutput = stream.avail_out;
+        result = ::inflate(&stream, Z_NO_FLUSH);
+        writtenSize += availableOutput - stream.avail_out;
+
+        if (result != Z_OK && result != Z_STREAM_END && result != Z_BUF_ERROR) {
+            break;
+        }
+    }
+
+    const QString errorString = result == Z_MEM_ERROR ? QString("inflated source is too big") : stream.msg ? QString(stream.msg) : QString("stream is truncated");
+
+    inflateEnd(&stream);
+
+    if (result != Z_STREAM_END) {
+        qWarning() << "Couldn't inflate lottie source with error:" << errorString;
+
+        return false;
+    }
+
+    output.resize(writtenSize);
+
+    return true;
+#else
+    Q_UNUSED(data)
+    Q_UNUSED(size)
+    Q_UNUSED(windowBits)
+    Q_UNUSED(inflatedSize)
+    Q_UNUSED(output)
+    Q_UNUSED(progressCallback)
+
+    qWarning() << "Compressed lottie sources aren't supported, library was built without zlib";
+
+    return false;
+#endif
+}
+
+///
+/// \brief PWLottieSourceReader::readArchive - Function reads animation of dotLottie archive and embeds it's images.
+/// \param data - Archive data.
+/// \param size - Size of archive data.
+/// \param jsonData - Lottie JSON.
+/// \param progressCallback - Callback that gets progress of reading.
+/// \return Returns true if animation was read.
+///
+bool PWLottieSourceReader::readArchive(const uchar* data, const qint64 size, std::string& jsonData, const std::function<void(qreal)>& progressCallback)
+{
+    QHash<QString, ArchiveEntry> entries;
+    if (!archiveEntries(data, size, entries)) {
+        qWarning() << "Couldn't read dotLottie archive, it isn't valid zip file";
+
+        return false;
+    }
+
+    /* Animations are placed in 'animations' in the first version of dotLottie and in 'a' in the second one */
+    const QStringList animationDirectories = { "animations/", "a/" };
+    QString animationPath;
+
+    /* Manifest lists animations of archive, the first one is played */
+    std::string manifestData;
+    if (entries.contains("manifest.json") && readArchiveEntry(data, entries.value("manifest.json"), manifestData, nullptr)) {
+        const QJsonDocument manifest = QJsonDocument::fromJson(QByteArray::fromRawData(manifestData.data(), qsizetype(manifestData.size())));
+        const QString animationId = manifest.object().value("animations").toArray().at(0).toObject().value("id").toString();
+
+        for (const QString& animationDirectory : animationDirectories) {
+            if (!animationId.isEmpty() && entries.contains(animationDirectory + animationId + ".json")) {
+                animationPath = animationDirectory + animationId + ".json";
+
+                break;
+            }
+        }
+    }
+
+    /* Archives without manifest play their first animation */
+    if (animationPath.isEmpty()) {
+        QStringList entryNames = entries.keys();
+        entryNames.sort();
+
+        for (const QString& entryName : std::as_const(entryNames)) {
+            if ((entryName.startsWith(animationDirectories[0]) || entryName.startsWith(animationDirectories[1])) && entryName.endsWith(".json")) {
+                animationPath = entryName;
+
+                break;
+            }
+        }
+    }
+
+    if (animationPath.isEmpty()) {
+        qWarning() << "dotLottie archive doesn't have any animation";
+
+        return false;
+    }
+
+    if (!readArchiveEntry(data, entries.value(animationPath), jsonData, progressCallback)) {
+        return false;
+    }
+
+    /* Images are placed in 'images' or 'i' directory, but animations often keep only their file names */
+    embedImages(jsonData, [data, &entries](const QString& imagePath, QByteArray& imageData) {
+        const QString fileName = imagePath.section('/', -1);
+
+        const QStringList entryNames = { imagePath, "images/" + fileName, "i/" + fileName };
+
+        for (const QString& entryName : entryNames) {
+            std::string entryData;
+
+            if (entries.contains(entryName) && readArchiveEntry(data, entries.value(entryName), entryData, nullptr)) {
+                imageData = QByteArray(entryData.data(), qsizetype(entryData.size()));
+
+                return true;
+            }
+        }
+
+        return false;
+    });
+
+    return true;
+}
+
+///
+/// \brief PWLottieSourceReader::archiveEntries - Function reads central directory of zip archive.
+/// \param data - Archive data.
+/// \param size - Size of archive data.
+/// \param entries - Files of archive by their names.
+/// \return Returns true if archive is valid.
+///
+bool PWLottieSourceReader::archiveEntries(const uchar* data, const qint64 size, QHash<QString, ArchiveEntry>& entries)
+{
+    if (size < zipEndSize) {
+        return false;
+    }
+
+    /* End of central directory is the last record of archive, only comment of archive can follow it */
+    qint64 endOffset = -1;
+
+    for (qint64 offset = size - zipEndSize; offset >= qMax<qint64>(0, size - zipEndSize - maxArchiveCommentSize); --offset) {
+        if (qFromLittleEndian<quint32>(data + offset) == zipEndSignature) {
+            endOffset = offset;
+
+            break;
+        }
+    }
+
+    if (endOffset < 0) {
+        return false;
+    }
+
+    const quint16 entryCount = qFromLittleEndian<quint16>(data + endOffset + 10);
+    const qint64 directorySize = qFromLittleEndian<quint32>(data + endOffset + 12);
+    const qint64 directoryOffset = qFromLittleEndian<quint32>(data + endOffset + 16);
+    const qint64 directoryEnd = directoryOffset + directorySize;
+
+    /* ZIP64 archives keep 0xFFFFFFFF here, they aren't supported */
+    if (directoryEnd > endOffset) {
+        return false;
+    }
+
+    qint64 offset = directoryOffset;
+
+    for (quint16 entryIndex = 0; entryIndex < entryCount; ++entryIndex) {
+        if (offset + zipCentralHeaderSize > directoryEnd || qFromLittleEndian<quint32>(data + offset) != zipCentralHeaderSignature) {
+            return false;
+        }
+
+        const quint16 nameSize = qFromLittleEndian<quint16>(data + offset + 28);
+        const quint16 extraSize = qFromLittleEndian<quint16>(data + offset + 30);
+        const quint16 commentSize = qFromLittleEndian<quint16>(data + offset + 32);
+        const qint64 localHeaderOffset = qFromLittleEndian<quint32>(data + offset + 42);
+
+        if (offset + zipCentralHeaderSize + nameSize > directoryEnd) {
+            return false;
+        }
+
+        ArchiveEntry entry;
+        entry.method = qFromLittleEndian<quint16>(data + offset + 10);
+        entry.compressedSize = qFromLittleEndian<quint32>(data + offset + 20);
+        entry.size = qFromLittleEndian<quint32>(data + offset + 24);
+
+        /* Sizes of local header can differ from central directory, data starts right after it */
+        if (localHeaderOffset + zipLocalHeaderSize > size || qFromLittleEndian<quint32>(data + localHeaderOffset) != zipLocalHeaderSignature) {
+            return false;
+        }
+
+        entry.offset = localHeaderOffset + zipLocalHeaderSize + qFromLittleEndian<quint16>(data + localHeaderOffset + 26) + qFromLittleEndian<quint16>(data + localHeaderOffset + 28);
+
+        if (entry.offset + entry.compressedSize > size) {
+            return false;
+        }
+
+        entries.insert(QString::fromUtf8(reinterpret_cast<const char*>(data + offset + zipCentralHeaderSize), nameSize), entry);
+
+        offset += zipCentralHeaderSize + nameSize + extraSize + commentSize;
+    }
+
+    return true;
+}
+
+///
+/// \brief PWLottieSourceReader::readArchiveEntry - Function reads file of zip archive, stored and deflated files are supported.
+/// \param data - Archive data.
+/// \param entry - File of archive.
+/// \param output - Content of file.
+/// \param progressCallback - Callback that gets progress of reading.
+/// \return Returns true if file was read.
+///
+bool PWLottieSourceReader::readArchiveEntry(const uchar* data, const ArchiveEntry& entry, std::string& output, const std::function<void(qreal)>& progressCallback)
+{
+    if (entry.method == zipStoredMethod) {
+        output.assign(reinterpret_cast<const char*>(data + entry.offset), size_t(entry.compressedSize));
+
+        if (progressCallback) {
+            progressCallback(0.5);
+        }
+
+        return true;
+    }
+
+    if (entry.method == zipDeflatedMethod) {
+        return inflateData(data + entry.offset, entry.compressedSize, rawDeflateWindowBits, entry.size, output, progressCallback);
+    }
+
+    qWarning() << "Compression method of dotLottie archive isn't supported:" << entry.method;
+
+    return false;
+}
+
+///
+/// \brief skipWhitespace - Function skips whitespaces of JSON.
+/// \param json - JSON data.
+/// \param index - Index where whitespaces start.
+/// \return Returns index of the next token.
+///
+static qsizetype skipWhitespace(const std::string& json, qsizetype index)
+{
+    while (index < qsizetype(json.size()) && (json[index] == ' ' || json[index] == '\t' || json[index] == '\n' || json[index] == '\r')) {
+        ++index;
+    }
+
+    return index;
+}
+
+///
+/// \brief skipValue - Function skips JSON value without parsing it.
+/// \param json - JSON data.
+/// \param index - Index where value starts.
+/// \return Returns index right after value or '-1' if value isn't valid.
+///
+static qsizetype skipValue(const std::string& json, qsizetype index)
+{
+    const qsizetype size = qsizetype(json.size());
+    const qsizetype valueStart = index;
+    qint32 depth = 0;
+
+    for (; index < size; ++index) {
+        const char character = json[index];
+
+        if (character == '"') {
+            for (++index; index < size && json[index] != '"'; ++index) {
+                if (json[index] == '\\') {
+                    ++index;
+                }
+            }
+
+            if (index >= size) {
+                return -1;
+            }
+
+            if (depth == 0) {
+                return index + 1;
+            }
+        } else if (character == '{' || character == '[') {
+            ++depth;
+        } else if (character == '}' || character == ']') {
+            if (depth == 0) {
+                break;
+            }
+
+            if (--depth == 0) {
+                return index + 1;
+            }
+        } else if (depth == 0 && (character == ',' || character == ' ' || character == '\t' || character == '\n' || character == '\r')) {
+            break;
+        }
+    }
+
+    /* Numbers and literals end with the next separator */
+    return depth == 0 && index > valueStart ? index : -1;
+}
+
+///
+/// \brief scanObject - Function walks members of JSON object without parsing their values.
+/// \param json - JSON data.
+/// \param index - Index where object starts.
+/// \param member - Function that gets key of every member and span of it's value.
+/// \return Returns index of closing brace of object or '-1' if object isn't valid.
+///
+static qsizetype scanObject(const std::string& json, qsizetype index, const std::function<void(std::string_view, qsizetype, qsizetype)>& member)
+{
+    const qsizetype size = qsizetype(json.size());
+
+    if (index >= size || json[index] != '{') {
+        return -1;
+    }
+
+    index = skipWhitespace(json, index + 1);
+
+    if (index < size && json[index] == '}') {
+        return index;
+    }
+
+    while (index < size && json[index] == '"') {
+        const qsizetype keyStart = index;
+        const qsizetype keyEnd = skipValue(json, keyStart);
+
+        index = keyEnd < 0 ? size : skipWhitespace(json, keyEnd);
+
+        if (index >= size || json[index] != ':') {
+            return -1;
+        }
+
+        const qsizetype valueStart = skipWhitespace(json, index + 1);
+        const qsizetype valueEnd = skipValue(json, valueStart);
+
+        if (valueEnd < 0) {
+            return -1;
+        }
+
+        member(std::string_view(json.data() + keyStart + 1, size_t(keyEnd - keyStart - 2)), valueStart, valueEnd);
+
+        index = skipWhitespace(json, valueEnd);
+
+        if (index < size && json[index] == '}') {
+            return index;
+        }
+
+        if (index >= size || json[index] != ',') {
+            return -1;
+        }
+
+        index = skipWhitespace(json, index + 1);
+    }
+
+    return -1;
+}
+
+///
+/// \brief jsonString - Function decodes JSON string token.
+/// \param json - JSON data.
+/// \param start - Index of opening quote.
+/// \param end - Index right after closing quote.
+/// \return Returns decoded string, or empty string if token isn't string.
+///
+static QString jsonString(const std::string& json, const qsizetype start, const qsizetype end)
+{
+    if (start < 0 || end - start < 2 || json[start] != '"') {
+        return QString();
+    }
+
+    /* Strings of assets are short, so escapes are decoded by QJsonDocument */
+    return QJsonDocument::fromJson("[" + QByteArray(json.data() + start, end - start) + "]").array().at(0).toString();
+}
+
+///
+/// \brief PWLottieSourceReader::embedImages - Function embeds images of animation into JSON as data URIs.
+/// \param jsonData - Lottie JSON.
+/// \param readImage - Function that reads image by it's path in JSON.
+///
+void PWLottieSourceReader::embedImages(std::string& jsonData, const std::function<bool(const QString&, QByteArray&)>& readImage)
+{
+    /* Only image assets have 'u' key, so JSON of animations without images isn't scanned */
+    if (jsonData.find("\"u\"") == std::string::npos) {
+        return;
+    }
+
+    /*
+     * Only values of 'u', 'p' and 'e' members of image assets are replaced in JSON string, so order of keys,
+     * that rlottie depends on, is kept and no document of whole animation is built. Assets are replaced
+     * from the last one, so spans of assets before them stay valid and only one image is in memory at once.
+     */
+    qsizetype assetsStart = -1;
+    qsizetype assetsEnd = -1;
+
+    const qsizetype rootEnd = scanObject(jsonData, skipWhitespace(jsonData, 0), [&assetsStart, &assetsEnd, &jsonData](std::string_view key, const qsizetype valueStart, const qsizetype valueEnd) {
+        if (key == "assets" && jsonData[valueStart] == '[') {
+            assetsStart = valueStart;
+            assetsEnd = valueEnd;
+        }
+    });
+
+    if (rootEnd < 0 || assetsStart < 0) {
+        return;
+    }
+
+    QList<ImageAsset> imageAssets;
+
+    for (qsizetype index = skipWhitespace(jsonData, assetsStart + 1); index < assetsEnd && jsonData[index] != ']';) {
+        ImageAsset imageAsset;
+        bool precomposition = false;
+
+        const qsizetype assetEnd = scanObject(jsonData, index, [&imageAsset, &precomposition](std::string_view key, const qsizetype valueStart, const qsizetype valueEnd) {
+            if (key == "u") {
+                imageAsset.directoryStart = valueStart;
+                imageAsset.directoryEnd = valueEnd;
+            } else if (key == "p") {
+                imageAsset.fileStart = valueStart;
+                imageAsset.fileEnd = valueEnd;
+            } else if (key == "e") {
+                imageAsset.embeddedStart = valueStart;
+                imageAsset.embeddedEnd = valueEnd;
+            } else if (key == "layers") {
+                precomposition = true;
+            }
+        });
+
+        if (assetEnd < 0) {
+            return;
+        }
+
+        imageAsset.assetEnd = assetEnd;
+
+        /* Precompositions and images that are embedded already are skipped */
+        const bool embedded = imageAsset.embeddedStart >= 0 && jsonData.compare(size_t(imageAsset.embeddedStart), size_t(imageAsset.embeddedEnd - imageAsset.embeddedStart), "1") == 0;
+
+        if (!precomposition && !embedded && imageAsset.fileStart >= 0) {
+            imageAssets.append(imageAsset);
+        }
+
+        index = skipWhitespace(jsonData, assetEnd + 1);
+
+        if (index < assetsEnd && jsonData[index] == ',') {
+            index = skipWhitespace(jsonData, index + 1);
+        }
+    }
+
+    for (qsizetype assetIndex = imageAssets.size() - 1; assetIndex >= 0; --assetIndex) {
+        const ImageAsset& imageAsset = imageAssets.at(assetIndex);
+        const QString fileName = jsonString(jsonData, imageAsset.fileStart, imageAsset.fileEnd);
+
+        if (fileName.isEmpty() || fileName.startsWith("data:")) {
+            continue;
+        }
+
+        QString imagePath = jsonString(jsonData, imageAsset.directoryStart, imageAsset.directoryEnd) + fileName;
+        while (imagePath.startsWith('/')) {
+            imagePath.remove(0, 1);
+        }
+
+        QByteArray imageData;
+        if (!readImage(imagePath, imageData)) {
+            qWarning() << "Couldn't find image of lottie animation:" << imagePath;
+
+            continue;
+        }
+
+        const QByteArray mimeType = QMimeDatabase().mimeTypeForFileNameAndData(fileName, imageData).name().toLatin1();
+
+        /* Members are replaced from the last one, so their spans don't move */
+        QList<std::tuple<qsizetype, qsizetype, QByteArray>> replacements;
+        replacements.append({ imageAsset.fileStart, imageAsset.fileEnd, QByteArray("\"data:" + mimeType + ";base64," + imageData.toBase64() + "\"") });
+
+        if (imageAsset.directoryStart >= 0) {
+            replacements.append({ imageAsset.directoryStart, imageAsset.directoryEnd, "\"\"" });
+        }
+
+        if (imageAsset.embeddedStart >= 0) {
+            replacements.append({ imageAsset.embeddedStart, imageAsset.embeddedEnd, "1" });
+        } else {
+            replacements.append({ imageAsset.assetEnd, imageAsset.assetEnd, ",\"e\":1" });
+        }
+
+        std::sort(replacements.begin(), replacements.end(), [](const auto& first, const auto& second) {
+            return std::get<0>(first) > std::get<0>(second);
+        });
+
+        for (const auto& [start, end, value] : std::as_const(replacements)) {
+            jsonData.replace(size_t(start), size_t(end - start), value.constData(), size_t(value.size()));
+        }
+    }
+}
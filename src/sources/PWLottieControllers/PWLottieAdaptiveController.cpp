@@ -0,0 +1,293 @@
+/*
+ * Copyright (C) PrivateWeb Software (https://github.com/PrivateWebSoftware) - All Rights Reserved
+ *
+ * Licensed under the Apache License 2.0 (the "License"). You may not use
+ * this file except in compliance with the License. You can obtain a copy
+ * in the file LICENSE in the source distribution
+ *
+ * Written by PrivateWeb Software <privatewebsoftware@protonmail.com>, October 2026
+ */
+
+#include "include/PWLottieControllers/PWLottieAdaptiveController.h"
+#include "include/PWLottieFrameClock/PWLottieFrameClock.h"
+#include "include/PWLottieRenderScheduler/PWLottieRenderScheduler.h"
+
+#include <QGuiApplication>
+#include <QScreen>
+
+#include <algorithm>
+
+PWLottieAdaptiveController::PWLottieAdaptiveController(QObject* parent)
+    : PWLottieAbstractController { parent }
+{
+}
+
+///
+/// \brief PWLottieAdaptiveController::addLottieItem - Function adds lottie item to controller.
+/// \param lottieItemInfo - Lottie handle, size and priority of lottie item.
+/// \return Returns current fps of registred lotti animation.
+///
+quint16 PWLottieAdaptiveController::addLottieItem(const PWLottieItemInfo& lottieItemInfo)
+{
+    /* Controller is a static object, so timer is created only when application already exists */
+    if (!m_evaluationTimer) {
+        m_evaluationTimer = new QTimer(this);
+        m_evaluationTimer->setInterval(adaptiveEvaluationInterval);
+
+        connect(m_evaluationTimer, &QTimer::timeout, this, &PWLottieAdaptiveController::evaluate);
+    }
+
+    lottieItemsList.insert(lottieItemInfo.lottieHandle);
+
+    /* New item starts with framerate of other items, it's own render time is unknown yet */
+    m_itemLoads.insert(lottieItemInfo.lottieHandle, { 0.0, m_globalLevel });
+
+    if (!m_evaluationTimer->isActive()) {
+        m_evaluationTimer->start();
+    }
+
+    return levelFrameRate(m_globalLevel);
+}
+
+///
+/// \brief PWLottieAdaptiveController::removeLottieItem - Function removes lottie item from controller.
+/// \param lottieHandle - Lottie handle for it's controlling.
+///
+void PWLottieAdaptiveController::removeLottieItem(const PWLottieHandle lottieHandle)
+{
+    lottieItemsList.remove(lottieHandle);
+    m_itemLoads.remove(lottieHandle);
+
+    if (m_itemLoads.isEmpty() && m_evaluationTimer) {
+        m_evaluationTimer->stop();
+    }
+}
+
+///
+/// \brief PWLottieAdaptiveController::reportRenderTime - Function takes time of the last rendered frame of lottie item.
+/// \param lottieHandle - Lottie handle for it's controlling.
+/// \param renderTime - Time of rendering in nanoseconds.
+///
+void PWLottieAdaptiveController::reportRenderTime(const PWLottieHandle lottieHandle, const qint64 renderTime)
+{
+    const auto itemLoad = m_itemLoads.find(lottieHandle);
+
+    if (itemLoad == m_itemLoads.end()) {
+        return;
+    }
+
+    /* Render time is smoothed, so a single slow frame doesn't change framerate */
+    const qreal renderTimeMs = renderTime / qreal(1000000);
+    itemLoad->renderTime = itemLoad->renderTime > 0.0 ? itemLoad->renderTime * 0.8 + renderTimeMs * 0.2 : renderTimeMs;
+}
+
+///
+/// \brief PWLottieAdaptiveController::setMode - Function sets whether framerate is adjusted for all items at once or for every item separately.
+/// \param mode - Mode that will be installed.
+///
+void PWLottieAdaptiveController::setMode(const Mode mode)
+{
+    if (m_mode == mode) {
+        return;
+    }
+
+    m_mode = mode;
+    m_calmEvaluations = 0;
+
+    /* All items continue from the common level */
+    for (ItemLoad& itemLoad : m_itemLoads) {
+        itemLoad.level = m_globalLevel;
+    }
+
+    emit fpsChanged(levelFrameRate(m_globalLevel));
+}
+
+///
+/// \brief PWLottieAdaptiveController::evaluate - Function measures loads and changes framerate levels, it's called by evaluation timer.
+///
+void PWLottieAdaptiveController::evaluate()
+{
+    if (m_itemLoads.isEmpty()) {
+        return;
+    }
+
+    /* Display interval of stopped clock is outdated, so framerate isn't changed by it */
+    if (!PWLottieFrameClock::instance()->hasDisplayFrameInterval()) {
+        m_calmEvaluations = 0;
+
+        return;
+    }
+
+    /* GUI thread and render loop are late when display frames come slower than target */
+    const qreal frameLoad = PWLottieFrameClock::instance()->displayFrameInterval() * displayFrameRate() / qreal(1000);
+    const qreal currentRenderLoad = renderLoad();
+
+    const bool overloaded = frameLoad > adaptiveHighFrameLoad || currentRenderLoad > adaptiveHighRenderLoad;
+    const bool calm = frameLoad < adaptiveLowFrameLoad && currentRenderLoad < adaptiveLowRenderLoad;
+
+    if (overloaded) {
+        m_calmEvaluations = 0;
+
+        if (m_mode == Mode::Global) {
+            if (m_globalLevel + 1 < m_frameRateLevels.count()) {
+                m_globalLevel += 1;
+
+                emit fpsChanged(levelFrameRate(m_globalLevel));
+            }
+        } else {
+            /* Lower render load in proportion to overload, so that load gets between thresholds */
+            const qreal overload = qMax(frameLoad / adaptiveHighFrameLoad, currentRenderLoad / adaptiveHighRenderLoad);
+            lowerPerItemLevels(currentRenderLoad / overload * (adaptiveHighRenderLoad + adaptiveLowRenderLoad) / adaptiveHighRenderLoad / 2);
+        }
+
+        return;
+    }
+
+    /* Between thresholds nothing is changed, that's what keeps framerate stable */
+    if (!calm) {
+        m_calmEvaluations = 0;
+
+        return;
+    }
+
+    if (++m_calmEvaluations < adaptiveCalmEvaluations) {
+        return;
+    }
+
+    m_calmEvaluations = 0;
+
+    if (m_mode == Mode::Global) {
+        /* Framerate is raised only if predicted render load stays under high threshold */
+        if (m_globalLevel > 0 && renderLoad(-1) < adaptiveHighRenderLoad) {
+            m_globalLevel -= 1;
+
+            for (ItemLoad& itemLoad : m_itemLoads) {
+                itemLoad.level = m_globalLevel;
+            }
+
+            emit fpsChanged(levelFrameRate(m_globalLevel));
+        }
+    } else {
+        raisePerItemLevels();
+    }
+}
+
+///
+/// \brief PWLottieAdaptiveController::renderLoad - Function predicts part of render workers capacity that is used by items.
+/// \param levelShift - Shift of framerate levels of all items for prediction.
+/// \return Returns '1.0' if workers are fully loaded.
+///
+qreal PWLottieAdaptiveController::renderLoad(const qint32 levelShift) const
+{
+    qreal renderTimePerSecond = 0.0;
+
+    for (const ItemLoad& itemLoad : m_itemLoads) {
+        const qint32 level = m_mode == Mode::Global ? m_globalLevel : itemLoad.level;
+
+        renderTimePerSecond += itemLoad.renderTime * levelFrameRate(level + levelShift);
+    }
+
+    return renderTimePerSecond / (qreal(1000) * qMax(1, PWLottieRenderScheduler::instance()->threadCount()));
+}
+
+///
+/// \brief PWLottieAdaptiveController::lowerPerItemLevels - Function lowers levels of the most expensive items until render load goes down to target.
+/// \param targetRenderLoad - Render load that should be reached.
+/// \return Returns true if any level was changed.
+///
+bool PWLottieAdaptiveController::lowerPerItemLevels(const qreal targetRenderLoad)
+{
+    QList<QHash<PWLottieHandle, ItemLoad>::iterator> itemLoads;
+
+    for (auto itemLoad = m_itemLoads.begin(); itemLoad != m_itemLoads.end(); ++itemLoad) {
+        if (itemLoad->level + 1 < m_frameRateLevels.count()) {
+            itemLoads.append(itemLoad);
+        }
+    }
+
+    /* Items that cost the most per second are slowed down first */
+    std::sort(itemLoads.begin(), itemLoads.end(), [this](const auto& left, const auto& right) {
+        return left->renderTime * levelFrameRate(left->level) > right->renderTime * levelFrameRate(right->level);
+    });
+
+    bool changed = false;
+    qreal predictedRenderLoad = renderLoad();
+
+    for (const auto& itemLoad : std::as_const(itemLoads)) {
+        if (changed && predictedRenderLoad <= targetRenderLoad) {
+            break;
+        }
+
+        predictedRenderLoad -= itemLoad->renderTime * (levelFrameRate(itemLoad->level) - levelFrameRate(itemLoad->level + 1)) / (qreal(1000) * qMax(1, PWLottieRenderScheduler::instance()->threadCount()));
+        itemLoad->level += 1;
+        changed = true;
+
+        emit fpsChanged(levelFrameRate(itemLoad->level), itemLoad.key());
+    }
+
+    return changed;
+}
+
+///
+/// \brief PWLottieAdaptiveController::raisePerItemLevels - Function raises levels of the cheapest items while render load stays low.
+/// \return Returns true if any level was changed.
+///
+bool PWLottieAdaptiveController::raisePerItemLevels()
+{
+    QList<QHash<PWLottieHandle, ItemLoad>::iterator> itemLoads;
+
+    for (auto itemLoad = m_itemLoads.begin(); itemLoad != m_itemLoads.end(); ++itemLoad) {
+        if (itemLoad->level > 0) {
+            itemLoads.append(itemLoad);
+        }
+    }
+
+    /* Cheap items get their framerate back first */
+    std::sort(itemLoads.begin(), itemLoads.end(), [](const auto& left, const auto& right) {
+        return left->renderTime < right->renderTime;
+    });
+
+    bool changed = false;
+    qreal predictedRenderLoad = renderLoad();
+
+    for (const auto& itemLoad : std::as_const(itemLoads)) {
+        predictedRenderLoad += itemLoad->renderTime * (levelFrameRate(itemLoad->level - 1) - levelFrameRate(itemLoad->level)) / (qreal(1000) * qMax(1, PWLottieRenderScheduler::instance()->threadCount()));
+
+        if (predictedRenderLoad >= adaptiveLowRenderLoad) {
+            break;
+        }
+
+        itemLoad->level -= 1;
+        changed = true;
+
+        emit fpsChanged(levelFrameRate(itemLoad->level), itemLoad.key());
+    }
+
+    return changed;
+}
+
+///
+/// \brief PWLottieAdaptiveController::displayFrameRate - Function gets display framerate that is held, it's target framerate or refresh rate of screen.
+/// \return Returns framerate.
+///
+qreal PWLottieAdaptiveController::displayFrameRate() const
+{
+    if (m_targetFrameRate > 0) {
+        return m_targetFrameRate;
+    }
+
+    /* Display that refreshes at 50 Hz would look overloaded against 60 fps forever */
+    const QScreen* screen = QGuiApplication::primaryScreen();
+
+    return screen && screen->refreshRate() > 0 ? screen->refreshRate() : 60;
+}
+
+///
+/// \brief PWLottieAdaptiveController::levelFrameRate - Function gets framerate of level.
+/// \param level - Framerate level, '0' is the highest framerate.
+/// \return Returns framerate.
+///
+quint16 PWLottieAdaptiveController::levelFrameRate(const qint32 level) const
+{
+    return m_frameRateLevels.at(qBound(0, level, qint32(m_frameRateLevels.count()) - 1));
+}
@@ -17,12 +17,12 @@ PWLottieBaseController::PWLottieBaseController(QObject* parent)
 
 ///
 /// \brief PWLottieBaseController::addLottieItem - Function adds lottie item to controller.
-/// \param lottieUuid - Unique lottie UUID for it's controlling.
+/// \param lottieItemInfo - Lottie handle, size and priority of lottie item.
 /// \return Returns current fps of registred lotti animation.
 ///
-quint16 PWLottieBaseController::addLottieItem(const QString& lottieUuid)
+quint16 PWLottieBaseController::addLottieItem(const PWLottieItemInfo& lottieItemInfo)
 {
-    lottieItemsList.insert(lottieUuid);
+    lottieItemsList.insert(lottieItemInfo.lottieHandle);
 
     /* Set up needed frame rate */
     if (m_currentFps != getRecommendedFrameRate()) {
@@ -34,11 +34,11 @@ quint16 PWLottieBaseController::addLottieItem(const QString& lottieUuid)
 
 ///
 /// \brief PWLottieBaseController::removeLottieItem - Function removes lottie item from controller.
-/// \param lottieUuid - Unique lottie UUID for it's controlling.
+/// \param lottieHandle - Lottie handle for it's controlling.
 ///
-void PWLottieBaseController::removeLottieItem(const QString& lottieUuid)
+void PWLottieBaseController::removeLottieItem(const PWLottieHandle lottieHandle)
 {
-    lottieItemsList.remove(lottieUuid);
+    lottieItemsList.remove(lottieHandle);
 
     /* Set up needed frame rate */
     if (m_currentFps != getRecommendedFrameRate()) {
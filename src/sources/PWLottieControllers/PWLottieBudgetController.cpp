@@ -0,0 +1,189 @@
+/*
+ * Copyright (C) PrivateWeb Software (https://github.com/PrivateWebSoftware) - All Rights Reserved
+ *
+ * Licensed under the Apache License 2.0 (the "License"). You may not use
+ * this file except in compliance with the License. You can obtain a copy
+ * in the file LICENSE in the source distribution
+ *
+ * Written by PrivateWeb Software <privatewebsoftware@protonmail.com>, October 2026
+ */
+
+#include "include/PWLottieControllers/PWLottieBudgetController.h"
+
+#include <QtMath>
+
+PWLottieBudgetController::PWLottieBudgetController(QObject* parent)
+    : PWLottieAbstractController { parent }
+{
+}
+
+///
+/// \brief PWLottieBudgetController::addLottieItem - Function adds lottie item to controller.
+/// \param lottieItemInfo - Lottie handle, size and priority of lottie item.
+/// \return Returns current fps of registred lotti animation.
+///
+quint16 PWLottieBudgetController::addLottieItem(const PWLottieItemInfo& lottieItemInfo)
+{
+    lottieItemsList.insert(lottieItemInfo.lottieHandle);
+
+    /* Culled items come with empty size, they don't take any share of budget */
+    ItemBudget itemBudget = { qMax<qint64>(0, qint64(lottieItemInfo.size.width()) * lottieItemInfo.size.height()), qMax<qreal>(0.0, lottieItemInfo.priority) };
+
+    /* Until budget is shared again, new item gets framerate that it would have without redistribution */
+    qreal totalWeight = frameWeight(itemBudget) * itemBudget.pixels;
+
+    for (const ItemBudget& otherBudget : std::as_const(m_itemBudgets)) {
+        totalWeight += frameWeight(otherBudget) * otherBudget.pixels;
+    }
+
+    const qreal frameRate = totalWeight > 0.0 && itemBudget.pixels > 0 ? m_pixelsPerSecond * frameWeight(itemBudget) / totalWeight : m_minFrameRate;
+    itemBudget.frameRate = quint16(qBound<qreal>(m_minFrameRate, qFloor(frameRate), m_maxFrameRate));
+
+    m_itemBudgets.insert(lottieItemInfo.lottieHandle, itemBudget);
+
+    scheduleAllocation();
+
+    return itemBudget.frameRate;
+}
+
+///
+/// \brief PWLottieBudgetController::removeLottieItem - Function removes lottie item from controller.
+/// \param lottieHandle - Lottie handle for it's controlling.
+///
+void PWLottieBudgetController::removeLottieItem(const PWLottieHandle lottieHandle)
+{
+    lottieItemsList.remove(lottieHandle);
+
+    if (m_itemBudgets.remove(lottieHandle)) {
+        scheduleAllocation();
+    }
+}
+
+///
+/// \brief PWLottieBudgetController::updateLottieItem - Function takes changed size or priority of lottie item.
+/// \param lottieItemInfo - Lottie handle, size and priority of lottie item.
+///
+void PWLottieBudgetController::updateLottieItem(const PWLottieItemInfo& lottieItemInfo)
+{
+    const auto itemBudget = m_itemBudgets.find(lottieItemInfo.lottieHandle);
+
+    if (itemBudget == m_itemBudgets.end()) {
+        return;
+    }
+
+    itemBudget->pixels = qMax<qint64>(0, qint64(lottieItemInfo.size.width()) * lottieItemInfo.size.height());
+    itemBudget->priority = qMax<qreal>(0.0, lottieItemInfo.priority);
+
+    scheduleAllocation();
+}
+
+///
+/// \brief PWLottieBudgetController::setPixelsPerSecond - Function sets count of pixels that all items can rasterise per second.
+/// \param pixelsPerSecond - Rasterisation budget.
+///
+void PWLottieBudgetController::setPixelsPerSecond(const qint64 pixelsPerSecond)
+{
+    m_pixelsPerSecond = qMax<qint64>(0, pixelsPerSecond);
+
+    scheduleAllocation();
+}
+
+///
+/// \brief PWLottieBudgetController::setFrameRateRange - Function sets framerates between which framerate of every item is kept.
+/// \param minFrameRate - The lowest framerate, it's kept even if budget is exceeded.
+/// \param maxFrameRate - The highest framerate.
+///
+void PWLottieBudgetController::setFrameRateRange(const quint16 minFrameRate, const quint16 maxFrameRate)
+{
+    m_minFrameRate = qMax<quint16>(1, minFrameRate);
+    m_maxFrameRate = qMax(m_minFrameRate, maxFrameRate);
+
+    scheduleAllocation();
+}
+
+///
+/// \brief PWLottieBudgetController::frameWeight - Function gets weight of item's framerate, framerates of items are proportional to it.
+/// \param itemBudget - Pixels and priority of item.
+/// \return Returns priority multiplied by square root of pixels.
+///
+qreal PWLottieBudgetController::frameWeight(const ItemBudget& itemBudget)
+{
+    /* Square root favours big items, but doesn't let one of them starve all others */
+    return itemBudget.priority * qSqrt(qreal(itemBudget.pixels));
+}
+
+///
+/// \brief PWLottieBudgetController::scheduleAllocation - Function schedules allocation of budget, so many changes in a row are applied at once.
+///
+void PWLottieBudgetController::scheduleAllocation()
+{
+    if (m_allocationScheduled) {
+        return;
+    }
+
+    m_allocationScheduled = true;
+
+    /* Delegates of views are created in batches, budget is shared once after the whole batch */
+    QMetaObject::invokeMethod(this, &PWLottieBudgetController::allocateBudget, Qt::QueuedConnection);
+}
+
+///
+/// \brief PWLottieBudgetController::allocateBudget - Function shares budget between items and notifies items whose framerate was changed.
+///
+void PWLottieBudgetController::allocateBudget()
+{
+    m_allocationScheduled = false;
+
+    /*
+     * Framerate of item is proportional to it's frame weight w = priority * sqrt(pixels), so it's framerate is
+     * budget * w / sum(w * pixels). With weight of priority alone area of item would cancel out and full screen
+     * animation would play at the same framerate as small thumbnail. Items that would exceed maximal framerate
+     * are capped, and budget they don't use is shared between others again.
+     */
+    QHash<PWLottieHandle, qreal> frameRates;
+    QList<PWLottieHandle> uncappedItems = m_itemBudgets.keys();
+    qreal remainingBudget = m_pixelsPerSecond;
+
+    while (!uncappedItems.isEmpty()) {
+        qreal totalWeight = 0.0;
+
+        for (const PWLottieHandle lottieHandle : std::as_const(uncappedItems)) {
+            const ItemBudget& itemBudget = m_itemBudgets[lottieHandle];
+            totalWeight += frameWeight(itemBudget) * itemBudget.pixels;
+        }
+
+        const qsizetype uncappedCount = uncappedItems.count();
+
+        uncappedItems.removeIf([&](const PWLottieHandle lottieHandle) {
+            const ItemBudget& itemBudget = m_itemBudgets[lottieHandle];
+            /* Item without pixels doesn't rasterise anything, so it stays at minimal framerate instead of taking whole share */
+            const qreal frameRate = totalWeight > 0.0 && itemBudget.pixels > 0 ? qMax<qreal>(0.0, remainingBudget) * frameWeight(itemBudget) / totalWeight : 0.0;
+
+            frameRates.insert(lottieHandle, frameRate);
+
+            if (frameRate < m_maxFrameRate) {
+                return false;
+            }
+
+            frameRates.insert(lottieHandle, m_maxFrameRate);
+            remainingBudget -= qreal(m_maxFrameRate) * itemBudget.pixels;
+
+            return true;
+        });
+
+        if (uncappedItems.count() == uncappedCount) {
+            break;
+        }
+    }
+
+    for (auto itemBudget = m_itemBudgets.begin(); itemBudget != m_itemBudgets.end(); ++itemBudget) {
+        /* Minimal framerate is kept even when budget is exceeded, animation shouldn't freeze */
+        const quint16 frameRate = quint16(qBound<qreal>(m_minFrameRate, qFloor(frameRates.value(itemBudget.key())), m_maxFrameRate));
+
+        if (itemBudget->frameRate != frameRate) {
+            itemBudget->frameRate = frameRate;
+
+            emit fpsChanged(frameRate, itemBudget.key());
+        }
+    }
+}
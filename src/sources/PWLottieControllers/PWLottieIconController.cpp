@@ -9,8 +9,120 @@
  */
 
 #include "include/PWLottieControllers/PWLottieIconController.h"
+#include "include/PWLottieRenderScheduler/PWLottieRenderScheduler.h"
+#include "include/PWLottieTrace/PWLottieTrace.h"
+
+#include <QDebug>
 
 PWLottieIconController::PWLottieIconController(QObject* parent)
     : PWLottieAbstractController { parent }
 {
 }
+
+///
+/// \brief PWLottieIconController::addLottieItem - Function adds lottie item to controller.
+/// \param lottieItemInfo - Lottie handle, size and priority of lottie item.
+/// \return Returns current fps of registred lotti animation.
+///
+quint16 PWLottieIconController::addLottieItem(const PWLottieItemInfo& lottieItemInfo)
+{
+    lottieItemsList.insert(lottieItemInfo.lottieHandle);
+
+    return iconFrameRate;
+}
+
+///
+/// \brief PWLottieIconController::removeLottieItem - Function removes lottie item from controller.
+/// \param lottieHandle - Lottie handle for it's controlling.
+///
+void PWLottieIconController::removeLottieItem(const PWLottieHandle lottieHandle)
+{
+    lottieItemsList.remove(lottieHandle);
+
+    evictUnusedSpriteSheets();
+}
+
+///
+/// \brief PWLottieIconController::spriteSheet - Function gets sprite sheet of model in the given size, it's rendered in background if it wasn't requested before.
+/// \param model - Model of lottie animation.
+/// \param sourceSize - Size of item, budgets of icons are checked by it.
+/// \param frameSize - Size of frames in pixels of screen.
+/// \param format - Format of frames.
+/// \return Returns shared sprite sheet or nullptr if animation must be rendered live.
+///
+std::shared_ptr<const PWLottieSpriteSheet> PWLottieIconController::spriteSheet(const std::shared_ptr<const PWLottieModel>& model, const QSize& sourceSize, const QSize& frameSize, const QImage::Format format)
+{
+    if (!model || sourceSize.isEmpty() || frameSize.isEmpty()) {
+        return nullptr;
+    }
+
+    const PWLottieFrameKey sheetKey = { model->contentHash(), frameSize, -1, format };
+
+    /* Items with the same animation in the same size and format show one sheet */
+    if (m_spriteSheets.contains(sheetKey)) {
+        return m_spriteSheets.value(sheetKey);
+    }
+
+    /* Only small and short animations are worth to be rasterised completely */
+    if (qint64(sourceSize.width()) * sourceSize.height() > m_maxFramePixels || model->totalFrames() <= 0 || model->totalFrames() > m_maxFrames) {
+        return nullptr;
+    }
+
+    const QSize sheetSize = PWLottieSpriteSheet::sheetSize(frameSize, model->totalFrames());
+
+    if (sheetSize.width() > maxSpriteSheetSide || sheetSize.height() > maxSpriteSheetSide) {
+        return nullptr;
+    }
+
+    evictUnusedSpriteSheets();
+
+    /* Animation that doesn't fit in memory budget is rendered live, sheet isn't allocated for it at all */
+    if (m_memoryUsage + PWLottieSpriteSheet::sheetByteCost(sheetSize) > m_memoryBudget) {
+        return nullptr;
+    }
+
+    std::shared_ptr<PWLottieSpriteSheet> spriteSheet = std::make_shared<PWLottieSpriteSheet>(model->contentHash(), frameSize, model->totalFrames(), format);
+
+    if (spriteSheet->image().isNull()) {
+        qWarning() << "Couldn't allocate sprite sheet of size:" << sheetSize;
+
+        return nullptr;
+    }
+
+    m_spriteSheets.insert(sheetKey, spriteSheet);
+    m_memoryUsage += spriteSheet->byteCost();
+
+    emit memoryUsageChanged(m_memoryUsage);
+
+    /* Items render live frames until sheet is ready */
+    PWLottieRenderScheduler::instance()->submit([spriteSheet, model]() {
+        PWLottieTrace::Span spriteSheetSpan("spriteSheet", -1, model->totalFrames());
+
+        spriteSheet->render(*model);
+    });
+
+    return spriteSheet;
+}
+
+///
+/// \brief PWLottieIconController::evictUnusedSpriteSheets - Function frees sprite sheets that aren't shown by any item.
+///
+void PWLottieIconController::evictUnusedSpriteSheets()
+{
+    const qint64 memoryUsage = m_memoryUsage;
+
+    /* Sheet that is still rendering is referenced by render job, so it's kept until it's finished */
+    m_spriteSheets.removeIf([this](const QHash<PWLottieFrameKey, std::shared_ptr<PWLottieSpriteSheet>>::iterator spriteSheet) {
+        if (spriteSheet.value().use_count() > 1) {
+            return false;
+        }
+
+        m_memoryUsage -= spriteSheet.value()->byteCost();
+
+        return true;
+    });
+
+    if (m_memoryUsage != memoryUsage) {
+        emit memoryUsageChanged(m_memoryUsage);
+    }
+}
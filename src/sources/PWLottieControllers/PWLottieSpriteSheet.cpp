@@ -0,0 +1,185 @@
+/*
+ * Copyright (C) PrivateWeb Software (https://github.com/PrivateWebSoftware) - All Rights Reserved
+ *
+ * Licensed under the Apache License 2.0 (the "License"). You may not use
+ * this file except in compliance with the License. You can obtain a copy
+ * in the file LICENSE in the source distribution
+ *
+ * Written by PrivateWeb Software <privatewebsoftware@protonmail.com>, October 2026
+ */
+
+#include "include/PWLottieControllers/PWLottieSpriteSheet.h"
+#include "include/PWLottiePixels/PWLottiePixels.h"
+
+#include <QRunnable>
+#include <QtMath>
+
+#include <cstring>
+
+///
+/// NOTE: Sheet stays in memory after it's uploaded, so every window can upload it again after
+///       it's scene graph was recreated. Memory of sheet is counted twice, once for texture.
+///
+#define spriteSheetCopies 2
+
+PWLottieSpriteSheet::PWLottieSpriteSheet(const QByteArray& contentHash, const QSize& frameSize, const qint32 totalFrames, const QImage::Format format)
+    : m_contentHash(contentHash)
+    , m_frameSize(frameSize)
+    , m_totalFrames(totalFrames)
+{
+    const QSize size = sheetSize(m_frameSize, m_totalFrames);
+
+    /* Sheet is allocated right away, so it's memory is charged only if allocation succeeded */
+    m_image = size.isEmpty() ? QImage() : QImage(size, format);
+
+    m_columns = m_frameSize.width() > 0 ? size.width() / (m_frameSize.width() + 2 * spriteSheetGutter) : 0;
+    m_byteCost = m_image.isNull() ? 0 : sheetByteCost(size);
+}
+
+PWLottieSpriteSheet::~PWLottieSpriteSheet()
+{
+    QMutexLocker locker(&m_textureMutex);
+
+    /*
+     * Textures can be deleted only in render thread of their window. Items that showed sheet switch their nodes away
+     * from it in the next synchronization, so texture is deleted right after it. Texture of window that was destroyed
+     * was already deleted with it's scene graph.
+     */
+    for (const WindowTexture& windowTexture : std::as_const(m_textures)) {
+        if (!windowTexture.window) {
+            continue;
+        }
+
+        const QPointer<QSGTexture> texture = windowTexture.texture;
+
+        windowTexture.window->scheduleRenderJob(
+            QRunnable::create([texture]() {
+                delete texture.data();
+            }),
+            QQuickWindow::AfterSynchronizingStage);
+    }
+}
+
+///
+/// \brief PWLottieSpriteSheet::sheetSize - Function gets size of sheet with all frames of animation.
+/// \param frameSize - Size of one frame.
+/// \param totalFrames - Count of frames.
+/// \return Returns size of packed sheet with gutters.
+///
+QSize PWLottieSpriteSheet::sheetSize(const QSize& frameSize, const qint32 totalFrames)
+{
+    if (frameSize.isEmpty() || totalFrames <= 0) {
+        return QSize();
+    }
+
+    /* Nearly square sheet keeps both sides under texture size limits */
+    const qint32 columns = qCeil(qSqrt(qreal(totalFrames)));
+    const qint32 rows = (totalFrames + columns - 1) / columns;
+
+    return QSize(columns * (frameSize.width() + 2 * spriteSheetGutter), rows * (frameSize.height() + 2 * spriteSheetGutter));
+}
+
+///
+/// \brief PWLottieSpriteSheet::sheetByteCost - Function gets memory that is used by sheet of the given size.
+/// \param sheetSize - Size of packed sheet.
+/// \return Returns size of sheet pixels and of it's texture in bytes.
+///
+qint64 PWLottieSpriteSheet::sheetByteCost(const QSize& sheetSize)
+{
+    return qint64(sheetSize.width()) * sheetSize.height() * 4 * spriteSheetCopies;
+}
+
+///
+/// \brief PWLottieSpriteSheet::render - Function rasterises every frame of model in sheet, it's called once from render worker.
+/// \param model - Model of lottie animation.
+///
+void PWLottieSpriteSheet::render(const PWLottieModel& model)
+{
+    if (m_image.isNull()) {
+        return;
+    }
+
+    m_image.fill(Qt::transparent);
+
+    const qsizetype bytesPerLine = m_image.bytesPerLine();
+    const qint32 cellWidth = m_frameSize.width() + 2 * spriteSheetGutter;
+
+    /* Every frame is rendered straight into it's cell, surface just starts in the middle of sheet */
+    for (qint32 frame = 0; frame < m_totalFrames; ++frame) {
+        const QRectF rect = frameRect(frame);
+        uchar* const frameBits = m_image.bits() + qsizetype(rect.y()) * bytesPerLine + qsizetype(rect.x()) * 4;
+
+        model.render(frame, rlottie::Surface(reinterpret_cast<uint32_t*>(frameBits), m_frameSize.width(), m_frameSize.height(), bytesPerLine));
+
+        /* Edge pixels are repeated in gutter, so filtered samples at the border of frame see only this frame */
+        for (qint32 y = 0; y < m_frameSize.height(); ++y) {
+            quint32* const line = reinterpret_cast<quint32*>(frameBits + y * bytesPerLine);
+
+            for (qint32 x = 1; x <= spriteSheetGutter; ++x) {
+                line[-x] = line[0];
+                line[m_frameSize.width() - 1 + x] = line[m_frameSize.width() - 1];
+            }
+        }
+
+        uchar* const cellBits = frameBits - spriteSheetGutter * 4;
+
+        for (qint32 y = 1; y <= spriteSheetGutter; ++y) {
+            std::memcpy(cellBits - y * bytesPerLine, cellBits, size_t(cellWidth) * 4);
+            std::memcpy(cellBits + (m_frameSize.height() - 1 + y) * bytesPerLine, cellBits + (m_frameSize.height() - 1) * bytesPerLine, size_t(cellWidth) * 4);
+        }
+    }
+
+    /* Sheet is uploaded as it is, so it's converted to output format of items once */
+    PWLottiePixels::convert(m_image.bits(), bytesPerLine, m_image.size(), m_image.format());
+
+    m_ready.store(true, std::memory_order_release);
+}
+
+///
+/// \brief PWLottieSpriteSheet::frameRect - Function gets rect of frame in sheet.
+/// \param frame - Frame of animation.
+/// \return Returns rect in pixels of sheet, without gutter.
+///
+QRectF PWLottieSpriteSheet::frameRect(const qint32 frame) const
+{
+    if (m_columns <= 0) {
+        return QRectF();
+    }
+
+    const qint32 boundedFrame = qBound(0, frame, m_totalFrames - 1);
+    const qint32 cellWidth = m_frameSize.width() + 2 * spriteSheetGutter;
+    const qint32 cellHeight = m_frameSize.height() + 2 * spriteSheetGutter;
+
+    return QRectF(QPointF((boundedFrame % m_columns) * cellWidth + spriteSheetGutter, (boundedFrame / m_columns) * cellHeight + spriteSheetGutter), m_frameSize);
+}
+
+///
+/// \brief PWLottieSpriteSheet::texture - Function gets texture of sheet in the given window, sheet is uploaded only once per window.
+/// \attention Function must be called from render thread of window, like from 'updatePaintNode'.
+///
+/// \param window - Window that shows sheet.
+/// \return Returns texture that is owned by sheet, nodes mustn't delete it.
+///
+QSGTexture* PWLottieSpriteSheet::texture(QQuickWindow* window) const
+{
+    QMutexLocker locker(&m_textureMutex);
+
+    WindowTexture& windowTexture = m_textures[window];
+
+    if (windowTexture.texture) {
+        return windowTexture.texture;
+    }
+
+    QSGTexture* const texture = window->createTextureFromImage(m_image);
+
+    /* Texture dies with scene graph of window, then sheet is uploaded again when it's shown next time */
+    QObject::connect(
+        window, &QQuickWindow::sceneGraphInvalidated, texture, [texture]() {
+            delete texture;
+        },
+        Qt::DirectConnection);
+
+    windowTexture = { window, texture };
+
+    return texture;
+}
@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) PrivateWeb Software (https://github.com/PrivateWebSoftware) - All Rights Reserved
+ *
+ * Licensed under the Apache License 2.0 (the "License"). You may not use
+ * this file except in compliance with the License. You can obtain a copy
+ * in the file LICENSE in the source distribution
+ *
+ * Written by PrivateWeb Software <privatewebsoftware@protonmail.com>, October 2026
+ */
+
+#include "include/PWLottieFrameClock/PWLottieFrameClock.h"
+#include "include/PWLottieItem/PWLottieItem.h"
+
+PWLottieFrameClock::PWLottieFrameClock(QObject* parent)
+    : QAbstractAnimation { parent }
+{
+}
+
+///
+/// \brief PWLottieFrameClock::registerLottieItem - Function registers lottie item, so it will be ticked by clock.
+/// \param lottieItem - Lottie item that will be registered.
+///
+void PWLottieFrameClock::registerLottieItem(PWLottieItem* lottieItem)
+{
+    if (m_clockIndexes.contains(lottieItem)) {
+        return;
+    }
+
+    /* Item will be ticked on the nearest display frame */
+    m_clockIndexes.insert(lottieItem, m_clockEntries.size());
+    m_clockEntries.append({ lottieItem, 0.0 });
+
+    if (state() != QAbstractAnimation::Running) {
+        m_lastTickTime = -1;
+        m_displayFrameMeasured = false;
+        start();
+    }
+}
+
+///
+/// \brief PWLottieFrameClock::unregisterLottieItem - Function unregisters lottie item, so it won't be ticked anymore.
+/// \param lottieItem - Lottie item that will be unregistered.
+///
+void PWLottieFrameClock::unregisterLottieItem(PWLottieItem* lottieItem)
+{
+    const auto clockIndex = m_clockIndexes.constFind(lottieItem);
+
+    if (clockIndex == m_clockIndexes.constEnd()) {
+        return;
+    }
+
+    /* Swap with the last entry, so removal doesn't shift all entries after it */
+    const qsizetype entryIndex = clockIndex.value();
+    const qsizetype lastIndex = m_clockEntries.size() - 1;
+
+    if (entryIndex != lastIndex) {
+        m_clockEntries[entryIndex] = m_clockEntries.at(lastIndex);
+        m_clockIndexes[m_clockEntries.at(entryIndex).lottieItem] = entryIndex;
+    }
+
+    m_clockEntries.removeLast();
+    m_clockIndexes.erase(clockIndex);
+
+    /* Don't wake up application when there is nothing to animate */
+    if (m_clockEntries.isEmpty() && state() == QAbstractAnimation::Running) {
+        stop();
+    }
+}
+
+///
+/// \brief PWLottieFrameClock::updateCurrentTime - Overrided QAbstractAnimation function 'updateCurrentTime'. It's called once per display frame.
+/// \param currentTime - Current time of clock in milliseconds.
+///
+void PWLottieFrameClock::updateCurrentTime(int currentTime)
+{
+    /* Clock was restarted, so all items will be ticked from the beginning */
+    if (m_lastTickTime < 0 || currentTime < m_lastTickTime) {
+        for (ClockEntry& clockEntry : m_clockEntries) {
+            clockEntry.nextTickTime = currentTime;
+        }
+    } else if (currentTime > m_lastTickTime) {
+        /* Smooth measured display interval, it's used to tick items a bit earlier instead of a whole frame later.
+           Interval measured before clock was stopped can belong to another screen, so it's replaced by the first one */
+        const qreal displayFrameInterval = currentTime - m_lastTickTime;
+        m_displayFrameInterval = m_displayFrameMeasured ? m_displayFrameInterval * 0.9 + displayFrameInterval * 0.1 : displayFrameInterval;
+        m_displayFrameMeasured = true;
+    }
+
+    m_lastTickTime = currentTime;
+
+    /* Collect items whose frame interval has passed */
+    m_dueLottieItems.clear();
+
+    for (ClockEntry& clockEntry : m_clockEntries) {
+        if (currentTime + m_displayFrameInterval / 2 < clockEntry.nextTickTime) {
+            continue;
+        }
+
+        /* Culled items aren't rendered, they are checked at low frequency only for changes that items aren't notified about, like exposure of window */
+        const qreal frameInterval = clockEntry.lottieItem->culled() ? culledItemCheckInterval : qreal(1000) / qMax(1, clockEntry.lottieItem->frameRate());
+        clockEntry.nextTickTime += frameInterval;
+
+        /* Don't try to catch up frames that were missed */
+        if (clockEntry.nextTickTime <= currentTime) {
+            clockEntry.nextTickTime = currentTime + frameInterval;
+        }
+
+        m_dueLottieItems.append(clockEntry.lottieItem);
+    }
+
+    /* Items can unregister themselves or other items while being ticked, unregistered items are skipped */
+    for (qsizetype dueIndex = 0; dueIndex < m_dueLottieItems.size(); ++dueIndex) {
+        PWLottieItem* const lottieItem = m_dueLottieItems.at(dueIndex);
+
+        if (m_clockIndexes.contains(lottieItem)) {
+            lottieItem->render();
+        }
+    }
+
+    m_dueLottieItems.clear();
+}
@@ -9,25 +9,28 @@
  */
 
 #include "include/PWLottieItem/PWLottieItem.h"
+#include "include/PWLottieFrameClock/PWLottieFrameClock.h"
 
 PWLottieItem::PWLottieItem()
-    : m_lottieUuid(QUuid::createUuid().toString())
+    : m_lottieHandle(PWControllerMediator::registerLottieItem(this))
 {
-    /* Limit the number of threads so as not to take too much resources */
-    m_renderThreadPool.setMaxThreadCount(maxRenderThreads);
-
-    /* Create timer for controlling fps rate of lottie animation */
-    m_renderTimer.setTimerType(Qt::PreciseTimer);
-    connect(&m_renderTimer, &QTimer::timeout, this, [this]() {
-        if (this->running()) {
-            this->render();
-        }
-    });
+    /* Item shows frames with it's own scene graph node */
+    setFlag(QQuickItem::ItemHasContents);
+}
 
-    /* Set up framerate and start render timer */
-    setFrameRate(m_frameRate);
+///
+/// \brief PWLottieItem::setFrameRate - Function sets framerate of lottie animation.
+/// \param frameRate - Framerate that will be installed.
+///
+void PWLottieItem::setFrameRate(const qint32 frameRate)
+{
+    /*
+     * Framerate only sets how often item is ticked, animation always plays at it's own speed.
+     * Frame clock reads framerate on every display frame, so new value is applied on the next tick.
+     */
+    m_frameRate = qMax(1, frameRate);
 
-    m_renderTimer.start();
+    emit frameRateChanged(m_frameRate);
 }
 
 ///
@@ -36,14 +39,23 @@ PWLottieItem::PWLottieItem()
 ///
 void PWLottieItem::setSourceSize(const QSizeF& sourceSize)
 {
+    /*
+     * Frame images are reallocated with new size right before rendering in them,
+     * so frame that is rendering now and frame that is shown now stay untouched.
+     */
     m_sourceSize = sourceSize;
     emit sourceSizeChanged();
 
-    /* Locate memory for frame pixels */
-    m_frameBuffer.reset(new char[static_cast<qint32>(m_sourceSize.height() * m_sourceSize.width() * lottieRgbFormatSize / lottieRgbChannelSize)]);
+    /* Frame of old size isn't shown, the next one is rendered in new size right away */
+    m_renderQueue->cancel();
+
+    /* Cost of rendering depends on size, so controllers recalculate framerate */
+    updateLottieItemInfo();
+
+    updateSpriteSheet();
 
     /* Start rendering */
-    this->render();
+    updateFrameClockRegistration();
 }
 
 ///
@@ -52,75 +64,454 @@ void PWLottieItem::setSourceSize(const QSizeF& sourceSize)
 ///
 void PWLottieItem::setController(const PWControllerMediator::ControllerType controllerType)
 {
-    if (controllerType != PWControllerMediator::ControllerType::NoController) {
-        /* Set controller if we haven't set it before */
-        m_controllerType = controllerType;
+    if (m_controllerType == controllerType) {
+        return;
+    }
 
-        /* Register lottie item in controller */
-        setFrameRate(PWControllerMediator::registerLottieAnimation(m_controllerType, m_lottieUuid));
+    /* Unregister item from previous controller */
+    if (m_controllerType != PWControllerMediator::ControllerType::NoController) {
+        PWControllerMediator::unregisterLottieAnimation(m_controllerType, m_lottieHandle);
+    }
 
-        /* If controller changed framerate, change it in lottie item */
-        connect(PWControllerMediator::instance(), &PWControllerMediator::fpsChanged, this, [=, this](const quint16 fps, const PWControllerMediator::ControllerType controllerType, const QString& lottieUuid) {
-            if (lottieUuid == allLottiesDefiner || lottieUuid == m_lottieUuid) {
-                setFrameRate(fps);
-            }
-        });
-    } else if (m_controllerType != PWControllerMediator::ControllerType::NoController) {
-        /* Change controller type if we set it before */
-        PWControllerMediator::unregisterLottieAnimation(m_controllerType, m_lottieUuid);
+    m_controllerType = controllerType;
 
-        m_controllerType = controllerType;
+    /* Register lottie item in controller, controller changes it's framerate through mediator by handle */
+    if (m_controllerType != PWControllerMediator::ControllerType::NoController) {
+        setFrameRate(PWControllerMediator::registerLottieAnimation(m_controllerType, lottieItemInfo()));
     }
 
+    /* Icons are played from sprite sheets */
+    updateSpriteSheet();
+
     emit controllerChanged();
 }
 
 ///
-/// \brief PWLottieItem::setSource - Functions sets source size and loads rlottie::Animation and it's properties/
+/// \brief PWLottieItem::setPriority - Function sets priority of lottie animation, controllers give more resources to items with higher priority.
+/// \param priority - Priority that will be installed.
+///
+void PWLottieItem::setPriority(const qreal priority)
+{
+    if (m_priority == priority) {
+        return;
+    }
+
+    m_priority = priority;
+
+    updateLottieItemInfo();
+
+    emit priorityChanged();
+}
+
+///
+/// \brief PWLottieItem::lottieItemInfo - Function gets properties of item that controllers use.
+/// \return Returns UUID, size on screen in pixels and priority of item, culled item has empty size.
+///
+PWLottieItemInfo PWLottieItem::lottieItemInfo() const
+{
+    /* Controllers share work by pixels that reach the screen, item that can't be seen doesn't get any share */
+    if (m_culled) {
+        return { m_lottieHandle, QSize(0, 0), m_priority };
+    }
+
+    const qreal devicePixelRatio = window() ? window()->effectiveDevicePixelRatio() : 1.0;
+
+    return { m_lottieHandle, QSize(qCeil(width() * devicePixelRatio), qCeil(height() * devicePixelRatio)), m_priority };
+}
+
+///
+/// \brief PWLottieItem::updateLottieItemInfo - Function gives changed size, visibility or priority of item to it's controller.
+///
+void PWLottieItem::updateLottieItemInfo()
+{
+    if (m_controllerType != PWControllerMediator::ControllerType::NoController) {
+        PWControllerMediator::updateLottieAnimation(m_controllerType, lottieItemInfo());
+    }
+}
+
+///
+/// \brief PWLottieItem::setAutoRenderScale - Function sets whether resolution of rendered frames is lowered automatically when item is small, moving or system is overloaded.
+/// \param autoRenderScale - Automatic render scale state.
+///
+void PWLottieItem::setAutoRenderScale(const bool autoRenderScale)
+{
+    if (m_autoRenderScale == autoRenderScale) {
+        return;
+    }
+
+    m_autoRenderScale = autoRenderScale;
+    m_renderLevel = 0;
+
+    emit autoRenderScaleChanged();
+}
+
+///
+/// \brief PWLottieItem::setOutputFormat - Function sets pixel format of frames, it's applied from the next rendered frame.
+/// \param outputFormat - Output format that will be installed.
+///
+void PWLottieItem::setOutputFormat(const OutputFormat outputFormat)
+{
+    if (m_outputFormat == outputFormat) {
+        return;
+    }
+
+    m_outputFormat = outputFormat;
+
+    /* Frame that is rendering now has previous format */
+    m_renderQueue->cancel();
+
+    updateSpriteSheet();
+
+    emit outputFormatChanged();
+}
+
+///
+/// \brief PWLottieItem::setMaxRenderScale - Function sets the biggest scale of rendered frames relative to source size.
+/// \param maxRenderScale - Maximal render scale.
+///
+void PWLottieItem::setMaxRenderScale(const qreal maxRenderScale)
+{
+    if (m_maxRenderScale == maxRenderScale || maxRenderScale <= 0.0) {
+        return;
+    }
+
+    m_maxRenderScale = maxRenderScale;
+
+    updateSpriteSheet();
+
+    emit maxRenderScaleChanged();
+}
+
+///
+/// \brief PWLottieItem::updateRenderScale - Function selects scale of the next rendered frame by size of item on screen, it's motion and load of system.
+/// \return Returns size in which the next frame is rendered.
+///
+QSize PWLottieItem::updateRenderScale()
+{
+    qreal renderScale = qMin<qreal>(1.0, m_maxRenderScale);
+
+    if (m_autoRenderScale) {
+        const qreal devicePixelRatio = window() ? window()->effectiveDevicePixelRatio() : 1.0;
+
+        /* Idle item is rendered in full resolution of screen, but never bigger than it's shown */
+        const qreal screenScale = qMin(width() / m_sourceSize.width(), height() / m_sourceSize.height());
+        renderScale = qMin(m_maxRenderScale, devicePixelRatio * qMin<qreal>(1.0, screenScale));
+
+        /* Item that moves fast, like delegate of scrolling view, doesn't need all details */
+        const QPointF scenePosition = mapToScene(QPointF(0, 0));
+        const qint64 motionTime = m_motionTimer.isValid() ? m_motionTimer.restart() : 0;
+        const bool moving = motionTime > 0 && QLineF(scenePosition, m_lastScenePosition).length() * 1000 / motionTime > fastMotionVelocity;
+
+        if (!m_motionTimer.isValid()) {
+            m_motionTimer.start();
+        }
+
+        m_lastScenePosition = scenePosition;
+
+        /* System is overloaded when item can't render it's frames in time or display frames come late */
+        const bool overloaded = m_lastRenderTime * m_frameRate > qint64(1000000000) * 3 / 4 || PWLottieFrameClock::instance()->displayFrameInterval() > overloadedDisplayFrameInterval;
+
+        const qint32 renderLevel = overloaded ? renderLevelsCount - 1 : moving ? 1 : 0;
+
+        /* Resolution is lowered right away, but it's restored only after item stays calm for a while */
+        if (renderLevel >= m_renderLevel || !m_renderLevelTimer.isValid()) {
+            m_renderLevel = qMax(m_renderLevel, renderLevel);
+            m_renderLevelTimer.start();
+        } else if (m_renderLevelTimer.elapsed() > renderLevelRestoreDelay) {
+            m_renderLevel -= 1;
+            m_renderLevelTimer.start();
+        }
+
+        /* Every level halves count of pixels */
+        renderScale *= qPow(M_SQRT1_2, m_renderLevel);
+    }
+
+    if (m_renderScale != renderScale) {
+        m_renderScale = renderScale;
+
+        emit renderScaleChanged();
+    }
+
+    return QSize(qMax(1, qRound(m_sourceSize.width() * m_renderScale)), qMax(1, qRound(m_sourceSize.height() * m_renderScale)));
+}
+
+///
+/// \brief PWLottieItem::frameOutputSize - Function gets size of shown frame, own frames are downscaled when they are rendered much bigger than item is shown.
+/// \param frameSize - Size in which frame is rendered.
+/// \return Returns size of frame image.
+///
+QSize PWLottieItem::frameOutputSize(const QSize& frameSize) const
+{
+    /* Shared frames are shown by items of different sizes, so they are kept in render size */
+    if (PWLottieFrameCache::instance()->isShared(m_model->contentHash(), frameSize, frameFormat())) {
+        return frameSize;
+    }
+
+    const qreal devicePixelRatio = window() ? window()->effectiveDevicePixelRatio() : 1.0;
+
+    return PWLottiePixels::downscaledSize(frameSize, QSize(qCeil(width() * devicePixelRatio), qCeil(height() * devicePixelRatio)));
+}
+
+///
+/// \brief PWLottieItem::frameFormat - Function gets image format of frames for output format of item.
+/// \return Returns format of frame images.
+///
+QImage::Format PWLottieItem::frameFormat() const
+{
+    switch (m_outputFormat) {
+    case OutputFormat::RGBA8888Premultiplied:
+        return QImage::Format_RGBA8888_Premultiplied;
+    case OutputFormat::ARGB32:
+        return QImage::Format_ARGB32;
+    case OutputFormat::RGBA8888:
+        return QImage::Format_RGBA8888;
+    default:
+        return QImage::Format_ARGB32_Premultiplied;
+    }
+}
+
+///
+/// \brief PWLottieItem::setSource - Functions sets source and loads model of lottie animation and it's properties, in render scheduler if item is asynchronous.
 /// \param source - Source of image that will be applied for item.
 ///
 void PWLottieItem::setSource(const QString& source)
 {
-    QFile lottieFile(source);
-    if (lottieFile.open(QFile::ReadOnly)) {
-        const QByteArray lottieBuffer = lottieFile.readAll();
+    if (m_source == source && m_status != Status::Error) {
+        return;
+    }
 
-        if (!lottieBuffer.isEmpty()) {
-            /* Create lottie animation */
-            m_animation = rlottie::Animation::loadFromData(lottieBuffer.constData(), QUrl(source).fileName().toStdString(), QCoreApplication::applicationDirPath().toUtf8().constData());
+    m_source = source;
+    emit sourceChanged();
 
-            if (m_animation) {
-                /* Set up lottie animation properties */
-                m_source = source;
-                m_totalFrames = m_animation->totalFrame();
-                m_duration = m_animation->duration();
+    /* Results of previous loading are ignored, frames of previous source aren't rendered */
+    m_sourceVersion += 1;
+    m_renderQueue->cancel();
 
-                /* Emit that state of PWLottieItem was changed */
-                emit sourceChanged();
+    if (m_source.isEmpty()) {
+        applyModel(nullptr);
 
-                return;
-            }
+        return;
+    }
+
+    /* Model that is already cached is applied without any I/O, so item is ready right away */
+    std::shared_ptr<const PWLottieModel> model = PWLottieCache::instance()->cachedModel(m_source);
+
+    if (model || !m_asynchronous) {
+        PWLottieTrace::Span loadSpan("load", m_lottieHandle);
+
+        applyModel(model ? std::move(model) : PWLottieCache::instance()->model(m_source));
+
+        return;
+    }
+
+    setProgress(0.0);
+    setStatus(Status::Loading);
+
+    /*
+     * Read and parse source in render scheduler. Item can be deleted while source is loading,
+     * so results are delivered through application object and item is checked in GUI thread.
+     */
+    const QPointer<PWLottieItem> lottieItem(this);
+    const quint64 sourceVersion = m_sourceVersion;
+    const PWLottieHandle lottieHandle = m_lottieHandle;
+
+    PWLottieRenderScheduler::instance()->submit([lottieItem, sourceVersion, source, lottieHandle]() {
+        PWLottieTrace::Span loadSpan("load", lottieHandle);
+
+        std::shared_ptr<const PWLottieModel> model = PWLottieCache::instance()->model(source, [lottieItem, sourceVersion](const qreal progress) {
+            QMetaObject::invokeMethod(
+                QCoreApplication::instance(), [lottieItem, sourceVersion, progress]() {
+                    if (lottieItem && lottieItem->m_sourceVersion == sourceVersion) {
+                        lottieItem->setProgress(progress);
+                    }
+                },
+                Qt::QueuedConnection);
+        });
+
+        QMetaObject::invokeMethod(
+            QCoreApplication::instance(), [lottieItem, sourceVersion, model]() {
+                if (lottieItem && lottieItem->m_sourceVersion == sourceVersion) {
+                    lottieItem->applyModel(model);
+                }
+            },
+            Qt::QueuedConnection);
+    });
+}
+
+///
+/// \brief PWLottieItem::applyModel - Function applies loaded model of lottie animation and starts rendering.
+/// \param model - Loaded model or nullptr if source couldn't be loaded.
+///
+void PWLottieItem::applyModel(std::shared_ptr<const PWLottieModel> model)
+{
+    /* Frames of previous animation are dropped */
+    m_renderQueue->cancel();
+
+    if (!model) {
+        /* Nothing to render, item shows nothing */
+        m_model = nullptr;
+        m_totalFrames = 0;
+        m_duration = 0.0;
+        m_frontFrameIndex = -1;
+        m_showSprite = false;
+
+        updateSpriteSheet();
+        updateFrameClockRegistration();
+        update();
+
+        emit durationChanged();
+
+        if (m_source.isEmpty()) {
+            setProgress(0.0);
+            setStatus(Status::Null);
+        } else {
+            setStatus(Status::Error);
+
+            emit errorOccured();
         }
-    } else {
-        qWarning() << "Couldn't open lottie file with error:" << lottieFile.errorString();
+
+        return;
     }
 
-    emit errorOccured();
+    /* Set up lottie animation properties */
+    m_model = std::move(model);
+    m_totalFrames = m_model->totalFrames();
+    m_duration = m_model->duration();
+
+    /* Play new animation from the beginning */
+    m_playbackPosition = 0.0;
+    m_lastFramePosition = -1;
+
+    /* Frame of previous animation mustn't be taken as already shown */
+    m_currentFrame = -1;
+
+    if (m_playbackTimer.isValid()) {
+        m_playbackTimer.restart();
+    }
+
+    emit durationChanged();
+
+    updateSpriteSheet();
+
+    setProgress(1.0);
+    setStatus(Status::Ready);
+
+    /* Start rendering */
+    updateFrameClockRegistration();
+}
+
+///
+/// \brief PWLottieItem::setStatus - Function sets loading status of source.
+/// \param status - Status that will be installed.
+///
+void PWLottieItem::setStatus(const Status status)
+{
+    if (m_status != status) {
+        m_status = status;
+
+        emit statusChanged();
+    }
 }
 
 ///
-/// \brief PWLottieItem::paint - Overrided QQuickPaintedItem function 'paint'. It paints image in qml.
-/// \param painter - Rendering device.
+/// \brief PWLottieItem::setProgress - Function sets loading progress of source.
+/// \param progress - Progress from '0.0' to '1.0'.
 ///
-void PWLottieItem::paint(QPainter* painter)
+void PWLottieItem::setProgress(const qreal progress)
 {
-    if (!painter) {
+    if (m_progress != progress) {
+        m_progress = progress;
+
+        emit progressChanged(m_progress);
+    }
+}
+
+///
+/// \brief PWLottieItem::updateFrameClockRegistration - Function registers item in PWLottieFrameClock when it can be rendered and unregisters it otherwise.
+///
+void PWLottieItem::updateFrameClockRegistration()
+{
+    const bool needsFrameClock = m_running && m_model && !m_sourceSize.isEmpty();
+
+    if (needsFrameClock == m_frameClockRegistered) {
         return;
     }
 
-    if (!m_currentImage.isNull()) {
-        painter->drawImage(this->boundingRect(), m_currentImage);
+    m_frameClockRegistered = needsFrameClock;
+
+    if (m_frameClockRegistered) {
+        /* Continue playback from the position where it was stopped */
+        m_playbackTimer.start();
+
+        PWLottieFrameClock::instance()->registerLottieItem(this);
+    } else {
+        m_playbackPosition = playbackPosition();
+        m_playbackTimer.invalidate();
+
+        PWLottieFrameClock::instance()->unregisterLottieItem(this);
+
+        /* Item that doesn't render doesn't need shared frames and frames that aren't shown */
+        updateFrameCacheUser(QByteArray(), QSize(), QImage::Format_Invalid);
+        releaseFrameImages();
+    }
+}
+
+///
+/// \brief PWLottieItem::updatePaintNode - Overrided QQuickItem function 'updatePaintNode'. It hands rendered frame to scene graph as texture.
+/// \param oldNode - Node that was returned on previous call.
+/// \param updatePaintNodeData - Transformation data of item.
+/// \return Returns node that shows current frame.
+///
+QSGNode* PWLottieItem::updatePaintNode(QSGNode* oldNode, UpdatePaintNodeData* updatePaintNodeData)
+{
+    Q_UNUSED(updatePaintNodeData)
+
+    QSGImageNode* imageNode = static_cast<QSGImageNode*>(oldNode);
+
+    if ((m_frontFrameIndex < 0 && !m_showSprite) || boundingRect().isEmpty()) {
+        delete imageNode;
+        m_pinnedFrameIndex = -1;
+
+        return nullptr;
+    }
+
+    if (!imageNode) {
+        imageNode = window()->createImageNode();
+        imageNode->setOwnsTexture(true);
+
+        m_frameDirty = true;
+    }
+
+    /* Texture only wraps image here, scene graph uploads it later while rendering, so span measures creation of texture */
+    if (m_frameDirty && m_showSprite) {
+        PWLottieTrace::Span textureSpan("textureCreate", m_lottieHandle);
+
+        /* Texture of sprite sheet is shared by all items in window and owned by sheet, frames are switched only by source rect */
+        imageNode->setTexture(m_spriteSheet->texture(window()));
+        imageNode->setOwnsTexture(false);
+
+        m_pinnedFrameIndex = -1;
+        m_frameDirty = false;
+    } else if (m_frameDirty) {
+        PWLottieTrace::Span textureSpan("textureCreate", m_lottieHandle);
+
+        /*
+         * Texture is created straight from rendered frame, without QPainter pass.
+         * Frame image stays pinned until the next sync, so it's not rendered in while being uploaded.
+         */
+        imageNode->setTexture(window()->createTextureFromImage(m_frameImages[m_frontFrameIndex]));
+        imageNode->setOwnsTexture(true);
+
+        m_pinnedFrameIndex = m_frontFrameIndex;
+        m_frameDirty = false;
     }
+
+    /* Empty source rect shows the whole texture */
+    imageNode->setSourceRect(m_showSprite ? m_spriteSheet->frameRect(m_currentFrame) : QRectF());
+    imageNode->setRect(boundingRect());
+    imageNode->setFiltering(smooth() ? QSGTexture::Linear : QSGTexture::Nearest);
+
+    return imageNode;
 }
 
 ///
@@ -128,51 +519,640 @@ void PWLottieItem::paint(QPainter* painter)
 ///
 void PWLottieItem::render()
 {
-    if (m_running && !m_source.isEmpty() && !m_sourceSize.isEmpty()) {
-        QtConcurrent::run(&m_renderThreadPool, [&]() {
-            /* Render lottie animation in synchronus function, because we making it asynchronus with Qt */
-            rlottie::Surface surface(reinterpret_cast<uint32_t*>(m_frameBuffer.data()), qRound(m_sourceSize.width()), qRound(m_sourceSize.height()), qRound(m_sourceSize.width()) * lottieRgbFormatSize / lottieRgbChannelSize);
-            m_animation->renderSync(m_currentFrame, surface);
-
-            /* If total frames more than we have, reset */
-            if (m_currentFrame >= m_totalFrames) {
-                m_currentFrame = 0;
-            } else {
-                m_currentFrame += 1;
-            }
+    if (!m_running || !m_model || m_sourceSize.isEmpty() || m_totalFrames <= 0 || m_duration <= 0.0) {
+        return;
+    }
 
-            /* Create new image that will be painted */
-            QImage image(m_sourceSize.width(), m_sourceSize.height(), QImage::Format_RGB32);
+    /* Item that can't be seen isn't rendered, playback time keeps running and frame is picked by it when item is shown again */
+    updateCulling();
 
-            for (qint32 i = 0; i != image.height(); ++i) {
-                /* Get pixel data from buffer that was rendered with rlottie */
-                const char* pixel = m_frameBuffer.data() + i * image.bytesPerLine();
+    if (m_culled) {
+        return;
+    }
 
-                if (pixel) {
-                    /* Copy pixel data to image */
-                    std::memcpy(image.scanLine(i), pixel, image.bytesPerLine());
-                }
+    /* Scheduling latency is measured from the first tick that wasn't served yet */
+    const qint64 tickTime = PWLottieStats::isEnabled() ? PWLottieStats::timestamp() : -1;
+
+    /*
+     * Only one frame of item is rendered at a time. Ticks that come while
+     * frame is rendering are folded in one, and the latest frame is rendered
+     * right after the current one is ready.
+     */
+    if (m_renderInFlight) {
+        if (!m_renderPending) {
+            m_pendingTickTime = tickTime;
+        }
+
+        m_coalescedFrames += 1;
+        m_renderPending = true;
+
+        return;
+    }
+
+    /*
+     * Select frame by wall-clock time and native framerate of animation, so lower
+     * framerate of item or slow rendering skips frames instead of slowing down animation.
+     */
+    const qreal position = playbackPosition();
+    const qint64 loop = qFloor(position / m_duration);
+    const qint64 framePosition = loop * m_totalFrames + qMin<qint64>(qFloor((position - loop * m_duration) * m_model->frameRate()), m_totalFrames - 1);
+
+    /* Frames that item skips cause of it's own lower framerate aren't dropped */
+    const qint64 frameStep = qMax<qint64>(1, qCeil(m_model->frameRate() / m_frameRate));
+
+    if (m_lastFramePosition >= 0 && framePosition > m_lastFramePosition + frameStep) {
+        m_droppedFrames += framePosition - m_lastFramePosition - frameStep;
+    }
+
+    m_lastFramePosition = framePosition;
+
+    /* Check for animation loops, finished animation stays on it's last frame */
+    const bool finished = m_loops > 0 && framePosition >= qint64(m_loops) * m_totalFrames;
+    const QSize frameSize = updateRenderScale();
+    const qint32 frame = m_model->canonicalFrame(finished ? m_totalFrames - 1 : qint32(framePosition % m_totalFrames), frameSize);
+    const QSize outputSize = frameOutputSize(frameSize);
+
+    /*
+     * Item that is ticked faster than animation changes, or that plays a hold
+     * of identical frames, shows the same frame. It isn't rendered and uploaded again.
+     */
+    if (isFrameShown(frame, outputSize)) {
+        m_skippedFrames += 1;
+        m_renderPending = false;
+
+        if (finished) {
+            pause();
+        }
+
+        return;
+    }
+
+    /* Frame of icon is only picked from ready sprite sheet, without any rendering */
+    if (m_spriteSheet && m_spriteSheet->isReady()) {
+        updateFrameCacheUser(QByteArray(), QSize(), QImage::Format_Invalid);
+
+        m_currentFrame = frame;
+        m_renderedFrames += 1;
+
+        if (!m_showSprite) {
+            m_showSprite = true;
+            m_frameDirty = true;
+        }
+
+        update();
+
+        if (finished) {
+            pause();
+        }
+
+        return;
+    }
+
+    /* Register item as user of this model in this size and format, so identical items share rendered frames */
+    updateFrameCacheUser(m_model->contentHash(), frameSize, frameFormat());
+
+    m_renderTickTime = m_renderPending ? m_pendingTickTime : tickTime;
+    m_renderInFlight = true;
+    m_renderPending = false;
+
+    if (PWLottieFrameCache::instance()->isShared(m_model->contentHash(), frameSize, frameFormat())) {
+        renderSharedFrame(frame, frameSize, finished);
+    } else {
+        renderOwnFrame(frame, frameSize, outputSize, finished);
+    }
+}
+
+///
+/// \brief PWLottieItem::renderOwnFrame - Function renders frame in item's own frame image.
+/// \param frame - Frame of animation.
+/// \param frameSize - Size in which frame is rendered.
+/// \param outputSize - Size to which frame is downscaled.
+/// \param finished - Whether it's the last frame of the last loop.
+///
+void PWLottieItem::renderOwnFrame(const qint32 frame, const QSize& frameSize, const QSize& outputSize, const bool finished)
+{
+    /* Render in the frame image that isn't shown and isn't uploaded now, reallocate it only if size or format was changed */
+    qint32 backFrameIndex = 0;
+
+    while (backFrameIndex == m_frontFrameIndex || backFrameIndex == m_pinnedFrameIndex) {
+        backFrameIndex += 1;
+    }
+
+    const QImage::Format format = frameFormat();
+
+    if (m_frameImages[backFrameIndex].size() != outputSize || m_frameImages[backFrameIndex].format() != format) {
+        /* Buffer of previous image goes back to pool and is reused by any item */
+        m_frameImages[backFrameIndex] = PWLottieBufferPool::instance()->image(outputSize, format);
+        m_frameBits[backFrameIndex] = m_frameImages[backFrameIndex].bits();
+    }
+
+    m_renderingFrameIndex = backFrameIndex;
+
+    /*
+     * Job keeps a copy of frame image only to keep it's buffer alive, if item is deleted or reallocates
+     * image while frame is rendering. Pixels are written through pointer, so the copy never detaches.
+     */
+    const QImage frameImage = m_frameImages[backFrameIndex];
+    uchar* const frameBits = m_frameBits[backFrameIndex];
+    const qsizetype bytesPerLine = frameImage.bytesPerLine();
+
+    const QPointer<PWLottieItem> lottieItem(this);
+    const PWLottieRenderScheduler::RenderQueuePtr renderQueue = m_renderQueue;
+    const quint64 renderVersion = m_renderQueue->version;
+    const PWLottieHandle lottieHandle = m_lottieHandle;
+    const qint64 submitTime = PWLottieTrace::isEnabled() ? PWLottieStats::timestamp() : -1;
+
+    /* Frames of one item are rendered in order, while different items share worker threads */
+    PWLottieRenderScheduler::instance()->submit(m_renderQueue, [lottieItem, renderQueue, renderVersion, model = m_model, frameImage, frame, frameSize, outputSize, format, frameBits, bytesPerLine, backFrameIndex, finished, lottieHandle, submitTime]() {
+        PWLottieTrace::span("queueWait", submitTime, lottieHandle);
+
+        /* Frame of old source, size or format, or of deleted item, is dropped before rendering */
+        if (renderQueue->isStale(renderVersion)) {
+            QMetaObject::invokeMethod(
+                QCoreApplication::instance(), [lottieItem, frame, backFrameIndex, finished, renderVersion]() {
+                    if (lottieItem) {
+                        lottieItem->finishRender(backFrameIndex, frame, finished, 0, renderVersion);
+                    }
+                },
+                Qt::QueuedConnection);
+
+            return;
+        }
+
+        QElapsedTimer renderTimer;
+        renderTimer.start();
+
+        /* Render lottie animation straight into the pixels of frame image, frame that is downscaled is rendered in temporary buffer */
+        QImage renderImage;
+        uchar* renderBits = frameBits;
+        qsizetype renderBytesPerLine = bytesPerLine;
+
+        if (outputSize != frameSize) {
+            renderImage = PWLottieBufferPool::instance()->image(frameSize, QImage::Format_ARGB32_Premultiplied);
+            renderBits = renderImage.bits();
+            renderBytesPerLine = renderImage.bytesPerLine();
+        }
+
+        {
+            PWLottieTrace::Span renderSpan("renderSync", lottieHandle, frame);
+
+            model->render(frame, rlottie::Surface(reinterpret_cast<uint32_t*>(renderBits), frameSize.width(), frameSize.height(), renderBytesPerLine));
+        }
+
+        /* rlottie renders premultiplied ARGB32, other formats are converted in place */
+        if (outputSize != frameSize || format != QImage::Format_ARGB32_Premultiplied) {
+            PWLottieTrace::Span convertSpan("convert", lottieHandle, frame);
+
+            if (outputSize != frameSize) {
+                PWLottiePixels::downscale(renderBits, renderBytesPerLine, frameSize, frameBits, bytesPerLine, outputSize);
             }
 
-            /*
-             * Cause we making, multi thread rendering,
-             * save rendered image in buffer and read it,
-             * when we need to paint it.
-             */
-            m_currentImage = image;
-        }).then(this, [this] {
-            /* Before starting new thread check for animation loops */
-            if (m_loops > 0) {
-                if (m_loops - 1 == m_currentLoops && m_totalFrames == m_currentFrame) {
-                    /* Stop animation */
-                    pause();
-                } else if (m_totalFrames == m_currentFrame) {
-                    /* If user haven't infinite loop, plus on more loop */
-                    m_currentLoops += 1;
+            PWLottiePixels::convert(frameBits, bytesPerLine, outputSize, format);
+        }
+
+        const qint64 renderTime = renderTimer.nsecsElapsed();
+
+        /* Return to GUI thread, item can be deleted while frame is rendering, so it's checked there */
+        QMetaObject::invokeMethod(
+            QCoreApplication::instance(), [lottieItem, frame, backFrameIndex, finished, renderTime, renderVersion]() {
+                if (lottieItem) {
+                    lottieItem->finishRender(backFrameIndex, frame, finished, renderTime, renderVersion);
                 }
-            }
+            },
+            Qt::QueuedConnection);
+    });
+}
+
+///
+/// \brief PWLottieItem::renderSharedFrame - Function takes frame from PWLottieFrameCache, it's rendered only by the first item that needs it.
+/// \param frame - Frame of animation.
+/// \param frameSize - Size in which frame is rendered.
+/// \param finished - Whether it's the last frame of the last loop.
+///
+void PWLottieItem::renderSharedFrame(const qint32 frame, const QSize& frameSize, const bool finished)
+{
+    const PWLottieFrameKey frameKey = { m_model->contentHash(), frameSize, frame, frameFormat() };
+    const QPointer<PWLottieItem> lottieItem(this);
+    const PWLottieRenderScheduler::RenderQueuePtr renderQueue = m_renderQueue;
+    const quint64 renderVersion = m_renderQueue->version;
+    const PWLottieHandle lottieHandle = m_lottieHandle;
+    const qint64 submitTime = PWLottieTrace::isEnabled() ? PWLottieStats::timestamp() : -1;
+
+    PWLottieRenderScheduler::instance()->submit(m_renderQueue, [lottieItem, renderQueue, renderVersion, model = m_model, frameKey, finished, lottieHandle, submitTime]() {
+        PWLottieTrace::span("queueWait", submitTime, lottieHandle);
+
+        /* Stale frame isn't taken from frame cache, so it's not rendered there for nobody */
+        if (renderQueue->isStale(renderVersion)) {
+            QMetaObject::invokeMethod(
+                QCoreApplication::instance(), [lottieItem, frameKey, finished, renderVersion]() {
+                    if (lottieItem) {
+                        lottieItem->finishRender(sharedFrameImageIndex, frameKey.frame, finished, 0, renderVersion);
+                    }
+                },
+                Qt::QueuedConnection);
 
-            update();
+            return;
+        }
+
+        /* Only rendering is measured, frame that was rendered by another item or waited for in frame cache costs this item nothing */
+        qint64 renderTime = 0;
+
+        PWLottieTrace::Span frameCacheSpan("sharedFrame", lottieHandle, frameKey.frame);
+
+        const QImage frameImage = PWLottieFrameCache::instance()->frame(frameKey, [&model, &frameKey, &renderTime, lottieHandle]() {
+            PWLottieTrace::Span renderSpan("renderSync", lottieHandle, frameKey.frame);
+
+            QElapsedTimer renderTimer;
+            renderTimer.start();
+
+            /* Shared frames are never modified after rendering, so each of them gets it's own image */
+            QImage renderedImage = PWLottieBufferPool::instance()->image(frameKey.size, frameKey.format);
+
+            model->render(frameKey.frame, rlottie::Surface(reinterpret_cast<uint32_t*>(renderedImage.bits()), frameKey.size.width(), frameKey.size.height(), renderedImage.bytesPerLine()));
+
+            PWLottiePixels::convert(renderedImage.bits(), renderedImage.bytesPerLine(), frameKey.size, frameKey.format);
+
+            renderTime = renderTimer.nsecsElapsed();
+
+            return renderedImage;
         });
+
+        /* Return to GUI thread, item can be deleted while frame is rendering, so it's checked there */
+        QMetaObject::invokeMethod(
+            QCoreApplication::instance(), [lottieItem, frameImage, frameKey, finished, renderTime, renderVersion]() {
+                if (!lottieItem) {
+                    return;
+                }
+
+                /* Shared frame of stale request doesn't replace the shown one */
+                if (!lottieItem->m_renderQueue->isStale(renderVersion)) {
+                    lottieItem->m_frameImages[sharedFrameImageIndex] = frameImage;
+                }
+
+                lottieItem->finishRender(sharedFrameImageIndex, frameKey.frame, finished, renderTime, renderVersion);
+            },
+            Qt::QueuedConnection);
+    });
+}
+
+///
+/// \brief PWLottieItem::finishRender - Function shows rendered frame, it's called in GUI thread when rendering is finished.
+/// \param frameImageIndex - Index of frame image with rendered frame.
+/// \param frame - Rendered frame of animation.
+/// \param finished - Whether it's the last frame of the last loop.
+/// \param renderTime - Time of rendering in nanoseconds.
+/// \param renderVersion - Version of render queue when frame was submitted.
+///
+void PWLottieItem::finishRender(const qint32 frameImageIndex, const qint32 frame, const bool finished, const qint64 renderTime, const quint64 renderVersion)
+{
+    m_renderInFlight = false;
+    m_renderingFrameIndex = -1;
+
+    /* Stale frame is dropped without showing it, the latest tick is rendered instead */
+    if (m_renderQueue->isStale(renderVersion)) {
+        m_cancelledFrames += 1;
+
+        if (m_renderPending) {
+            render();
+        }
+
+        return;
+    }
+
+    m_currentFrame = frame;
+    m_lastRenderTime = renderTime;
+    m_renderedFrames += 1;
+
+    if (PWLottieStats::isEnabled()) {
+        m_renderTimeSamples.add(renderTime);
+
+        if (m_renderTickTime >= 0) {
+            m_schedulingLatencySamples.add(PWLottieStats::timestamp() - m_renderTickTime);
+        }
+    }
+
+    /* Controllers that adapt framerate need to know how expensive item is */
+    if (m_controllerType != PWControllerMediator::ControllerType::NoController) {
+        PWControllerMediator::reportRenderTime(m_controllerType, m_lottieHandle, renderTime);
+    }
+
+    /* Swap frame images, rendered frame will be uploaded on the next sync */
+    m_frontFrameIndex = frameImageIndex;
+    m_showSprite = false;
+    m_frameDirty = true;
+
+    update();
+
+    /* Stop animation after the last loop */
+    if (finished) {
+        pause();
+    } else if (m_renderPending) {
+        render();
+    }
+}
+
+///
+/// \brief PWLottieItem::releaseFrameImages - Function gives buffers of frames that aren't shown back to PWLottieBufferPool.
+///
+void PWLottieItem::releaseFrameImages()
+{
+    /* Shown frame stays on screen, frame that is rendering now is still written by worker */
+    for (qint32 frameImageIndex = 0; frameImageIndex < frameImagesCount + 1; ++frameImageIndex) {
+        if (frameImageIndex == m_frontFrameIndex || frameImageIndex == m_renderingFrameIndex) {
+            continue;
+        }
+
+        m_frameImages[frameImageIndex] = QImage();
+
+        if (frameImageIndex < frameImagesCount) {
+            m_frameBits[frameImageIndex] = nullptr;
+        }
+    }
+}
+
+///
+/// \brief PWLottieItem::updateFrameCacheUser - Function registers item in PWLottieFrameCache as user of model in the given size.
+/// \param contentHash - Content hash of model, empty to unregister item.
+/// \param frameSize - Size in which model is rendered.
+/// \param frameFormat - Pixel format of frames.
+///
+void PWLottieItem::updateFrameCacheUser(const QByteArray& contentHash, const QSize& frameSize, const QImage::Format frameFormat)
+{
+    if (m_frameCacheContentHash == contentHash && m_frameCacheSize == frameSize && m_frameCacheFormat == frameFormat) {
+        return;
+    }
+
+    if (!m_frameCacheContentHash.isEmpty()) {
+        PWLottieFrameCache::instance()->removeUser(m_frameCacheContentHash, m_frameCacheSize, m_frameCacheFormat);
+    }
+
+    m_frameCacheContentHash = contentHash;
+    m_frameCacheSize = frameSize;
+    m_frameCacheFormat = frameFormat;
+
+    if (!m_frameCacheContentHash.isEmpty()) {
+        PWLottieFrameCache::instance()->addUser(m_frameCacheContentHash, m_frameCacheSize, m_frameCacheFormat);
+    }
+}
+
+///
+/// \brief PWLottieItem::updateSpriteSheet - Function requests sprite sheet from icon controller when item is an icon and releases it otherwise.
+///
+void PWLottieItem::updateSpriteSheet()
+{
+    const bool needsSpriteSheet = m_controllerType == PWControllerMediator::ControllerType::IconController && m_model && !m_sourceSize.toSize().isEmpty();
+    const QSize frameSize = spriteSheetFrameSize();
+
+    if (needsSpriteSheet && m_spriteSheet && m_spriteSheet->contentHash() == m_model->contentHash() && m_spriteSheet->frameSize() == frameSize && m_spriteSheet->format() == frameFormat()) {
+        return;
+    }
+
+    if (!needsSpriteSheet && !m_spriteSheet) {
+        return;
+    }
+
+    /* Live frames are shown until new sheet is ready */
+    m_spriteSheet = nullptr;
+    m_showSprite = false;
+    m_frameDirty = true;
+
+    if (needsSpriteSheet) {
+        m_spriteSheet = PWControllerMediator::iconController()->spriteSheet(m_model, m_sourceSize.toSize(), frameSize, frameFormat());
+    } else {
+        PWControllerMediator::iconController()->evictUnusedSpriteSheets();
+    }
+
+    update();
+}
+
+///
+/// \brief PWLottieItem::spriteSheetFrameSize - Function gets size of frames in sprite sheet, it's source size in pixels of screen.
+/// \return Returns size of one frame of sheet.
+///
+QSize PWLottieItem::spriteSheetFrameSize() const
+{
+    const qreal devicePixelRatio = window() ? window()->effectiveDevicePixelRatio() : 1.0;
+    const qreal renderScale = qMin(m_maxRenderScale, devicePixelRatio);
+
+    return QSize(qMax(1, qRound(m_sourceSize.width() * renderScale)), qMax(1, qRound(m_sourceSize.height() * renderScale)));
+}
+
+///
+/// \brief PWLottieItem::isEffectivelyVisible - Function checks if item can be seen: it's visible, not transparent, it's window is exposed and it's inside of clipping parents and window.
+/// \return Returns true if item can be seen.
+///
+bool PWLottieItem::isEffectivelyVisible() const
+{
+    const QQuickWindow* const quickWindow = window();
+
+    if (!isVisible() || !quickWindow || !quickWindow->isExposed() || quickWindow->visibility() == QWindow::Minimized) {
+        return false;
+    }
+
+    /* Item is visible only in the part of scene that isn't clipped by parents, like views that are scrolled */
+    QRectF visibleRect = mapRectToScene(boundingRect()).intersected(QRectF(QPointF(0, 0), quickWindow->size()));
+    qreal effectiveOpacity = opacity();
+
+    for (const QQuickItem* parent = parentItem(); parent && !visibleRect.isEmpty() && effectiveOpacity > 0.0; parent = parent->parentItem()) {
+        effectiveOpacity *= parent->opacity();
+
+        if (parent->clip()) {
+            visibleRect = visibleRect.intersected(parent->mapRectToScene(parent->boundingRect()));
+        }
+    }
+
+    return !visibleRect.isEmpty() && effectiveOpacity > 0.0;
+}
+
+///
+/// \brief PWLottieItem::updateCulling - Function culls item that can't be seen and unculls it when it can be seen again.
+///
+void PWLottieItem::updateCulling()
+{
+    const bool culled = !isEffectivelyVisible();
+
+    if (m_culled == culled) {
+        return;
+    }
+
+    m_culled = culled;
+
+    if (m_culled) {
+        /* Frame that is rendering for item that can't be seen isn't shown */
+        m_renderQueue->cancel();
+
+        /* Culled item doesn't need shared frames and frames that aren't shown */
+        updateFrameCacheUser(QByteArray(), QSize(), QImage::Format_Invalid);
+        releaseFrameImages();
+    } else {
+        /* Frames that were skipped while item was culled aren't dropped frames */
+        m_lastFramePosition = -1;
+    }
+
+    updateLottieItemInfo();
+}
+
+///
+/// \brief PWLottieItem::checkCulling - Function updates culling right away and renders current frame of item that can be seen again.
+///
+void PWLottieItem::checkCulling()
+{
+    const bool culled = m_culled;
+    updateCulling();
+
+    /* Item that was shown gets it's current frame right away, without waiting for frame clock */
+    if (culled && !m_culled) {
+        render();
+    }
+}
+
+///
+/// \brief PWLottieItem::updateAncestorConnections - Function follows moves, resizes and clipping of parents, that change visible part of item without any change of item itself.
+///
+void PWLottieItem::updateAncestorConnections()
+{
+    for (const QMetaObject::Connection& connection : std::as_const(m_ancestorConnections)) {
+        disconnect(connection);
+    }
+
+    m_ancestorConnections.clear();
+
+    /* Item outside of window is always culled, nothing of it's parents can change it */
+    if (!window()) {
+        return;
+    }
+
+    /*
+     * Flickable and views scroll by moving their content item, and clipping parent can be moved or resized itself,
+     * scene position or visible part of item changes then without any change of item. Such parents are followed,
+     * so item that is scrolled back in is shown right away instead of waiting for the next check of frame clock.
+     */
+    for (QQuickItem* parent = parentItem(); parent; parent = parent->parentItem()) {
+        m_ancestorConnections.append(connect(parent, &QQuickItem::xChanged, this, &PWLottieItem::checkCulling));
+        m_ancestorConnections.append(connect(parent, &QQuickItem::yChanged, this, &PWLottieItem::checkCulling));
+        m_ancestorConnections.append(connect(parent, &QQuickItem::widthChanged, this, &PWLottieItem::checkCulling));
+        m_ancestorConnections.append(connect(parent, &QQuickItem::heightChanged, this, &PWLottieItem::checkCulling));
+        m_ancestorConnections.append(connect(parent, &QQuickItem::clipChanged, this, &PWLottieItem::checkCulling));
+        m_ancestorConnections.append(connect(parent, &QQuickItem::opacityChanged, this, &PWLottieItem::checkCulling));
+
+        /* Chain of parents is followed again when one of them is moved to another parent */
+        m_ancestorConnections.append(connect(parent, &QQuickItem::parentChanged, this, [this]() {
+            updateAncestorConnections();
+            checkCulling();
+        }));
+    }
+}
+
+///
+/// \brief PWLottieItem::itemChange - Overrided QQuickItem function 'itemChange'. Item is checked for visibility right away when it's visibility, opacity, parent or window is changed.
+/// \param change - Type of change.
+/// \param value - Data of change.
+///
+void PWLottieItem::itemChange(ItemChange change, const ItemChangeData& value)
+{
+    QQuickItem::itemChange(change, value);
+
+    /* Sheet is rendered in pixels of screen, so it's requested again on screens with another scale */
+    if (change == ItemDevicePixelRatioHasChanged || change == ItemSceneChange) {
+        updateSpriteSheet();
+    }
+
+    if (change == ItemDevicePixelRatioHasChanged) {
+        updateLottieItemInfo();
     }
+
+    if (change == ItemParentHasChanged || change == ItemSceneChange) {
+        updateAncestorConnections();
+    }
+
+    if (change != ItemVisibleHasChanged && change != ItemOpacityHasChanged && change != ItemParentHasChanged && change != ItemSceneChange) {
+        return;
+    }
+
+    checkCulling();
+}
+
+///
+/// \brief PWLottieItem::geometryChange - Overrided QQuickItem function 'geometryChange'. Controllers get new size of item on screen, moved item is checked for visibility.
+/// \param newGeometry - New geometry of item.
+/// \param oldGeometry - Previous geometry of item.
+///
+void PWLottieItem::geometryChange(const QRectF& newGeometry, const QRectF& oldGeometry)
+{
+    QQuickItem::geometryChange(newGeometry, oldGeometry);
+
+    if (newGeometry.size() != oldGeometry.size()) {
+        updateLottieItemInfo();
+    }
+
+    checkCulling();
+}
+
+///
+/// \brief PWLottieItem::playbackPosition - Function gets position of animation in seconds from the start of playback.
+/// \return Returns position that includes all played loops.
+///
+qreal PWLottieItem::playbackPosition() const
+{
+    if (!m_playbackTimer.isValid()) {
+        return m_playbackPosition;
+    }
+
+    return m_playbackPosition + m_playbackTimer.nsecsElapsed() / qreal(1000000000);
+}
+
+///
+/// \brief PWLottieItem::isFrameShown - Function checks if frame is already shown in the given size and output format.
+/// \param frame - Frame of animation.
+/// \param frameSize - Size of shown frame image.
+/// \return Returns true if frame doesn't need rendering and uploading.
+///
+bool PWLottieItem::isFrameShown(const qint32 frame, const QSize& frameSize) const
+{
+    if (frame != m_currentFrame) {
+        return false;
+    }
+
+    /* Sprite sheet is uploaded once, so it's frame is shown for any size */
+    if (m_showSprite) {
+        return true;
+    }
+
+    return m_frontFrameIndex >= 0 && m_frameImages[m_frontFrameIndex].size() == frameSize && m_frameImages[m_frontFrameIndex].format() == frameFormat();
+}
+
+///
+/// \brief PWLottieItem::stats - Function gets snapshot of counters of item.
+/// \return Returns counters, timing is filled only while PWLottieStats are enabled.
+///
+PWLottieItemStats PWLottieItem::stats() const
+{
+    PWLottieItemStats itemStats;
+    itemStats.lottieHandle = m_lottieHandle;
+    itemStats.source = m_source;
+    itemStats.frameRate = m_frameRate;
+    itemStats.renderScale = m_renderScale;
+    itemStats.running = m_running;
+    itemStats.culled = m_culled;
+
+    QList<qint64> renderTimes;
+    m_renderTimeSamples.append(renderTimes);
+    itemStats.renderTime = PWLottieTimeSamples::timeStats(renderTimes);
+
+    QList<qint64> schedulingLatencies;
+    m_schedulingLatencySamples.append(schedulingLatencies);
+    itemStats.schedulingLatency = PWLottieTimeSamples::timeStats(schedulingLatencies);
+
+    itemStats.renderedFrames = m_renderedFrames;
+    itemStats.droppedFrames = m_droppedFrames;
+    itemStats.skippedFrames = m_skippedFrames;
+    itemStats.coalescedFrames = m_coalescedFrames;
+    itemStats.cancelledFrames = m_cancelledFrames;
+
+    /* Shared frame belongs to frame cache, so it's counted there */
+    for (qint32 frameImageIndex = 0; frameImageIndex < frameImagesCount; ++frameImageIndex) {
+        itemStats.bufferBytes += m_frameImages[frameImageIndex].sizeInBytes();
+    }
+
+    return itemStats;
 }
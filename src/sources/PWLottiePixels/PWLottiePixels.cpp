@@ -0,0 +1,464 @@
+/*
+ * Copyright (C) PrivateWeb Software (https://github.com/PrivateWebSoftware) - All Rights Reserved
+ *
+ * Licensed under the Apache License 2.0 (the "License"). You may not use
+ * this file except in compliance with the License. You can obtain a copy
+ * in the file LICENSE in the source distribution
+ *
+ * Written by PrivateWeb Software <privatewebsoftware@protonmail.com>, October 2026
+ */
+
+#include "include/PWLottiePixels/PWLottiePixels.h"
+
+#include <QColor>
+
+#include <cstring>
+
+#if !defined(PWLOTTIE_NO_SIMD)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PWLOTTIE_SSE2
+#include <emmintrin.h>
+#if defined(__GNUC__) || defined(__clang__)
+#define PWLOTTIE_AVX2
+#include <immintrin.h>
+#endif
+#elif (defined(__ARM_NEON) || defined(__ARM_NEON__)) && Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+#define PWLOTTIE_NEON
+#include <arm_neon.h>
+#endif
+#endif
+
+/******************/
+/* Scalar kernels */
+/******************/
+
+///
+/// \brief swizzlePixels - Function swaps red and blue channels, so ARGB32 becomes RGBA8888.
+/// \param pixels - Row of pixels.
+/// \param from - Index of the first pixel.
+/// \param count - Count of pixels in row.
+///
+static inline void swizzlePixels(quint32* pixels, qint32 from, const qint32 count)
+{
+    for (; from < count; ++from) {
+        const quint32 pixel = pixels[from];
+
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+        pixels[from] = (pixel & 0xFF00FF00) | ((pixel >> 16) & 0xFF) | ((pixel & 0xFF) << 16);
+#else
+        pixels[from] = (pixel << 8) | (pixel >> 24);
+#endif
+    }
+}
+
+///
+/// \brief unpremultiplyPixels - Function divides colors of pixels by their alpha.
+/// \param pixels - Row of pixels.
+/// \param from - Index of the first pixel.
+/// \param count - Count of pixels in row.
+///
+static inline void unpremultiplyPixels(quint32* pixels, qint32 from, const qint32 count)
+{
+    for (; from < count; ++from) {
+        pixels[from] = qUnpremultiply(pixels[from]);
+    }
+}
+
+///
+/// \brief halvePixels - Function averages 2x2 blocks of pixels.
+/// \param row0 - The first row of blocks.
+/// \param row1 - The second row of blocks.
+/// \param target - Row of averaged pixels, it can be the first row.
+/// \param from - Index of the first averaged pixel.
+/// \param count - Count of averaged pixels.
+///
+static inline void halvePixels(const quint32* row0, const quint32* row1, quint32* target, qint32 from, const qint32 count)
+{
+    for (; from < count; ++from) {
+        const quint32 pixels[4] = { row0[from * 2], row0[from * 2 + 1], row1[from * 2], row1[from * 2 + 1] };
+
+        /* Even and odd channels are summed separately, sum of four channels fits in their 16 bits */
+        quint32 evenChannels = 0x00020002;
+        quint32 oddChannels = 0x00020002;
+
+        for (const quint32 pixel : pixels) {
+            evenChannels += pixel & 0x00FF00FF;
+            oddChannels += (pixel >> 8) & 0x00FF00FF;
+        }
+
+        target[from] = ((evenChannels >> 2) & 0x00FF00FF) | (((oddChannels >> 2) & 0x00FF00FF) << 8);
+    }
+}
+
+/****************/
+/* SSE2 kernels */
+/****************/
+
+#if defined(PWLOTTIE_SSE2)
+static void swizzleRowSse2(quint32* pixels, const qint32 count)
+{
+    const __m128i alphaGreenMask = _mm_set1_epi32(qint32(0xFF00FF00));
+    const __m128i redBlueMask = _mm_set1_epi32(0x00FF00FF);
+
+    qint32 pixel = 0;
+
+    for (; pixel + 4 <= count; pixel += 4) {
+        const __m128i source = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + pixel));
+        const __m128i redBlue = _mm_and_si128(source, redBlueMask);
+        const __m128i swapped = _mm_or_si128(_mm_slli_epi32(redBlue, 16), _mm_srli_epi32(redBlue, 16));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pixels + pixel), _mm_or_si128(_mm_and_si128(source, alphaGreenMask), swapped));
+    }
+
+    swizzlePixels(pixels, pixel, count);
+}
+
+static void unpremultiplyRowSse2(quint32* pixels, const qint32 count)
+{
+    const __m128i alphaMask = _mm_set1_epi32(qint32(0xFF000000));
+
+    qint32 pixel = 0;
+
+    for (; pixel + 4 <= count; pixel += 4) {
+        const __m128i source = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + pixel));
+
+        /* Most pixels of animations are opaque, they are skipped in blocks */
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(source, alphaMask), alphaMask)) != 0xFFFF) {
+            unpremultiplyPixels(pixels, pixel, pixel + 4);
+        }
+    }
+
+    unpremultiplyPixels(pixels, pixel, count);
+}
+
+static inline __m128i sumBlocksSse2(const __m128i top, const __m128i bottom)
+{
+    const __m128i zero = _mm_setzero_si128();
+
+    /* Channels of 2x2 blocks are summed in 16 bits, so they are rounded only once like in scalar kernel */
+    const __m128i low = _mm_add_epi16(_mm_unpacklo_epi8(top, zero), _mm_unpacklo_epi8(bottom, zero));
+    const __m128i high = _mm_add_epi16(_mm_unpackhi_epi8(top, zero), _mm_unpackhi_epi8(bottom, zero));
+
+    return _mm_add_epi16(_mm_unpacklo_epi64(low, high), _mm_unpackhi_epi64(low, high));
+}
+
+static void halveRowSse2(const quint32* row0, const quint32* row1, quint32* target, const qint32 count)
+{
+    const __m128i rounding = _mm_set1_epi16(2);
+
+    qint32 pixel = 0;
+
+    for (; pixel + 4 <= count; pixel += 4) {
+        const __m128i first = sumBlocksSse2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + pixel * 2)), _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + pixel * 2)));
+        const __m128i second = sumBlocksSse2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + pixel * 2 + 4)), _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + pixel * 2 + 4)));
+
+        const __m128i averaged = _mm_packus_epi16(_mm_srli_epi16(_mm_add_epi16(first, rounding), 2), _mm_srli_epi16(_mm_add_epi16(second, rounding), 2));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(target + pixel), averaged);
+    }
+
+    halvePixels(row0, row1, target, pixel, count);
+}
+#endif
+
+/****************/
+/* AVX2 kernels */
+/****************/
+
+#if defined(PWLOTTIE_AVX2)
+///
+/// \brief hasAvx2 - Function checks once if processor supports AVX2.
+/// \return Returns true if AVX2 kernels can be used.
+///
+static bool hasAvx2()
+{
+    static const bool avx2 = __builtin_cpu_supports("avx2");
+
+    return avx2;
+}
+
+__attribute__((target("avx2"))) static void swizzleRowAvx2(quint32* pixels, const qint32 count)
+{
+    const __m256i alphaGreenMask = _mm256_set1_epi32(qint32(0xFF00FF00));
+    const __m256i redBlueMask = _mm256_set1_epi32(0x00FF00FF);
+
+    qint32 pixel = 0;
+
+    for (; pixel + 8 <= count; pixel += 8) {
+        const __m256i source = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pixels + pixel));
+        const __m256i redBlue = _mm256_and_si256(source, redBlueMask);
+        const __m256i swapped = _mm256_or_si256(_mm256_slli_epi32(redBlue, 16), _mm256_srli_epi32(redBlue, 16));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(pixels + pixel), _mm256_or_si256(_mm256_and_si256(source, alphaGreenMask), swapped));
+    }
+
+    swizzlePixels(pixels, pixel, count);
+}
+
+__attribute__((target("avx2"))) static void unpremultiplyRowAvx2(quint32* pixels, const qint32 count)
+{
+    const __m256i alphaMask = _mm256_set1_epi32(qint32(0xFF000000));
+
+    qint32 pixel = 0;
+
+    for (; pixel + 8 <= count; pixel += 8) {
+        const __m256i source = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pixels + pixel));
+
+        if (_mm256_movemask_epi8(_mm256_cmpeq_epi32(_mm256_and_si256(source, alphaMask), alphaMask)) != -1) {
+            unpremultiplyPixels(pixels, pixel, pixel + 8);
+        }
+    }
+
+    unpremultiplyPixels(pixels, pixel, count);
+}
+
+__attribute__((target("avx2"))) static inline __m256i sumBlocksAvx2(const __m256i top, const __m256i bottom)
+{
+    const __m256i zero = _mm256_setzero_si256();
+
+    const __m256i low = _mm256_add_epi16(_mm256_unpacklo_epi8(top, zero), _mm256_unpacklo_epi8(bottom, zero));
+    const __m256i high = _mm256_add_epi16(_mm256_unpackhi_epi8(top, zero), _mm256_unpackhi_epi8(bottom, zero));
+
+    return _mm256_add_epi16(_mm256_unpacklo_epi64(low, high), _mm256_unpackhi_epi64(low, high));
+}
+
+__attribute__((target("avx2"))) static void halveRowAvx2(const quint32* row0, const quint32* row1, quint32* target, const qint32 count)
+{
+    const __m256i rounding = _mm256_set1_epi16(2);
+
+    qint32 pixel = 0;
+
+    for (; pixel + 8 <= count; pixel += 8) {
+        const __m256i first = sumBlocksAvx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(row0 + pixel * 2)), _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row1 + pixel * 2)));
+        const __m256i second = sumBlocksAvx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(row0 + pixel * 2 + 8)), _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row1 + pixel * 2 + 8)));
+
+        const __m256i averaged = _mm256_packus_epi16(_mm256_srli_epi16(_mm256_add_epi16(first, rounding), 2), _mm256_srli_epi16(_mm256_add_epi16(second, rounding), 2));
+
+        /* Unpacks and packs work inside 128 bit lanes, so pairs of pixels are put back in order */
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(target + pixel), _mm256_permute4x64_epi64(averaged, _MM_SHUFFLE(3, 1, 2, 0)));
+    }
+
+    halvePixels(row0, row1, target, pixel, count);
+}
+#endif
+
+/****************/
+/* NEON kernels */
+/****************/
+
+#if defined(PWLOTTIE_NEON)
+static void swizzleRowNeon(quint32* pixels, const qint32 count)
+{
+    qint32 pixel = 0;
+
+    for (; pixel + 16 <= count; pixel += 16) {
+        uint8x16x4_t channels = vld4q_u8(reinterpret_cast<const uint8_t*>(pixels + pixel));
+
+        const uint8x16_t blue = channels.val[0];
+        channels.val[0] = channels.val[2];
+        channels.val[2] = blue;
+
+        vst4q_u8(reinterpret_cast<uint8_t*>(pixels + pixel), channels);
+    }
+
+    swizzlePixels(pixels, pixel, count);
+}
+
+static void unpremultiplyRowNeon(quint32* pixels, const qint32 count)
+{
+    qint32 pixel = 0;
+
+    for (; pixel + 4 <= count; pixel += 4) {
+        const uint32x4_t alpha = vshrq_n_u32(vld1q_u32(pixels + pixel), 24);
+
+        uint32x2_t minAlpha = vpmin_u32(vget_low_u32(alpha), vget_high_u32(alpha));
+        minAlpha = vpmin_u32(minAlpha, minAlpha);
+
+        if (vget_lane_u32(minAlpha, 0) != 0xFF) {
+            unpremultiplyPixels(pixels, pixel, pixel + 4);
+        }
+    }
+
+    unpremultiplyPixels(pixels, pixel, count);
+}
+
+static void halveRowNeon(const quint32* row0, const quint32* row1, quint32* target, const qint32 count)
+{
+    qint32 pixel = 0;
+
+    for (; pixel + 4 <= count; pixel += 4) {
+        /* Even and odd pixels are split by deinterleaving load */
+        const uint32x4x2_t top = vld2q_u32(row0 + pixel * 2);
+        const uint32x4x2_t bottom = vld2q_u32(row1 + pixel * 2);
+
+        const uint8x16_t topEven = vreinterpretq_u8_u32(top.val[0]);
+        const uint8x16_t topOdd = vreinterpretq_u8_u32(top.val[1]);
+        const uint8x16_t bottomEven = vreinterpretq_u8_u32(bottom.val[0]);
+        const uint8x16_t bottomOdd = vreinterpretq_u8_u32(bottom.val[1]);
+
+        /* Channels of 2x2 block are summed in 16 bits and rounded once by narrowing shift, like in scalar kernel */
+        const uint16x8_t low = vaddq_u16(vaddl_u8(vget_low_u8(topEven), vget_low_u8(topOdd)), vaddl_u8(vget_low_u8(bottomEven), vget_low_u8(bottomOdd)));
+        const uint16x8_t high = vaddq_u16(vaddl_u8(vget_high_u8(topEven), vget_high_u8(topOdd)), vaddl_u8(vget_high_u8(bottomEven), vget_high_u8(bottomOdd)));
+
+        vst1q_u32(target + pixel, vreinterpretq_u32_u8(vcombine_u8(vrshrn_n_u16(low, 2), vrshrn_n_u16(high, 2))));
+    }
+
+    halvePixels(row0, row1, target, pixel, count);
+}
+#endif
+
+/***************/
+/* Dispatchers */
+/***************/
+
+static void swizzleRow(quint32* pixels, const qint32 count)
+{
+#if defined(PWLOTTIE_AVX2)
+    if (hasAvx2()) {
+        swizzleRowAvx2(pixels, count);
+        return;
+    }
+#endif
+
+#if defined(PWLOTTIE_SSE2)
+    swizzleRowSse2(pixels, count);
+#elif defined(PWLOTTIE_NEON)
+    swizzleRowNeon(pixels, count);
+#else
+    swizzlePixels(pixels, 0, count);
+#endif
+}
+
+static void unpremultiplyRow(quint32* pixels, const qint32 count)
+{
+#if defined(PWLOTTIE_AVX2)
+    if (hasAvx2()) {
+        unpremultiplyRowAvx2(pixels, count);
+        return;
+    }
+#endif
+
+#if defined(PWLOTTIE_SSE2)
+    unpremultiplyRowSse2(pixels, count);
+#elif defined(PWLOTTIE_NEON)
+    unpremultiplyRowNeon(pixels, count);
+#else
+    unpremultiplyPixels(pixels, 0, count);
+#endif
+}
+
+static void halveRow(const quint32* row0, const quint32* row1, quint32* target, const qint32 count)
+{
+#if defined(PWLOTTIE_AVX2)
+    if (hasAvx2()) {
+        halveRowAvx2(row0, row1, target, count);
+        return;
+    }
+#endif
+
+#if defined(PWLOTTIE_SSE2)
+    halveRowSse2(row0, row1, target, count);
+#elif defined(PWLOTTIE_NEON)
+    halveRowNeon(row0, row1, target, count);
+#else
+    halvePixels(row0, row1, target, 0, count);
+#endif
+}
+
+/*************/
+/* Functions */
+/*************/
+
+///
+/// \brief PWLottiePixels::convert - Function converts pixels rendered by rlottie in place.
+/// \param bits - Pixels in premultiplied ARGB32.
+/// \param bytesPerLine - Bytes per line of pixels.
+/// \param size - Size of pixels.
+/// \param format - Format pixels are converted to: premultiplied or straight ARGB32 or RGBA8888.
+///
+void PWLottiePixels::convert(uchar* bits, const qsizetype bytesPerLine, const QSize& size, const QImage::Format format)
+{
+    const bool unpremultiply = format == QImage::Format_ARGB32 || format == QImage::Format_RGBA8888;
+    const bool swizzle = format == QImage::Format_RGBA8888_Premultiplied || format == QImage::Format_RGBA8888;
+
+    if (!unpremultiply && !swizzle) {
+        return;
+    }
+
+    /* Both passes are done row by row, while row is still in cache */
+    for (qint32 line = 0; line < size.height(); ++line) {
+        quint32* const pixels = reinterpret_cast<quint32*>(bits + line * bytesPerLine);
+
+        if (unpremultiply) {
+            unpremultiplyRow(pixels, size.width());
+        }
+
+        if (swizzle) {
+            swizzleRow(pixels, size.width());
+        }
+    }
+}
+
+///
+/// \brief PWLottiePixels::downscaledSize - Function gets size to which frame is halved, until it's not smaller than displayed size.
+/// \param frameSize - Size of rendered frame.
+/// \param displaySize - Size of item on screen in pixels.
+/// \return Returns size of frame after downscaling, or frame size if it isn't downscaled.
+///
+QSize PWLottiePixels::downscaledSize(const QSize& frameSize, const QSize& displaySize)
+{
+    if (displaySize.isEmpty()) {
+        return frameSize;
+    }
+
+    /* Scene graph scales frames with bilinear filter, it loses details only when frame is more than twice bigger */
+    QSize size = frameSize;
+
+    while (size.width() / 2 >= displaySize.width() && size.height() / 2 >= displaySize.height()) {
+        size = QSize(size.width() / 2, size.height() / 2);
+    }
+
+    return size;
+}
+
+///
+/// \brief PWLottiePixels::downscale - Function halves pixels with 2x2 box filter until they have the given size.
+/// \attention Source pixels are overwritten when they are halved more than once.
+///
+/// \param sourceBits - Pixels in premultiplied ARGB32.
+/// \param sourceBytesPerLine - Bytes per line of source pixels.
+/// \param sourceSize - Size of source pixels.
+/// \param targetBits - Downscaled pixels.
+/// \param targetBytesPerLine - Bytes per line of downscaled pixels.
+/// \param targetSize - Size from downscaledSize().
+///
+void PWLottiePixels::downscale(uchar* sourceBits, const qsizetype sourceBytesPerLine, const QSize& sourceSize, uchar* targetBits, const qsizetype targetBytesPerLine, const QSize& targetSize)
+{
+    if (sourceSize == targetSize) {
+        for (qint32 line = 0; line < targetSize.height(); ++line) {
+            std::memcpy(targetBits + line * targetBytesPerLine, sourceBits + line * sourceBytesPerLine, size_t(targetSize.width()) * 4);
+        }
+
+        return;
+    }
+
+    QSize size = sourceSize;
+
+    while (size != targetSize && !size.isEmpty()) {
+        const QSize halvedSize(size.width() / 2, size.height() / 2);
+
+        /* Intermediate sizes are halved in place, every row is written only after it was read */
+        const bool lastStep = halvedSize == targetSize;
+        uchar* const stepBits = lastStep ? targetBits : sourceBits;
+        const qsizetype stepBytesPerLine = lastStep ? targetBytesPerLine : sourceBytesPerLine;
+
+        for (qint32 line = 0; line < halvedSize.height(); ++line) {
+            const quint32* const row0 = reinterpret_cast<const quint32*>(sourceBits + line * 2 * sourceBytesPerLine);
+            const quint32* const row1 = reinterpret_cast<const quint32*>(sourceBits + (line * 2 + 1) * sourceBytesPerLine);
+
+            halveRow(row0, row1, reinterpret_cast<quint32*>(stepBits + line * stepBytesPerLine), halvedSize.width());
+        }
+
+        size = halvedSize;
+    }
+}
@@ -0,0 +1,350 @@
+/*
+ * Copyright (C) PrivateWeb Software (https://github.com/PrivateWebSoftware) - All Rights Reserved
+ *
+ * Licensed under the Apache License 2.0 (the "License"). You may not use
+ * this file except in compliance with the License. You can obtain a copy
+ * in the file LICENSE in the source distribution
+ *
+ * Written by PrivateWeb Software <privatewebsoftware@protonmail.com>, October 2026
+ */
+
+#include "include/PWLottieRenderScheduler/PWLottieRenderScheduler.h"
+
+namespace {
+
+///
+/// \brief currentWorkerIndex - Index of worker that runs in current thread, '-1' for not worker threads.
+///
+thread_local qint32 currentWorkerIndex = -1;
+
+///
+/// \brief defaultThreadCount - Function gets count of worker threads if it wasn't set up with setThreadCount().
+/// \return Returns value of PWLOTTIE_RENDER_THREADS environment variable or count of cores.
+///
+qint32 defaultThreadCount()
+{
+    bool ok = false;
+    const qint32 threadCount = qEnvironmentVariableIntValue("PWLOTTIE_RENDER_THREADS", &ok);
+
+    if (ok && threadCount > 0) {
+        return threadCount;
+    }
+
+    return qMax(1, QThread::idealThreadCount());
+}
+
+}
+
+PWLottieRenderScheduler::~PWLottieRenderScheduler()
+{
+    /* Nobody will run jobs that are left, so they are dropped here instead of being destroyed with workers later */
+    stopWorkers(true);
+}
+
+///
+/// \brief PWLottieRenderScheduler::instance - Singleton instance funtion, cause we need only one render scheduler for hole application.
+/// \return Instance to PWLottieRenderScheduler class.
+///
+PWLottieRenderScheduler* PWLottieRenderScheduler::instance()
+{
+    static PWLottieRenderScheduler scheduler;
+
+    return &scheduler;
+}
+
+///
+/// \brief PWLottieRenderScheduler::threadCount - Function gets count of worker threads used by scheduler.
+/// \return Returns count of worker threads.
+///
+qint32 PWLottieRenderScheduler::threadCount()
+{
+    QReadLocker locker(&m_workersLock);
+
+    if (!m_workers.empty()) {
+        return qint32(m_workers.size());
+    }
+
+    const qint32 threadCount = m_threadCount.load();
+
+    return threadCount > 0 ? threadCount : defaultThreadCount();
+}
+
+///
+/// \brief PWLottieRenderScheduler::setThreadCount - Function sets count of worker threads. Jobs that wait for execution are kept.
+/// \attention Function must not be called from render jobs.
+///
+/// \param threadCount - Count of worker threads, '0' to use count of cores.
+///
+void PWLottieRenderScheduler::setThreadCount(const qint32 threadCount)
+{
+    m_threadCount = qMax(0, threadCount);
+
+    {
+        QReadLocker locker(&m_workersLock);
+
+        /* Workers will be started with new count on first submit */
+        if (m_workers.empty()) {
+            return;
+        }
+    }
+
+    /* Restart workers, jobs that weren't executed will be moved to new workers */
+    stopWorkers(false);
+
+    QWriteLocker locker(&m_workersLock);
+    startWorkers();
+}
+
+///
+/// \brief PWLottieRenderScheduler::submit - Function submits job without any ordering guarantees.
+/// \param job - Job that will be executed in one of worker threads.
+///
+void PWLottieRenderScheduler::submit(Job job)
+{
+    m_workersLock.lockForRead();
+
+    /* Start workers lazily, so applications without lottie items don't spend threads */
+    if (m_workers.empty()) {
+        m_workersLock.unlock();
+
+        {
+            QWriteLocker locker(&m_workersLock);
+
+            if (m_workers.empty()) {
+                startWorkers();
+            }
+        }
+
+        m_workersLock.lockForRead();
+    }
+
+    /* Job is counted before it's pushed, so worker that takes it right away never makes count negative */
+    m_pendingJobs.fetch_add(1);
+
+    /* Jobs submitted from worker keep in it's own deque, other jobs are spread between workers */
+    const qint32 workerCount = qint32(m_workers.size());
+    const qint32 workerIndex = (currentWorkerIndex >= 0 && currentWorkerIndex < workerCount) ? currentWorkerIndex : qint32(m_nextWorker.fetch_add(1, std::memory_order_relaxed) % workerCount);
+
+    {
+        QMutexLocker locker(&m_workers[workerIndex]->mutex);
+        m_workers[workerIndex]->jobs.push_back(std::move(job));
+    }
+
+    m_workersLock.unlock();
+
+    /* Wake up one sleeping worker */
+    QMutexLocker locker(&m_sleepMutex);
+    m_wakeCondition.wakeOne();
+}
+
+///
+/// \brief PWLottieRenderScheduler::submit - Function submits job in ordered queue.
+/// \param queue - Queue that keeps order of jobs.
+/// \param job - Job that will be executed after all jobs that were submitted before in this queue.
+///
+void PWLottieRenderScheduler::submit(const RenderQueuePtr& queue, Job job)
+{
+    {
+        QMutexLocker locker(&queue->mutex);
+        queue->jobs.push_back(std::move(job));
+
+        /* Queue is already drained by one of workers */
+        if (queue->scheduled) {
+            return;
+        }
+
+        queue->scheduled = true;
+    }
+
+    submit([this, queue]() {
+        drainQueue(queue);
+    });
+}
+
+///
+/// \brief PWLottieRenderScheduler::startWorkers - Function starts worker threads, must be called under write lock.
+///
+void PWLottieRenderScheduler::startWorkers()
+{
+    /* Collect jobs that left from previous workers */
+    std::deque<Job> jobs;
+
+    for (const std::unique_ptr<Worker>& worker : m_workers) {
+        QMutexLocker locker(&worker->mutex);
+
+        for (Job& job : worker->jobs) {
+            jobs.push_back(std::move(job));
+        }
+    }
+
+    m_workers.clear();
+
+    const qint32 threadCount = m_threadCount.load();
+    const qint32 workerCount = threadCount > 0 ? threadCount : defaultThreadCount();
+
+    for (qint32 i = 0; i != workerCount; ++i) {
+        m_workers.push_back(std::make_unique<Worker>());
+    }
+
+    for (size_t i = 0; i != jobs.size(); ++i) {
+        m_workers[i % workerCount]->jobs.push_back(std::move(jobs[i]));
+    }
+
+    for (qint32 i = 0; i != workerCount; ++i) {
+        m_workers[i]->thread.reset(QThread::create([this, i]() {
+            runWorker(i);
+        }));
+
+        m_workers[i]->thread->setObjectName(QStringLiteral("PWLottieRender-%1").arg(i));
+        m_workers[i]->thread->start();
+    }
+}
+
+///
+/// \brief PWLottieRenderScheduler::stopWorkers - Function stops and joins worker threads.
+/// \param cancelJobs - Whether jobs that weren't executed are dropped, otherwise they stay in workers deques for the next workers.
+///
+void PWLottieRenderScheduler::stopWorkers(const bool cancelJobs)
+{
+    {
+        QMutexLocker locker(&m_sleepMutex);
+
+        m_stopping = true;
+        m_wakeCondition.wakeAll();
+    }
+
+    {
+        QReadLocker locker(&m_workersLock);
+
+        for (const std::unique_ptr<Worker>& worker : m_workers) {
+            if (worker->thread) {
+                worker->thread->wait();
+            }
+        }
+    }
+
+    /* Dropped jobs of ordered queues are never drained again, so jobs are cancelled only when scheduler is destroyed */
+    if (cancelJobs) {
+        QWriteLocker locker(&m_workersLock);
+
+        for (const std::unique_ptr<Worker>& worker : m_workers) {
+            QMutexLocker workerLocker(&worker->mutex);
+
+            m_pendingJobs.fetch_sub(qint32(worker->jobs.size()));
+            worker->jobs.clear();
+        }
+    }
+
+    m_stopping = false;
+}
+
+///
+/// \brief PWLottieRenderScheduler::runWorker - Main loop of worker thread.
+/// \param workerIndex - Index of worker.
+///
+void PWLottieRenderScheduler::runWorker(const qint32 workerIndex)
+{
+    currentWorkerIndex = workerIndex;
+
+    Job job;
+    while (!m_stopping) {
+        if (takeJob(workerIndex, job)) {
+            job();
+            job = nullptr;
+
+            continue;
+        }
+
+        /* Sleep while there is nothing to do */
+        QMutexLocker locker(&m_sleepMutex);
+
+        while (m_pendingJobs.load() <= 0 && !m_stopping) {
+            m_wakeCondition.wait(&m_sleepMutex);
+        }
+    }
+
+    currentWorkerIndex = -1;
+}
+
+///
+/// \brief PWLottieRenderScheduler::takeJob - Takes job from worker's own deque or steals it from another worker.
+/// \param workerIndex - Index of worker that takes job.
+/// \param job - Taken job.
+/// \return Returns true if job was taken.
+///
+bool PWLottieRenderScheduler::takeJob(const qint32 workerIndex, Job& job)
+{
+    QReadLocker locker(&m_workersLock);
+
+    const qint32 workerCount = qint32(m_workers.size());
+    if (workerIndex >= workerCount) {
+        return false;
+    }
+
+    /*
+     * Take the oldest job from own deque. Ordered queues and frame chains submit their next job from worker as soon as
+     * previous one is done, so taking the newest one would run them forever before older preloads and sprite sheets
+     */
+    {
+        Worker& worker = *m_workers[workerIndex];
+        QMutexLocker workerLocker(&worker.mutex);
+
+        if (!worker.jobs.empty()) {
+            job = std::move(worker.jobs.front());
+            worker.jobs.pop_front();
+            m_pendingJobs.fetch_sub(1);
+
+            return true;
+        }
+    }
+
+    /* Steal the oldest job from other workers */
+    for (qint32 i = 1; i != workerCount; ++i) {
+        Worker& victim = *m_workers[(workerIndex + i) % workerCount];
+        QMutexLocker victimLocker(&victim.mutex);
+
+        if (!victim.jobs.empty()) {
+            job = std::move(victim.jobs.front());
+            victim.jobs.pop_front();
+            m_pendingJobs.fetch_sub(1);
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+///
+/// \brief PWLottieRenderScheduler::drainQueue - Runs first job of ordered queue and schedules next one.
+/// \param queue - Queue that will be drained.
+///
+void PWLottieRenderScheduler::drainQueue(const RenderQueuePtr& queue)
+{
+    Job job;
+
+    {
+        QMutexLocker locker(&queue->mutex);
+
+        job = std::move(queue->jobs.front());
+        queue->jobs.pop_front();
+    }
+
+    job();
+
+    {
+        QMutexLocker locker(&queue->mutex);
+
+        /* Nothing left, next submit will schedule queue again */
+        if (queue->jobs.empty()) {
+            queue->scheduled = false;
+
+            return;
+        }
+    }
+
+    /* Only one job of queue is executed at a time, so frames never come back out of order */
+    submit([this, queue]() {
+        drainQueue(queue);
+    });
+}
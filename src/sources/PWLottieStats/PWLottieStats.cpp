@@ -0,0 +1,282 @@
+/*
+ * Copyright (C) PrivateWeb Software (https://github.com/PrivateWebSoftware) - All Rights Reserved
+ *
+ * Licensed under the Apache License 2.0 (the "License"). You may not use
+ * this file except in compliance with the License. You can obtain a copy
+ * in the file LICENSE in the source distribution
+ *
+ * Written by PrivateWeb Software <privatewebsoftware@protonmail.com>, October 2026
+ */
+
+#include "include/PWLottieStats/PWLottieStats.h"
+#include "include/PWControllerMediator/PWControllerMediator.h"
+#include "include/PWLottieCache/PWLottieBufferPool.h"
+#include "include/PWLottieCache/PWLottieCache.h"
+#include "include/PWLottieCache/PWLottieFrameCache.h"
+#include "include/PWLottieItem/PWLottieItem.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QVariantList>
+
+#include <algorithm>
+
+///
+/// \brief PWLottieTimeSamples::append - Function appends samples to list, it's used to merge samples of all items.
+/// \param samples - List of samples.
+///
+void PWLottieTimeSamples::append(QList<qint64>& samples) const
+{
+    samples.append(m_samples.cbegin(), m_samples.cbegin() + m_count);
+}
+
+///
+/// \brief PWLottieTimeSamples::timeStats - Function calculates stats of the given samples.
+/// \param samples - Samples in nanoseconds.
+/// \return Returns stats in milliseconds.
+///
+PWLottieTimeStats PWLottieTimeSamples::timeStats(QList<qint64> samples)
+{
+    if (samples.isEmpty()) {
+        return {};
+    }
+
+    qint64 total = 0;
+    for (const qint64 sample : std::as_const(samples)) {
+        total += sample;
+    }
+
+    const auto p95 = samples.begin() + qMin(samples.size() - 1, samples.size() * 95 / 100);
+    std::nth_element(samples.begin(), p95, samples.end());
+
+    PWLottieTimeStats timeStats;
+    timeStats.average = total / qreal(samples.size()) / 1000000;
+    timeStats.p95 = *p95 / qreal(1000000);
+    timeStats.max = *std::max_element(samples.cbegin(), samples.cend()) / qreal(1000000);
+
+    return timeStats;
+}
+
+PWLottieStats::PWLottieStats(QObject* parent)
+    : QObject { parent }
+{
+}
+
+///
+/// \brief PWLottieStats::instance - Singleton instance funtion, cause we need only one stats object for hole application.
+/// \return Instance to PWLottieStats class.
+///
+PWLottieStats* PWLottieStats::instance()
+{
+    static PWLottieStats* stats = []() {
+        PWLottieStats* lottieStats = new PWLottieStats;
+
+        if (QCoreApplication::instance()) {
+            lottieStats->moveToThread(QCoreApplication::instance()->thread());
+        }
+
+        return lottieStats;
+    }();
+
+    return stats;
+}
+
+///
+/// \brief PWLottieStats::create - Function that is used by QML engine to get singleton instance.
+/// \return Instance to PWLottieStats class.
+///
+PWLottieStats* PWLottieStats::create(QQmlEngine* qmlEngine, QJSEngine* jsEngine)
+{
+    Q_UNUSED(qmlEngine)
+    Q_UNUSED(jsEngine)
+
+    QJSEngine::setObjectOwnership(instance(), QJSEngine::CppOwnership);
+
+    return instance();
+}
+
+///
+/// \brief PWLottieStats::timestamp - Function gets monotonic time that is shared by all threads.
+/// \return Returns time in nanoseconds.
+///
+qint64 PWLottieStats::timestamp()
+{
+    static const QElapsedTimer timer = []() {
+        QElapsedTimer startedTimer;
+        startedTimer.start();
+
+        return startedTimer;
+    }();
+
+    return timer.nsecsElapsed();
+}
+
+///
+/// \brief PWLottieStats::snapshot - Function collects counters of all items and caches, must be called from GUI thread.
+/// \return Returns snapshot of counters.
+///
+PWLottieStatsSnapshot PWLottieStats::snapshot()
+{
+    PWLottieStatsSnapshot snapshot;
+
+    QList<qint64> renderTimes;
+    QList<qint64> schedulingLatencies;
+    qint64 totalFrameRate = 0;
+
+    const QList<PWLottieItem*> lottieItems = PWControllerMediator::lottieItems();
+
+    for (const PWLottieItem* const lottieItem : lottieItems) {
+        const PWLottieItemStats itemStats = lottieItem->stats();
+
+        lottieItem->renderTimeSamples().append(renderTimes);
+        lottieItem->schedulingLatencySamples().append(schedulingLatencies);
+
+        snapshot.runningItems += itemStats.running ? 1 : 0;
+        snapshot.culledItems += itemStats.culled ? 1 : 0;
+        totalFrameRate += itemStats.running ? itemStats.frameRate : 0;
+
+        snapshot.renderedFrames += itemStats.renderedFrames;
+        snapshot.droppedFrames += itemStats.droppedFrames;
+        snapshot.skippedFrames += itemStats.skippedFrames;
+        snapshot.coalescedFrames += itemStats.coalescedFrames;
+        snapshot.cancelledFrames += itemStats.cancelledFrames;
+        snapshot.itemBufferBytes += itemStats.bufferBytes;
+
+        snapshot.items.append(itemStats);
+    }
+
+    /* Effective framerate is what controllers have set for items that are playing now */
+    snapshot.averageFrameRate = snapshot.runningItems > 0 ? totalFrameRate / qreal(snapshot.runningItems) : 0.0;
+    snapshot.renderTime = PWLottieTimeSamples::timeStats(renderTimes);
+    snapshot.schedulingLatency = PWLottieTimeSamples::timeStats(schedulingLatencies);
+
+    PWLottieFrameCache* const frameCache = PWLottieFrameCache::instance();
+    snapshot.frameCacheBytes = frameCache->memoryUsage();
+    snapshot.frameCacheHits = frameCache->hits();
+    snapshot.frameCacheMisses = frameCache->misses();
+
+    PWLottieCache* const modelCache = PWLottieCache::instance();
+    snapshot.modelCacheBytes = modelCache->memoryUsage();
+    snapshot.modelCacheHits = modelCache->hits();
+    snapshot.modelCacheMisses = modelCache->misses();
+
+    snapshot.spriteSheetBytes = PWControllerMediator::iconController()->memoryUsage();
+
+    PWLottieBufferPool* const bufferPool = PWLottieBufferPool::instance();
+    snapshot.bufferPoolBytes = bufferPool->memoryUsage();
+    snapshot.bufferPoolPeakBytes = bufferPool->peakMemoryUsage();
+    snapshot.bufferPoolLimitHits = bufferPool->limitHits();
+
+    return snapshot;
+}
+
+///
+/// \brief timeStatsMap - Function converts time stats for QML.
+/// \param timeStats - Time stats.
+/// \return Returns time stats as JS object.
+///
+static QVariantMap timeStatsMap(const PWLottieTimeStats& timeStats)
+{
+    return {
+        { "average", timeStats.average },
+        { "p95", timeStats.p95 },
+        { "max", timeStats.max },
+    };
+}
+
+///
+/// \brief itemStatsToMap - Function converts item stats for QML.
+/// \param itemStats - Stats of item.
+/// \return Returns stats as JS object.
+///
+static QVariantMap itemStatsToMap(const PWLottieItemStats& itemStats)
+{
+    return {
+        { "lottieHandle", itemStats.lottieHandle },
+        { "source", itemStats.source },
+        { "frameRate", itemStats.frameRate },
+        { "renderScale", itemStats.renderScale },
+        { "running", itemStats.running },
+        { "culled", itemStats.culled },
+        { "renderTime", timeStatsMap(itemStats.renderTime) },
+        { "schedulingLatency", timeStatsMap(itemStats.schedulingLatency) },
+        { "renderedFrames", itemStats.renderedFrames },
+        { "droppedFrames", itemStats.droppedFrames },
+        { "skippedFrames", itemStats.skippedFrames },
+        { "coalescedFrames", itemStats.coalescedFrames },
+        { "cancelledFrames", itemStats.cancelledFrames },
+        { "bufferBytes", itemStats.bufferBytes },
+    };
+}
+
+///
+/// \brief PWLottieStats::snapshotMap - Function collects counters of all items and caches for QML.
+/// \return Returns snapshot as JS object.
+///
+QVariantMap PWLottieStats::snapshotMap() const
+{
+    const PWLottieStatsSnapshot statsSnapshot = snapshot();
+
+    QVariantList items;
+    items.reserve(statsSnapshot.items.size());
+
+    for (const PWLottieItemStats& itemStats : statsSnapshot.items) {
+        items.append(itemStatsToMap(itemStats));
+    }
+
+    const auto hitRate = [](const quint64 hits, const quint64 misses) {
+        return hits + misses > 0 ? hits / qreal(hits + misses) : 0.0;
+    };
+
+    return {
+        { "items", items },
+        { "runningItems", statsSnapshot.runningItems },
+        { "culledItems", statsSnapshot.culledItems },
+        { "averageFrameRate", statsSnapshot.averageFrameRate },
+        { "renderTime", timeStatsMap(statsSnapshot.renderTime) },
+        { "schedulingLatency", timeStatsMap(statsSnapshot.schedulingLatency) },
+        { "renderedFrames", statsSnapshot.renderedFrames },
+        { "droppedFrames", statsSnapshot.droppedFrames },
+        { "skippedFrames", statsSnapshot.skippedFrames },
+        { "coalescedFrames", statsSnapshot.coalescedFrames },
+        { "cancelledFrames", statsSnapshot.cancelledFrames },
+        { "itemBufferBytes", statsSnapshot.itemBufferBytes },
+        { "frameCacheBytes", statsSnapshot.frameCacheBytes },
+        { "spriteSheetBytes", statsSnapshot.spriteSheetBytes },
+        { "modelCacheBytes", statsSnapshot.modelCacheBytes },
+        { "bufferPoolBytes", statsSnapshot.bufferPoolBytes },
+        { "bufferPoolPeakBytes", statsSnapshot.bufferPoolPeakBytes },
+        { "bufferPoolLimitHits", statsSnapshot.bufferPoolLimitHits },
+        { "frameCacheHitRate", hitRate(statsSnapshot.frameCacheHits, statsSnapshot.frameCacheMisses) },
+        { "modelCacheHitRate", hitRate(statsSnapshot.modelCacheHits, statsSnapshot.modelCacheMisses) },
+    };
+}
+
+///
+/// \brief PWLottieStats::itemStatsMap - Function collects counters of one item for QML.
+/// \param lottieItem - Lottie item.
+/// \return Returns counters as JS object, it's empty if item is null.
+///
+QVariantMap PWLottieStats::itemStatsMap(PWLottieItem* lottieItem) const
+{
+    if (!lottieItem) {
+        return {};
+    }
+
+    return itemStatsToMap(lottieItem->stats());
+}
+
+///
+/// \brief PWLottieStats::setEnabled - Function enables or disables timing samples.
+/// \param enabled - Whether stats are enabled.
+///
+void PWLottieStats::setEnabled(const bool enabled)
+{
+#ifdef PWLOTTIE_NO_STATS
+    Q_UNUSED(enabled)
+#else
+    if (m_enabled.exchange(enabled, std::memory_order_relaxed) != enabled) {
+        emit enabledChanged();
+    }
+#endif
+}
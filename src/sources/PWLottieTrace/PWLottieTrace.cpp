@@ -0,0 +1,228 @@
+/*
+ * Copyright (C) PrivateWeb Software (https://github.com/PrivateWebSoftware) - All Rights Reserved
+ *
+ * Licensed under the Apache License 2.0 (the "License"). You may not use
+ * this file except in compliance with the License. You can obtain a copy
+ * in the file LICENSE in the source distribution
+ *
+ * Written by PrivateWeb Software <privatewebsoftware@protonmail.com>, October 2026
+ */
+
+#include "include/PWLottieTrace/PWLottieTrace.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QThread>
+
+#include <tuple>
+
+std::atomic<bool> PWLottieTrace::m_enabled = !qEnvironmentVariableIsEmpty("PWLOTTIE_TRACE");
+
+PWLottieTrace::PWLottieTrace(QObject* parent)
+    : QObject { parent }
+{
+    /* Trace that is enabled by environment is written when application quits */
+    const QString traceFilePath = qEnvironmentVariable("PWLOTTIE_TRACE");
+
+    if (!traceFilePath.isEmpty() && QCoreApplication::instance()) {
+        connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, this, [this, traceFilePath]() {
+            std::ignore = dump(traceFilePath);
+        });
+    }
+}
+
+///
+/// \brief PWLottieTrace::instance - Singleton instance funtion, cause we need only one trace for hole application.
+/// \return Instance to PWLottieTrace class.
+///
+PWLottieTrace* PWLottieTrace::instance()
+{
+    /* Trace can be requested from render workers first, so it's moved to main thread to be used in QML */
+    static PWLottieTrace* trace = []() {
+        PWLottieTrace* lottieTrace = new PWLottieTrace;
+
+        if (QCoreApplication::instance()) {
+            lottieTrace->moveToThread(QCoreApplication::instance()->thread());
+        }
+
+        return lottieTrace;
+    }();
+
+    return trace;
+}
+
+///
+/// \brief PWLottieTrace::create - Function that is used by QML engine to get singleton instance.
+/// \return Instance to PWLottieTrace class.
+///
+PWLottieTrace* PWLottieTrace::create(QQmlEngine* qmlEngine, QJSEngine* jsEngine)
+{
+    Q_UNUSED(qmlEngine)
+    Q_UNUSED(jsEngine)
+
+    QJSEngine::setObjectOwnership(instance(), QJSEngine::CppOwnership);
+
+    return instance();
+}
+
+///
+/// \brief PWLottieTrace::record - Function records event in ring of current thread.
+/// \param traceEvent - Recorded event.
+///
+void PWLottieTrace::record(const PWLottieTraceEvent& traceEvent)
+{
+    TraceRing* const traceRing = instance()->threadRing();
+
+    /* Only this thread writes in ring, index is published after event, so reader never sees unwritten event */
+    const quint64 writeIndex = traceRing->writeIndex.load(std::memory_order_relaxed);
+
+    traceRing->events[writeIndex % traceRingCapacity] = traceEvent;
+    traceRing->writeIndex.store(writeIndex + 1, std::memory_order_release);
+}
+
+///
+/// \brief PWLottieTrace::threadRing - Function gets ring of current thread, it's created on the first event of thread.
+/// \return Returns ring of current thread.
+///
+PWLottieTrace::TraceRing* PWLottieTrace::threadRing()
+{
+    /* Rings are never deleted, so events of finished threads are still dumped */
+    thread_local TraceRing* traceRing = nullptr;
+
+    if (traceRing) {
+        return traceRing;
+    }
+
+    QMutexLocker locker(&m_mutex);
+
+    std::unique_ptr<TraceRing> createdRing = std::make_unique<TraceRing>();
+    createdRing->threadId = qint32(m_rings.size()) + 1;
+    createdRing->threadName = QThread::currentThread()->objectName();
+
+    if (createdRing->threadName.isEmpty()) {
+        createdRing->threadName = QCoreApplication::instance() && QThread::currentThread() == QCoreApplication::instance()->thread() ? QString("GUI thread") : QString("Thread %1").arg(createdRing->threadId);
+    }
+
+    traceRing = createdRing.get();
+    m_rings.push_back(std::move(createdRing));
+
+    return traceRing;
+}
+
+///
+/// \brief PWLottieTrace::toJson - Function collects recorded events of all threads.
+/// \return Returns Chrome trace JSON.
+///
+QByteArray PWLottieTrace::toJson()
+{
+    QMutexLocker locker(&m_mutex);
+
+    const qint64 processId = QCoreApplication::applicationPid();
+    QJsonArray traceEvents;
+
+    for (const std::unique_ptr<TraceRing>& traceRing : m_rings) {
+        traceEvents.append(QJsonObject {
+            { "ph", "M" },
+            { "name", "thread_name" },
+            { "pid", processId },
+            { "tid", traceRing->threadId },
+            { "args", QJsonObject { { "name", traceRing->threadName } } },
+        });
+
+        const quint64 endIndex = traceRing->writeIndex.load(std::memory_order_acquire);
+        const quint64 beginIndex = qMax(endIndex > traceRingCapacity ? endIndex - traceRingCapacity : 0, traceRing->clearIndex.load(std::memory_order_relaxed));
+
+        std::vector<PWLottieTraceEvent> events;
+        events.reserve(endIndex - beginIndex);
+
+        for (quint64 eventIndex = beginIndex; eventIndex < endIndex; ++eventIndex) {
+            events.push_back(traceRing->events[eventIndex % traceRingCapacity]);
+        }
+
+        /* Thread could overwrite the oldest events while they were copied, they are dropped */
+        const quint64 writtenIndex = traceRing->writeIndex.load(std::memory_order_acquire);
+        const quint64 validIndex = writtenIndex > traceRingCapacity ? writtenIndex - traceRingCapacity : 0;
+
+        for (quint64 eventIndex = qMax(beginIndex, validIndex); eventIndex < endIndex; ++eventIndex) {
+            const PWLottieTraceEvent& traceEvent = events[eventIndex - beginIndex];
+
+            QJsonObject args;
+            if (traceEvent.lottieHandle >= 0) {
+                args.insert("item", traceEvent.lottieHandle);
+            }
+
+            if (traceEvent.value >= 0) {
+                args.insert("value", traceEvent.value);
+            }
+
+            QJsonObject jsonEvent = {
+                { "name", traceEvent.name },
+                { "cat", "pwlottie" },
+                { "ph", traceEvent.duration >= 0 ? "X" : "i" },
+                { "ts", traceEvent.start / 1000.0 },
+                { "pid", processId },
+                { "tid", traceRing->threadId },
+                { "args", args },
+            };
+
+            if (traceEvent.duration >= 0) {
+                jsonEvent.insert("dur", traceEvent.duration / 1000.0);
+            } else {
+                jsonEvent.insert("s", "t");
+            }
+
+            traceEvents.append(jsonEvent);
+        }
+    }
+
+    return QJsonDocument(QJsonObject { { "traceEvents", traceEvents }, { "displayTimeUnit", "ms" } }).toJson(QJsonDocument::Compact);
+}
+
+///
+/// \brief PWLottieTrace::dump - Function writes recorded events of all threads in file.
+/// \param filePath - Path of trace file.
+/// \return Returns true if file was written.
+///
+bool PWLottieTrace::dump(const QString& filePath)
+{
+    QFile traceFile(filePath);
+    if (!traceFile.open(QFile::WriteOnly | QFile::Truncate)) {
+        qWarning() << "Couldn't open trace file with error:" << traceFile.errorString();
+
+        return false;
+    }
+
+    return traceFile.write(toJson()) >= 0;
+}
+
+///
+/// \brief PWLottieTrace::clear - Function removes all recorded events.
+///
+void PWLottieTrace::clear()
+{
+    QMutexLocker locker(&m_mutex);
+
+    /* Rings are written without locks, so events are only hidden from the next dump */
+    for (const std::unique_ptr<TraceRing>& traceRing : m_rings) {
+        traceRing->clearIndex.store(traceRing->writeIndex.load(std::memory_order_acquire), std::memory_order_relaxed);
+    }
+}
+
+///
+/// \brief PWLottieTrace::setEnabled - Function enables or disables recording of events.
+/// \param enabled - Whether tracing is enabled.
+///
+void PWLottieTrace::setEnabled(const bool enabled)
+{
+#ifdef PWLOTTIE_NO_STATS
+    Q_UNUSED(enabled)
+#else
+    if (m_enabled.exchange(enabled, std::memory_order_relaxed) != enabled) {
+        emit enabledChanged();
+    }
+#endif
+}
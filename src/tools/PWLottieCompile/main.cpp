@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) PrivateWeb Software (https://github.com/PrivateWebSoftware) - All Rights Reserved
+ *
+ * Licensed under the Apache License 2.0 (the "License"). You may not use
+ * this file except in compliance with the License. You can obtain a copy
+ * in the file LICENSE in the source distribution
+ *
+ * Written by PrivateWeb Software <privatewebsoftware@protonmail.com>, October 2026
+ */
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+
+#include "include/PWLottieCache/PWLottieCompiledAsset.h"
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("pwlottie-compile");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Validates lottie JSON and compiles it in asset with minified JSON, that PWLottie loads without hashing it and analysing frames.");
+    parser.addHelpOption();
+
+    const QCommandLineOption precisionOption("precision", "Count of decimals that are kept in numbers.", "decimals", QString::number(defaultCompiledAssetPrecision));
+
+    parser.addOption(precisionOption);
+    parser.addPositionalArgument("input", "Lottie JSON file.");
+    parser.addPositionalArgument("output", "Compiled asset file.");
+    parser.process(app);
+
+    const QStringList arguments = parser.positionalArguments();
+
+    if (arguments.size() != 2) {
+        parser.showHelp(1);
+    }
+
+    const QString inputPath = arguments.at(0);
+    const QString outputPath = arguments.at(1);
+
+    QFile inputFile(inputPath);
+    if (!inputFile.open(QFile::ReadOnly)) {
+        qCritical().noquote() << inputPath << ": couldn't open lottie file with error:" << inputFile.errorString();
+
+        return 1;
+    }
+
+    QString error;
+    const QByteArray compiledAsset = PWLottieCompiledAsset::compile(inputFile.readAll(), QFileInfo(inputPath).absolutePath(), parser.value(precisionOption).toInt(), error);
+
+    /* Invalid animation fails the build, instead of failing at runtime */
+    if (compiledAsset.isEmpty()) {
+        qCritical().noquote() << inputPath << ": invalid lottie animation:" << error;
+
+        return 1;
+    }
+
+    QDir().mkpath(QFileInfo(outputPath).absolutePath());
+
+    QSaveFile outputFile(outputPath);
+    if (!outputFile.open(QFile::WriteOnly) || outputFile.write(compiledAsset) != compiledAsset.size() || !outputFile.commit()) {
+        qCritical().noquote() << outputPath << ": couldn't write compiled asset with error:" << outputFile.errorString();
+
+        return 1;
+    }
+
+    return 0;
+}
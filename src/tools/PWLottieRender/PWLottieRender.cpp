@@ -0,0 +1,276 @@
+/*
+ * Copyright (C) PrivateWeb Software (https://github.com/PrivateWebSoftware) - All Rights Reserved
+ *
+ * Licensed under the Apache License 2.0 (the "License"). You may not use
+ * this file except in compliance with the License. You can obtain a copy
+ * in the file LICENSE in the source distribution
+ *
+ * Written by PrivateWeb Software <privatewebsoftware@protonmail.com>, October 2026
+ */
+
+#include "PWLottieRender.h"
+
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QImageWriter>
+#include <QSysInfo>
+
+#include "include/PWLottieCache/PWLottieBufferPool.h"
+#include "include/PWLottieCache/PWLottieCache.h"
+#include "include/PWLottiePixels/PWLottiePixels.h"
+#include "include/PWLottieRenderScheduler/PWLottieRenderScheduler.h"
+
+PWLottieRender::PWLottieRender(const Options& options)
+    : m_options(options)
+{
+}
+
+///
+/// \brief PWLottieRender::run - Function renders all sources and waits until all frames are written.
+/// \return Returns JSON document with throughput of rendering.
+///
+QJsonObject PWLottieRender::run()
+{
+    PWLottieRenderScheduler::instance()->setThreadCount(m_options.threadCount);
+
+    /* Every animation is loaded once and only few of it's frames are rendered, so holds aren't searched */
+    PWLottieCache::instance()->setFrameAnalysis(false);
+
+    /* Half of budget is for models, the other half caps buffer pool, frames over it are rendered in plain images */
+    if (m_options.memoryBudget > 0) {
+        PWLottieCache::instance()->setMemoryBudget(m_options.memoryBudget / 2);
+        PWLottieBufferPool::instance()->setRetentionLimit(m_options.memoryBudget / 2);
+        PWLottieBufferPool::instance()->setMemoryLimit(m_options.memoryBudget / 2);
+    }
+
+    /* Next sources are loaded while frames of previous ones are rendered, but only few of them are kept in memory */
+    m_sourceSlotsCount = PWLottieRenderScheduler::instance()->threadCount() * sourcesPerRenderThread;
+    m_sourceSlots.release(m_sourceSlotsCount);
+
+    QDir().mkpath(m_options.outputPath);
+
+    QElapsedTimer elapsedTimer;
+    elapsedTimer.start();
+
+    for (const Source& source : std::as_const(m_options.sources)) {
+        m_sourceSlots.acquire();
+
+        std::shared_ptr<SourceJob> sourceJob = std::make_shared<SourceJob>();
+        sourceJob->source = source;
+
+        PWLottieRenderScheduler::instance()->submit([this, sourceJob]() {
+            loadSource(sourceJob);
+        });
+    }
+
+    /* All slots are free again only when every source was written */
+    m_sourceSlots.acquire(m_sourceSlotsCount);
+
+    const qreal elapsedSeconds = qMax<qreal>(elapsedTimer.nsecsElapsed() / 1e9, 1e-9);
+
+    QJsonObject result;
+    result.insert("tool", "pwlottie-render");
+    result.insert("qtVersion", qVersion());
+    result.insert("cpu", QSysInfo::currentCpuArchitecture());
+    result.insert("renderThreads", PWLottieRenderScheduler::instance()->threadCount());
+    result.insert("sources", m_options.sources.size());
+    result.insert("frames", qint64(m_renderedFrames.load()));
+    result.insert("bytesWritten", m_writtenBytes.load());
+    result.insert("seconds", elapsedSeconds);
+    result.insert("framesPerSecond", m_renderedFrames.load() / elapsedSeconds);
+    result.insert("megapixelsPerSecond", m_renderedPixels.load() / elapsedSeconds / 1e6);
+    result.insert("renderSeconds", m_renderTime.load() / 1e9);
+    result.insert("bufferPoolPeakBytes", PWLottieBufferPool::instance()->peakMemoryUsage());
+    result.insert("bufferPoolLimitHits", qint64(PWLottieBufferPool::instance()->limitHits()));
+    result.insert("failures", m_failures);
+
+    return result;
+}
+
+///
+/// \brief PWLottieRender::loadSource - Function loads source and submits render jobs of it's frames, it's called from render worker.
+/// \param sourceJob - Source that is loaded.
+///
+void PWLottieRender::loadSource(const std::shared_ptr<SourceJob>& sourceJob)
+{
+    sourceJob->model = PWLottieCache::instance()->model(sourceJob->source.path);
+
+    if (!sourceJob->model || sourceJob->model->totalFrames() <= 0) {
+        addFailure(sourceJob->source.path, "Couldn't load lottie animation");
+        m_sourceSlots.release();
+
+        return;
+    }
+
+    const QList<qint32> frames = selectedFrames(sourceJob->model->totalFrames());
+    const QList<QSize> sizes = frameSizes(sourceJob->model->defaultSize());
+
+    QDir().mkpath(QFileInfo(QDir(m_options.outputPath).filePath(sourceJob->source.outputName)).path());
+
+    /* Job keeps itself pending until all render jobs are submitted, so slot can't be freed too early */
+    sourceJob->pendingJobs = 1;
+
+    for (const QSize& size : sizes) {
+        for (qsizetype frameIndex = 0; frameIndex < frames.size(); frameIndex += framesPerRenderJob) {
+            const QList<qint32> jobFrames = frames.mid(frameIndex, framesPerRenderJob);
+
+            sourceJob->pendingJobs += 1;
+
+            PWLottieRenderScheduler::instance()->submit([this, sourceJob, size, jobFrames]() {
+                renderFrames(sourceJob, size, jobFrames);
+                finishJob(sourceJob);
+            });
+        }
+    }
+
+    finishJob(sourceJob);
+}
+
+///
+/// \brief PWLottieRender::renderFrames - Function renders frames of source in one size and writes them, it's called from render worker.
+/// \param sourceJob - Loaded source.
+/// \param size - Size of frames.
+/// \param frames - Frames that are rendered.
+///
+void PWLottieRender::renderFrames(const std::shared_ptr<SourceJob>& sourceJob, const QSize& size, const QList<qint32>& frames)
+{
+    const QString filePrefix = QDir(m_options.outputPath).filePath(QString("%1-%2x%3-").arg(sourceJob->source.outputName).arg(size.width()).arg(size.height()));
+
+    for (const qint32 frame : frames) {
+        /* One pooled buffer per worker is reused by every frame */
+        QImage frameImage = PWLottieBufferPool::instance()->image(size, QImage::Format_ARGB32_Premultiplied);
+
+        QElapsedTimer renderTimer;
+        renderTimer.start();
+
+        /* Sizes of one source share it's parsed animation, so they are rendered one after another */
+        sourceJob->model->render(frame, rlottie::Surface(reinterpret_cast<uint32_t*>(frameImage.bits()), size.width(), size.height(), frameImage.bytesPerLine()));
+
+        m_renderTime += renderTimer.nsecsElapsed();
+
+        const qint64 writtenBytes = writeFrame(frameImage, filePrefix + QString("%1").arg(frame, 5, 10, QChar('0')));
+
+        if (writtenBytes < 0) {
+            addFailure(sourceJob->source.path, QString("Couldn't write frame %1").arg(frame));
+
+            return;
+        }
+
+        m_renderedFrames += 1;
+        m_renderedPixels += quint64(size.width()) * size.height();
+        m_writtenBytes += writtenBytes;
+    }
+}
+
+///
+/// \brief PWLottieRender::writeFrame - Function writes rendered frame to output directory.
+/// \param frameImage - Frame in premultiplied ARGB32, it's converted in place.
+/// \param filePath - Path of written file without suffix.
+/// \return Returns count of written bytes or '-1' if frame wasn't written.
+///
+qint64 PWLottieRender::writeFrame(QImage& frameImage, const QString& filePath)
+{
+    if (m_options.outputFormat == OutputFormat::Rgba) {
+        /* Raw frame is straight RGBA8888 without padding, pooled images have no padding too */
+        PWLottiePixels::convert(frameImage.bits(), frameImage.bytesPerLine(), frameImage.size(), QImage::Format_RGBA8888);
+
+        QFile frameFile(filePath + ".rgba");
+        if (!frameFile.open(QFile::WriteOnly | QFile::Truncate)) {
+            return -1;
+        }
+
+        return frameFile.write(reinterpret_cast<const char*>(frameImage.constBits()), frameImage.sizeInBytes()) == frameImage.sizeInBytes() ? frameImage.sizeInBytes() : -1;
+    }
+
+    /* PNG keeps straight alpha, frame is converted by SIMD kernel instead of image writer */
+    PWLottiePixels::convert(frameImage.bits(), frameImage.bytesPerLine(), frameImage.size(), QImage::Format_ARGB32);
+    frameImage.reinterpretAsFormat(QImage::Format_ARGB32);
+
+    QImageWriter frameWriter(filePath + ".png", "png");
+    if (!frameWriter.write(frameImage)) {
+        return -1;
+    }
+
+    return QFileInfo(filePath + ".png").size();
+}
+
+///
+/// \brief PWLottieRender::selectedFrames - Function gets frames of animation that are rendered.
+/// \param totalFrames - Count of frames of animation.
+/// \return Returns frames in order they are written.
+///
+QList<qint32> PWLottieRender::selectedFrames(const qint32 totalFrames) const
+{
+    QList<qint32> frames;
+
+    if (m_options.frameStep > 0) {
+        for (qint32 frame = 0; frame < totalFrames; frame += m_options.frameStep) {
+            frames.append(frame);
+        }
+
+        return frames;
+    }
+
+    /* Frames after the end are clamped, so poster frame can be taken from animations of any length */
+    for (const qint32 frame : std::as_const(m_options.frames)) {
+        const qint32 clampedFrame = qBound(0, frame, totalFrames - 1);
+
+        if (!frames.contains(clampedFrame)) {
+            frames.append(clampedFrame);
+        }
+    }
+
+    return frames;
+}
+
+///
+/// \brief PWLottieRender::frameSizes - Function gets sizes of frames for animation.
+/// \param defaultSize - Size of animation.
+/// \return Returns sizes, sizes without height keep aspect ratio of animation.
+///
+QList<QSize> PWLottieRender::frameSizes(const QSize& defaultSize) const
+{
+    if (m_options.sizes.isEmpty()) {
+        return { defaultSize };
+    }
+
+    QList<QSize> sizes;
+
+    for (const QSize& size : std::as_const(m_options.sizes)) {
+        if (size.height() > 0 || defaultSize.isEmpty()) {
+            sizes.append(QSize(size.width(), qMax(1, size.height())));
+        } else {
+            sizes.append(QSize(size.width(), qMax(1, qRound(qreal(size.width()) * defaultSize.height() / defaultSize.width()))));
+        }
+    }
+
+    return sizes;
+}
+
+///
+/// \brief PWLottieRender::finishJob - Function finishes job of source and frees it's slot when it was the last one.
+/// \param sourceJob - Source of finished job.
+///
+void PWLottieRender::finishJob(const std::shared_ptr<SourceJob>& sourceJob)
+{
+    if (sourceJob->pendingJobs.fetch_sub(1) == 1) {
+        /* Model is released, so cache can evict it before the next source is loaded */
+        sourceJob->model.reset();
+
+        m_sourceSlots.release();
+    }
+}
+
+///
+/// \brief PWLottieRender::addFailure - Function records source that couldn't be rendered.
+/// \param source - Source of lottie animation.
+/// \param error - Description of error.
+///
+void PWLottieRender::addFailure(const QString& source, const QString& error)
+{
+    QMutexLocker locker(&m_failuresMutex);
+
+    m_failures.append(QJsonObject { { "source", source }, { "error", error } });
+}
@@ -0,0 +1,166 @@
+/*
+ * Copyright (C) PrivateWeb Software (https://github.com/PrivateWebSoftware) - All Rights Reserved
+ *
+ * Licensed under the Apache License 2.0 (the "License"). You may not use
+ * this file except in compliance with the License. You can obtain a copy
+ * in the file LICENSE in the source distribution
+ *
+ * Written by PrivateWeb Software <privatewebsoftware@protonmail.com>, October 2026
+ */
+
+#ifndef PWLOTTIERENDER_H
+#define PWLOTTIERENDER_H
+
+#include <QImage>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QList>
+#include <QMutex>
+#include <QSemaphore>
+#include <QSize>
+#include <QString>
+#include <QStringList>
+
+#include <atomic>
+#include <memory>
+
+#include "include/PWLottieCache/PWLottieModel.h"
+
+///
+/// \brief The PWLottieRender class - Headless batch renderer of lottie files, it's used by 'pwlottie-render' tool.
+///
+/// Sources are loaded through PWLottieCache and rendered by workers of PWLottieRenderScheduler without any
+/// QML scene or window. Selected frames of every source and size are split in jobs of few frames, every job
+/// renders into one pooled buffer with it's own rlottie animation, so all cores are busy even with a single source.
+/// Only a few sources are loaded at the same time, so memory stays bounded for any count of sources.
+///
+class PWLottieRender {
+
+#define framesPerRenderJob 8
+#define sourcesPerRenderThread 2
+
+public:
+    ///
+    /// \brief The OutputFormat enum - Format of written frames.
+    ///
+    enum class OutputFormat {
+        Png,
+        Rgba
+    };
+
+    ///
+    /// \brief The Source struct - Lottie file and name of it's frames in output directory.
+    ///
+    struct Source {
+        QString path;
+        QString outputName;
+    };
+
+    ///
+    /// \brief The Options struct - Options of renderer, they are set from command line.
+    ///
+    struct Options {
+        QList<Source> sources = {};
+        QList<QSize> sizes = {};
+        QList<qint32> frames = { 0 };
+        qint32 frameStep = 0;
+        QString outputPath;
+        OutputFormat outputFormat = OutputFormat::Png;
+        qint32 threadCount = 0;
+        qint64 memoryBudget = 0;
+    };
+
+    explicit PWLottieRender(const Options& options);
+
+    /*************/
+    /* Functions */
+    /*************/
+
+    ///
+    /// \brief run - Function renders all sources and waits until all frames are written.
+    /// \return Returns JSON document with throughput of rendering.
+    ///
+    [[nodiscard]] QJsonObject run();
+
+private:
+    ///
+    /// \brief The SourceJob struct - Loaded source, that is shared by all of it's render jobs.
+    ///
+    struct SourceJob {
+        Source source;
+        std::shared_ptr<const PWLottieModel> model;
+        std::atomic<qint32> pendingJobs = 0;
+    };
+
+    /*************/
+    /* Functions */
+    /*************/
+
+    ///
+    /// \brief loadSource - Function loads source and submits render jobs of it's frames, it's called from render worker.
+    /// \param sourceJob - Source that is loaded.
+    ///
+    void loadSource(const std::shared_ptr<SourceJob>& sourceJob);
+
+    ///
+    /// \brief renderFrames - Function renders frames of source in one size and writes them, it's called from render worker.
+    /// \param sourceJob - Loaded source.
+    /// \param size - Size of frames.
+    /// \param frames - Frames that are rendered.
+    ///
+    void renderFrames(const std::shared_ptr<SourceJob>& sourceJob, const QSize& size, const QList<qint32>& frames);
+
+    ///
+    /// \brief writeFrame - Function writes rendered frame to output directory.
+    /// \param frameImage - Frame in premultiplied ARGB32, it's converted in place.
+    /// \param filePath - Path of written file without suffix.
+    /// \return Returns count of written bytes or '-1' if frame wasn't written.
+    ///
+    [[nodiscard]] qint64 writeFrame(QImage& frameImage, const QString& filePath);
+
+    ///
+    /// \brief selectedFrames - Function gets frames of animation that are rendered.
+    /// \param totalFrames - Count of frames of animation.
+    /// \return Returns frames in order they are written.
+    ///
+    [[nodiscard]] QList<qint32> selectedFrames(const qint32 totalFrames) const;
+
+    ///
+    /// \brief frameSizes - Function gets sizes of frames for animation.
+    /// \param defaultSize - Size of animation.
+    /// \return Returns sizes, sizes without height keep aspect ratio of animation.
+    ///
+    [[nodiscard]] QList<QSize> frameSizes(const QSize& defaultSize) const;
+
+    ///
+    /// \brief finishJob - Function finishes job of source and frees it's slot when it was the last one.
+    /// \param sourceJob - Source of finished job.
+    ///
+    void finishJob(const std::shared_ptr<SourceJob>& sourceJob);
+
+    ///
+    /// \brief addFailure - Function records source that couldn't be rendered.
+    /// \param source - Source of lottie animation.
+    /// \param error - Description of error.
+    ///
+    void addFailure(const QString& source, const QString& error);
+
+    /*************/
+    /* Variables */
+    /*************/
+
+    Options m_options;
+
+    QSemaphore m_sourceSlots;
+    qint32 m_sourceSlotsCount = 0;
+
+    std::atomic<quint64> m_renderedFrames = 0;
+    std::atomic<quint64> m_renderedPixels = 0;
+    std::atomic<qint64> m_writtenBytes = 0;
+    std::atomic<qint64> m_renderTime = 0;
+
+    QMutex m_failuresMutex;
+    QJsonArray m_failures;
+};
+
+#endif // PWLOTTIERENDER_H
@@ -0,0 +1,177 @@
+/*
+ * Copyright (C) PrivateWeb Software (https://github.com/PrivateWebSoftware) - All Rights Reserved
+ *
+ * Licensed under the Apache License 2.0 (the "License"). You may not use
+ * this file except in compliance with the License. You can obtain a copy
+ * in the file LICENSE in the source distribution
+ *
+ * Written by PrivateWeb Software <privatewebsoftware@protonmail.com>, October 2026
+ */
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDebug>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QTextStream>
+
+#include "PWLottieRender.h"
+
+///
+/// \brief addSources - Function adds lottie file or all lottie files of directory.
+/// \param path - Path of file or directory.
+/// \param sources - Sources of renderer.
+///
+static void addSources(const QString& path, QList<PWLottieRender::Source>& sources)
+{
+    const QFileInfo pathInfo(path);
+
+    if (!pathInfo.isDir()) {
+        sources.append({ path, pathInfo.completeBaseName() });
+
+        return;
+    }
+
+    /* Frames of files from subdirectories are written to the same subdirectories of output */
+    const QDir directory(path);
+    QStringList filePaths;
+
+    QDirIterator directoryIterator(path, { "*.json", "*.tgs", "*.lottie" }, QDir::Files, QDirIterator::Subdirectories);
+    while (directoryIterator.hasNext()) {
+        filePaths.append(directoryIterator.next());
+    }
+
+    filePaths.sort();
+
+    for (const QString& filePath : std::as_const(filePaths)) {
+        const QFileInfo fileInfo(filePath);
+        const QString relativePath = directory.relativeFilePath(fileInfo.path());
+
+        sources.append({ filePath, relativePath == "." ? fileInfo.completeBaseName() : relativePath + "/" + fileInfo.completeBaseName() });
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("pwlottie-render");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Renders thumbnails and frame sequences of lottie files on all cores, without QML scene or window. Throughput summary is written as JSON.");
+    parser.addHelpOption();
+
+    const QCommandLineOption listOption("list", "File with one lottie source per line.", "file");
+    const QCommandLineOption outputOption("output", "Directory where frames are written.", "path", ".");
+    const QCommandLineOption sizeOption("size", "Comma separated sizes of frames, 'W' keeps aspect ratio of animation, 'WxH' doesn't. Size of animation by default.", "sizes");
+    const QCommandLineOption framesOption("frames", "Rendered frames: comma separated frame numbers, 'every:N' or 'all'.", "selection", "0");
+    const QCommandLineOption formatOption("format", "Format of frames: 'png' or 'rgba' (raw straight RGBA8888).", "format", "png");
+    const QCommandLineOption threadsOption("threads", "Count of render threads, '0' to use count of cores.", "count", "0");
+    const QCommandLineOption memoryOption("memory", "Memory budget of cached animations and retention limit of free frame buffers in MiB.", "mebibytes", "0");
+    const QCommandLineOption summaryOption("summary", "File where JSON summary is written, standard output by default.", "file");
+
+    parser.addOptions({ listOption, outputOption, sizeOption, framesOption, formatOption, threadsOption, memoryOption, summaryOption });
+    parser.addPositionalArgument("sources", "Lottie files (.json, .tgs, .lottie) or directories with them.", "[sources...]");
+    parser.process(app);
+
+    PWLottieRender::Options options;
+
+    for (const QString& path : parser.positionalArguments()) {
+        addSources(path, options.sources);
+    }
+
+    if (parser.isSet(listOption)) {
+        QFile listFile(parser.value(listOption));
+        if (!listFile.open(QFile::ReadOnly | QFile::Text)) {
+            qCritical().noquote() << listFile.fileName() << ": couldn't open list of sources with error:" << listFile.errorString();
+
+            return 1;
+        }
+
+        while (!listFile.atEnd()) {
+            const QString path = QString::fromUtf8(listFile.readLine()).trimmed();
+
+            if (!path.isEmpty()) {
+                addSources(path, options.sources);
+            }
+        }
+    }
+
+    if (options.sources.isEmpty()) {
+        parser.showHelp(1);
+    }
+
+    for (const QString& size : parser.value(sizeOption).split(',', Qt::SkipEmptyParts)) {
+        const QStringList sides = size.trimmed().split('x');
+        const qint32 width = sides.at(0).toInt();
+        const qint32 height = sides.size() > 1 ? sides.at(1).toInt() : 0;
+
+        if (width <= 0 || height < 0 || sides.size() > 2) {
+            qCritical().noquote() << "Invalid size:" << size;
+
+            return 1;
+        }
+
+        options.sizes.append(QSize(width, height));
+    }
+
+    const QString frames = parser.value(framesOption).trimmed();
+
+    if (frames == "all") {
+        options.frameStep = 1;
+    } else if (frames.startsWith("every:")) {
+        options.frameStep = frames.mid(6).toInt();
+    } else {
+        options.frames.clear();
+
+        for (const QString& frame : frames.split(',', Qt::SkipEmptyParts)) {
+            bool valid = false;
+            options.frames.append(frame.trimmed().toInt(&valid));
+
+            if (!valid) {
+                options.frames.clear();
+
+                break;
+            }
+        }
+    }
+
+    if (options.frameStep <= 0 && options.frames.isEmpty()) {
+        qCritical().noquote() << "Invalid frames:" << frames;
+
+        return 1;
+    }
+
+    if (parser.value(formatOption) == "rgba") {
+        options.outputFormat = PWLottieRender::OutputFormat::Rgba;
+    } else if (parser.value(formatOption) != "png") {
+        qCritical().noquote() << "Unknown format:" << parser.value(formatOption);
+
+        return 1;
+    }
+
+    options.outputPath = parser.value(outputOption);
+    options.threadCount = qMax(0, parser.value(threadsOption).toInt());
+    options.memoryBudget = qMax<qint64>(0, parser.value(memoryOption).toLongLong()) * 1024 * 1024;
+
+    PWLottieRender render(options);
+    const QJsonObject result = render.run();
+    const QByteArray resultJson = QJsonDocument(result).toJson(QJsonDocument::Indented);
+
+    if (parser.isSet(summaryOption)) {
+        QFile summaryFile(parser.value(summaryOption));
+        if (!summaryFile.open(QFile::WriteOnly | QFile::Truncate)) {
+            qCritical() << "Couldn't open summary file with error:" << summaryFile.errorString();
+
+            return 1;
+        }
+
+        summaryFile.write(resultJson);
+    } else {
+        QTextStream(stdout) << resultJson;
+    }
+
+    return result.value("failures").toArray().isEmpty() ? 0 : 1;
+}
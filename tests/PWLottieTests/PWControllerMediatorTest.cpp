@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) PrivateWeb Software (https://github.com/PrivateWebSoftware) - All Rights Reserved
+ *
+ * Licensed under the Apache License 2.0 (the "License"). You may not use
+ * this file except in compliance with the License. You can obtain a copy
+ * in the file LICENSE in the source distribution
+ *
+ * Written by PrivateWeb Software <privatewebsoftware@protonmail.com>, October 2026
+ */
+
+#include <QTest>
+
+#include <PWControllerMediator/PWControllerMediator.h>
+#include <PWLottieItem/PWLottieItem.h>
+
+#include <memory>
+
+///
+/// \brief The PWControllerMediatorTest class - Checks handles of lottie items and delivery of framerates by them.
+///
+class PWControllerMediatorTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void handlesAreReused();
+    void frameRateReachesOnlyItemsOfController();
+    void frameRateReachesOnlyItsItem();
+};
+
+void PWControllerMediatorTest::handlesAreReused()
+{
+    std::unique_ptr<PWLottieItem> firstItem = std::make_unique<PWLottieItem>();
+    const std::unique_ptr<PWLottieItem> secondItem = std::make_unique<PWLottieItem>();
+
+    const PWLottieHandle firstHandle = firstItem->stats().lottieHandle;
+
+    QVERIFY(firstHandle >= 0);
+    QVERIFY(secondItem->stats().lottieHandle >= 0);
+    QVERIFY(secondItem->stats().lottieHandle != firstHandle);
+
+    QVERIFY(PWControllerMediator::lottieItems().contains(firstItem.get()));
+    QVERIFY(PWControllerMediator::lottieItems().contains(secondItem.get()));
+
+    /* Deleted item leaves registry and it's handle is taken by the next item */
+    PWLottieItem* const deletedItem = firstItem.get();
+    firstItem.reset();
+
+    QVERIFY(!PWControllerMediator::lottieItems().contains(deletedItem));
+    QVERIFY(PWControllerMediator::lottieItems().contains(secondItem.get()));
+
+    const std::unique_ptr<PWLottieItem> thirdItem = std::make_unique<PWLottieItem>();
+    QCOMPARE(thirdItem->stats().lottieHandle, firstHandle);
+}
+
+void PWControllerMediatorTest::frameRateReachesOnlyItemsOfController()
+{
+    const std::unique_ptr<PWLottieItem> adaptiveItem = std::make_unique<PWLottieItem>();
+    const std::unique_ptr<PWLottieItem> budgetItem = std::make_unique<PWLottieItem>();
+    const std::unique_ptr<PWLottieItem> lottieItem = std::make_unique<PWLottieItem>();
+
+    adaptiveItem->setController(PWControllerMediator::AdaptiveController);
+    budgetItem->setController(PWControllerMediator::BudgetController);
+
+    adaptiveItem->setFrameRate(24);
+    budgetItem->setFrameRate(24);
+    lottieItem->setFrameRate(24);
+
+    /* Framerate for all items of controller doesn't touch items of other controllers and items without controller */
+    emit PWControllerMediator::adaptiveController()->fpsChanged(15);
+
+    QCOMPARE(adaptiveItem->frameRate(), quint16(15));
+    QCOMPARE(budgetItem->frameRate(), quint16(24));
+    QCOMPARE(lottieItem->frameRate(), quint16(24));
+
+    /* Item that left controller isn't notified by it anymore */
+    adaptiveItem->setController(PWControllerMediator::NoController);
+
+    emit PWControllerMediator::adaptiveController()->fpsChanged(10);
+    QCOMPARE(adaptiveItem->frameRate(), quint16(15));
+}
+
+void PWControllerMediatorTest::frameRateReachesOnlyItsItem()
+{
+    const std::unique_ptr<PWLottieItem> firstItem = std::make_unique<PWLottieItem>();
+    const std::unique_ptr<PWLottieItem> secondItem = std::make_unique<PWLottieItem>();
+    const std::unique_ptr<PWLottieItem> budgetItem = std::make_unique<PWLottieItem>();
+
+    firstItem->setController(PWControllerMediator::AdaptiveController);
+    secondItem->setController(PWControllerMediator::AdaptiveController);
+    budgetItem->setController(PWControllerMediator::BudgetController);
+
+    firstItem->setFrameRate(24);
+    secondItem->setFrameRate(24);
+    budgetItem->setFrameRate(24);
+
+    emit PWControllerMediator::adaptiveController()->fpsChanged(15, firstItem->stats().lottieHandle);
+
+    QCOMPARE(firstItem->frameRate(), quint16(15));
+    QCOMPARE(secondItem->frameRate(), quint16(24));
+
+    /* Controller can't change framerate of item that belongs to another controller */
+    emit PWControllerMediator::adaptiveController()->fpsChanged(15, budgetItem->stats().lottieHandle);
+    QCOMPARE(budgetItem->frameRate(), quint16(24));
+
+    /* Unknown handles are ignored */
+    emit PWControllerMediator::adaptiveController()->fpsChanged(15, PWLottieHandle(1000000));
+    QCOMPARE(secondItem->frameRate(), quint16(24));
+}
+
+QTEST_MAIN(PWControllerMediatorTest)
+
+#include "PWControllerMediatorTest.moc"
@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) PrivateWeb Software (https://github.com/PrivateWebSoftware) - All Rights Reserved
+ *
+ * Licensed under the Apache License 2.0 (the "License"). You may not use
+ * this file except in compliance with the License. You can obtain a copy
+ * in the file LICENSE in the source distribution
+ *
+ * Written by PrivateWeb Software <privatewebsoftware@protonmail.com>, October 2026
+ */
+
+#include <QSignalSpy>
+#include <QTest>
+
+#include <PWLottieControllers/PWLottieAdaptiveController.h>
+#include <PWLottieFrameClock/PWLottieFrameClock.h>
+#include <PWLottieItem/PWLottieItem.h>
+#include <PWLottieRenderScheduler/PWLottieRenderScheduler.h>
+
+#include <memory>
+
+#define adaptiveTestTimeout 10000
+
+/* Display framerate that is held, it's low, so slow timer of test platform isn't taken for overloaded GUI thread */
+#define adaptiveTestTargetFrameRate 30
+
+///
+/// \brief The PWLottieAdaptiveControllerTest class - Checks that adaptive controller lowers and raises framerates by measured render load.
+///
+/// Frame clock is kept running by an item without source, so controller sees measured display frame interval.
+/// Render times are reported by test, one render worker makes render load easy to predict.
+///
+class PWLottieAdaptiveControllerTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void init();
+    void cleanup();
+    void newItemGetsCommonFrameRate();
+    void stoppedClockKeepsFrameRate();
+    void globalModeLowersAndRaises();
+    void perItemModeLowersExpensiveItem();
+
+private:
+    /*************/
+    /* Variables */
+    /*************/
+
+    std::unique_ptr<PWLottieItem> m_clockItem;
+    std::unique_ptr<PWLottieAdaptiveController> m_controller;
+};
+
+void PWLottieAdaptiveControllerTest::initTestCase()
+{
+    PWLottieRenderScheduler::instance()->setThreadCount(1);
+
+    m_clockItem = std::make_unique<PWLottieItem>();
+}
+
+void PWLottieAdaptiveControllerTest::cleanupTestCase()
+{
+    m_clockItem.reset();
+    PWLottieRenderScheduler::instance()->setThreadCount(0);
+}
+
+void PWLottieAdaptiveControllerTest::init()
+{
+    m_controller = std::make_unique<PWLottieAdaptiveController>(nullptr);
+    m_controller->setTargetFrameRate(adaptiveTestTargetFrameRate);
+
+    PWLottieFrameClock::instance()->registerLottieItem(m_clockItem.get());
+    QTRY_VERIFY_WITH_TIMEOUT(PWLottieFrameClock::instance()->hasDisplayFrameInterval(), adaptiveTestTimeout);
+}
+
+void PWLottieAdaptiveControllerTest::cleanup()
+{
+    PWLottieFrameClock::instance()->unregisterLottieItem(m_clockItem.get());
+
+    m_controller.reset();
+}
+
+void PWLottieAdaptiveControllerTest::newItemGetsCommonFrameRate()
+{
+    QSignalSpy fpsSpy(m_controller.get(), &PWLottieAdaptiveController::fpsChanged);
+
+    QCOMPARE(m_controller->addLottieItem({ 0, QSize(100, 100) }), quint16(60));
+    QCOMPARE(m_controller->addLottieItem({ 1, QSize(100, 100) }), quint16(60));
+
+    /* All items continue from the common level in the new mode */
+    m_controller->setMode(PWLottieAdaptiveController::Mode::PerItem);
+
+    QCOMPARE(fpsSpy.count(), 1);
+    QCOMPARE(fpsSpy.first().at(0).value<quint16>(), quint16(60));
+    QCOMPARE(fpsSpy.first().at(1).value<PWLottieHandle>(), PWLottieHandle(allLottiesHandle));
+}
+
+void PWLottieAdaptiveControllerTest::stoppedClockKeepsFrameRate()
+{
+    PWLottieFrameClock::instance()->unregisterLottieItem(m_clockItem.get());
+
+    QSignalSpy fpsSpy(m_controller.get(), &PWLottieAdaptiveController::fpsChanged);
+
+    m_controller->addLottieItem({ 0, QSize(100, 100) });
+    m_controller->reportRenderTime(0, qint64(100) * 1000000);
+
+    /* Several evaluations pass, but display interval of stopped clock is outdated */
+    QTest::qWait(adaptiveEvaluationInterval * 3);
+    QCOMPARE(fpsSpy.count(), 0);
+}
+
+void PWLottieAdaptiveControllerTest::globalModeLowersAndRaises()
+{
+    QSignalSpy fpsSpy(m_controller.get(), &PWLottieAdaptiveController::fpsChanged);
+
+    m_controller->addLottieItem({ 0, QSize(100, 100) });
+
+    /* Unknown handles are ignored */
+    m_controller->reportRenderTime(1, qint64(100) * 1000000);
+
+    QTest::qWait(adaptiveEvaluationInterval * 2);
+    QCOMPARE(fpsSpy.count(), 0);
+
+    /* 100 ms per frame at 60 fps is far more than one worker can render */
+    m_controller->reportRenderTime(0, qint64(100) * 1000000);
+
+    QTRY_VERIFY_WITH_TIMEOUT(fpsSpy.count() > 0, adaptiveTestTimeout);
+    QCOMPARE(fpsSpy.first().at(0).value<quint16>(), quint16(45));
+    QCOMPARE(fpsSpy.first().at(1).value<PWLottieHandle>(), PWLottieHandle(allLottiesHandle));
+
+    /* Cheap frames smooth render time down, framerate comes back only after calm evaluations */
+    for (qint32 frame = 0; frame < 100; ++frame) {
+        m_controller->reportRenderTime(0, 1);
+    }
+
+    QTRY_COMPARE_WITH_TIMEOUT(fpsSpy.last().at(0).value<quint16>(), quint16(60), adaptiveTestTimeout);
+}
+
+void PWLottieAdaptiveControllerTest::perItemModeLowersExpensiveItem()
+{
+    m_controller->setMode(PWLottieAdaptiveController::Mode::PerItem);
+
+    QSignalSpy fpsSpy(m_controller.get(), &PWLottieAdaptiveController::fpsChanged);
+
+    m_controller->addLottieItem({ 0, QSize(100, 100) });
+    m_controller->addLottieItem({ 1, QSize(100, 100) });
+
+    /*
+     * Expensive item loads worker a bit over high threshold at 60 fps, at 45 fps it's between thresholds.
+     * So only it's framerate is lowered, and then nothing changes anymore.
+     */
+    m_controller->reportRenderTime(0, qint64(14500000));
+    m_controller->reportRenderTime(1, qint64(1000));
+
+    QTRY_VERIFY_WITH_TIMEOUT(fpsSpy.count() > 0, adaptiveTestTimeout);
+    QCOMPARE(fpsSpy.first().at(0).value<quint16>(), quint16(45));
+    QCOMPARE(fpsSpy.first().at(1).value<PWLottieHandle>(), PWLottieHandle(0));
+
+    QTest::qWait(adaptiveEvaluationInterval * 3);
+    QCOMPARE(fpsSpy.count(), 1);
+}
+
+QTEST_MAIN(PWLottieAdaptiveControllerTest)
+
+#include "PWLottieAdaptiveControllerTest.moc"
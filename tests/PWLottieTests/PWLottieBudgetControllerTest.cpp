@@ -0,0 +1,255 @@
+/*
+ * Copyright (C) PrivateWeb Software (https://github.com/PrivateWebSoftware) - All Rights Reserved
+ *
+ * Licensed under the Apache License 2.0 (the "License"). You may not use
+ * this file except in compliance with the License. You can obtain a copy
+ * in the file LICENSE in the source distribution
+ *
+ * Written by PrivateWeb Software <privatewebsoftware@protonmail.com>, October 2026
+ */
+
+#include <QCoreApplication>
+#include <QHash>
+#include <QSignalSpy>
+#include <QTest>
+
+#include <PWLottieControllers/PWLottieBudgetController.h>
+
+#include <memory>
+
+/* Budget of test fits 80 frames of one 100x100 item per second */
+#define budgetTestPixelsPerSecond 800000
+
+///
+/// \brief The PWLottieBudgetControllerTest class - Checks how budget controller shares rasterisation budget between items.
+///
+class PWLottieBudgetControllerTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+    void equalSplit();
+    void allocationIsBatched();
+    void cappedBudgetIsRedistributed();
+    void biggerItemPlaysSmoother();
+    void culledItemGetsMinFrameRate();
+    void minFrameRateIsKept();
+    void removedItemGivesBudgetBack();
+    void frameRateRange();
+
+private:
+    /*************/
+    /* Functions */
+    /*************/
+
+    ///
+    /// \brief addItem - Function adds item to controller and remembers it's initial framerate.
+    /// \param lottieHandle - Handle of item.
+    /// \param size - Size of item, empty size is size of culled item.
+    /// \param priority - Priority of item.
+    ///
+    void addItem(const PWLottieHandle lottieHandle, const QSize& size, const qreal priority = 1.0);
+
+    ///
+    /// \brief allocate - Function processes queued allocation of budget.
+    ///
+    static void allocate();
+
+    /*************/
+    /* Variables */
+    /*************/
+
+    std::unique_ptr<PWLottieBudgetController> m_controller;
+
+    QHash<PWLottieHandle, quint16> m_frameRates = {};
+};
+
+void PWLottieBudgetControllerTest::init()
+{
+    m_controller = std::make_unique<PWLottieBudgetController>(nullptr);
+    m_frameRates.clear();
+
+    connect(m_controller.get(), &PWLottieBudgetController::fpsChanged, this, [this](const quint16 fps, const PWLottieHandle lottieHandle) {
+        m_frameRates.insert(lottieHandle, fps);
+    });
+
+    m_controller->setPixelsPerSecond(budgetTestPixelsPerSecond);
+    allocate();
+}
+
+void PWLottieBudgetControllerTest::cleanup()
+{
+    m_controller.reset();
+}
+
+void PWLottieBudgetControllerTest::equalSplit()
+{
+    addItem(1, QSize(100, 100));
+    addItem(2, QSize(100, 100));
+
+    allocate();
+
+    QCOMPARE(m_frameRates.value(1), quint16(40));
+    QCOMPARE(m_frameRates.value(2), quint16(40));
+}
+
+void PWLottieBudgetControllerTest::allocationIsBatched()
+{
+    QSignalSpy fpsChangedSpy(m_controller.get(), &PWLottieBudgetController::fpsChanged);
+
+    addItem(1, QSize(100, 100));
+    addItem(2, QSize(100, 100));
+    addItem(3, QSize(100, 100));
+
+    /* Nothing is shared until event loop runs, then budget is shared once for all items */
+    QCOMPARE(fpsChangedSpy.count(), 0);
+
+    allocate();
+
+    QCOMPARE(m_frameRates.value(1), quint16(26));
+    QCOMPARE(m_frameRates.value(2), quint16(26));
+    QCOMPARE(m_frameRates.value(3), quint16(26));
+    QCOMPARE(fpsChangedSpy.count(), 2);
+
+    /* The same sizes don't change anything */
+    m_controller->updateLottieItem({ 1, QSize(100, 100), 1.0 });
+    allocate();
+
+    QCOMPARE(fpsChangedSpy.count(), 2);
+}
+
+void PWLottieBudgetControllerTest::cappedBudgetIsRedistributed()
+{
+    addItem(1, QSize(100, 100), 9.0);
+    addItem(2, QSize(100, 100), 1.0);
+
+    allocate();
+
+    /* The first item would get 72 fps, budget of 12 frames it can't use goes to the second one */
+    QCOMPARE(m_frameRates.value(1), quint16(60));
+    QCOMPARE(m_frameRates.value(2), quint16(20));
+}
+
+void PWLottieBudgetControllerTest::biggerItemPlaysSmoother()
+{
+    m_controller->setPixelsPerSecond(8000000);
+
+    addItem(1, QSize(400, 400));
+    addItem(2, QSize(100, 100));
+
+    allocate();
+
+    /* With the same priority framerate follows square root of area: 8M * 400 / (160000 * 400 + 10000 * 100) and 8M * 100 / 65M */
+    QCOMPARE(m_frameRates.value(1), quint16(49));
+    QCOMPARE(m_frameRates.value(2), quint16(12));
+
+    /* Priority still decides between items of the same size */
+    m_controller->updateLottieItem({ 2, QSize(400, 400), 2.0 });
+    allocate();
+
+    QVERIFY(m_frameRates.value(2) > m_frameRates.value(1));
+}
+
+void PWLottieBudgetControllerTest::culledItemGetsMinFrameRate()
+{
+    addItem(1, QSize(100, 100));
+    addItem(2, QSize(100, 100));
+    addItem(3, QSize(0, 0));
+
+    QCOMPARE(m_frameRates.value(3), quint16(defaultBudgetMinFrameRate));
+
+    allocate();
+
+    QCOMPARE(m_frameRates.value(1), quint16(40));
+    QCOMPARE(m_frameRates.value(2), quint16(40));
+    QCOMPARE(m_frameRates.value(3), quint16(defaultBudgetMinFrameRate));
+
+    /* Item that is seen again takes it's share */
+    m_controller->updateLottieItem({ 3, QSize(100, 100), 1.0 });
+    allocate();
+
+    QCOMPARE(m_frameRates.value(1), quint16(26));
+    QCOMPARE(m_frameRates.value(3), quint16(26));
+
+    m_controller->updateLottieItem({ 3, QSize(0, 0), 1.0 });
+    allocate();
+
+    QCOMPARE(m_frameRates.value(1), quint16(40));
+    QCOMPARE(m_frameRates.value(3), quint16(defaultBudgetMinFrameRate));
+}
+
+void PWLottieBudgetControllerTest::minFrameRateIsKept()
+{
+    m_controller->setPixelsPerSecond(100000);
+
+    addItem(1, QSize(100, 100));
+    addItem(2, QSize(100, 100));
+
+    allocate();
+
+    /* Each item would get only 5 fps */
+    QCOMPARE(m_frameRates.value(1), quint16(defaultBudgetMinFrameRate));
+    QCOMPARE(m_frameRates.value(2), quint16(defaultBudgetMinFrameRate));
+}
+
+void PWLottieBudgetControllerTest::removedItemGivesBudgetBack()
+{
+    addItem(1, QSize(100, 100));
+    addItem(2, QSize(100, 100));
+
+    allocate();
+
+    QCOMPARE(m_frameRates.value(1), quint16(40));
+
+    m_controller->removeLottieItem(2);
+    allocate();
+
+    QCOMPARE(m_frameRates.value(1), quint16(defaultBudgetMaxFrameRate));
+}
+
+void PWLottieBudgetControllerTest::frameRateRange()
+{
+    m_controller->setFrameRateRange(15, 30);
+
+    QCOMPARE(m_controller->minFrameRate(), quint16(15));
+    QCOMPARE(m_controller->maxFrameRate(), quint16(30));
+
+    addItem(1, QSize(100, 100));
+    addItem(2, QSize(100, 100));
+    addItem(3, QSize(0, 0));
+
+    allocate();
+
+    QCOMPARE(m_frameRates.value(1), quint16(30));
+    QCOMPARE(m_frameRates.value(2), quint16(30));
+    QCOMPARE(m_frameRates.value(3), quint16(15));
+
+    /* Maximal framerate is never lower than minimal one */
+    m_controller->setFrameRateRange(20, 5);
+
+    QCOMPARE(m_controller->maxFrameRate(), quint16(20));
+}
+
+///
+/// \brief PWLottieBudgetControllerTest::addItem - Function adds item to controller and remembers it's initial framerate.
+/// \param lottieHandle - Handle of item.
+/// \param size - Size of item, empty size is size of culled item.
+/// \param priority - Priority of item.
+///
+void PWLottieBudgetControllerTest::addItem(const PWLottieHandle lottieHandle, const QSize& size, const qreal priority)
+{
+    m_frameRates.insert(lottieHandle, m_controller->addLottieItem({ lottieHandle, size, priority }));
+}
+
+///
+/// \brief PWLottieBudgetControllerTest::allocate - Function processes queued allocation of budget.
+///
+void PWLottieBudgetControllerTest::allocate()
+{
+    QCoreApplication::processEvents();
+}
+
+QTEST_GUILESS_MAIN(PWLottieBudgetControllerTest)
+
+#include "PWLottieBudgetControllerTest.moc"
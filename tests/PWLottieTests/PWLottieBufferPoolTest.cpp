@@ -0,0 +1,229 @@
+/*
+ * Copyright (C) PrivateWeb Software (https://github.com/PrivateWebSoftware) - All Rights Reserved
+ *
+ * Licensed under the Apache License 2.0 (the "License"). You may not use
+ * this file except in compliance with the License. You can obtain a copy
+ * in the file LICENSE in the source distribution
+ *
+ * Written by PrivateWeb Software <privatewebsoftware@protonmail.com>, October 2026
+ */
+
+#include <QImage>
+#include <QTest>
+
+#include <PWLottieCache/PWLottieBufferPool.h>
+
+///
+/// \brief The PWLottieBufferPoolTest class - Checks size classes, reuse, retention limit and memory limit of buffer pool.
+///
+class PWLottieBufferPoolTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+    void sizeClasses_data();
+    void sizeClasses();
+    void emptySize();
+    void reuseInSizeClass();
+    void otherSizeClassIsAllocated();
+    void zeroRetentionLimit();
+    void usedBuffersAreKeptOverLimit();
+    void memoryLimitIsCap();
+    void memoryLimitFreesFreeBuffers();
+};
+
+void PWLottieBufferPoolTest::init()
+{
+    PWLottieBufferPool::instance()->setRetentionLimit(defaultBufferPoolRetentionLimit);
+    PWLottieBufferPool::instance()->setMemoryLimit(defaultBufferPoolMemoryLimit);
+    PWLottieBufferPool::instance()->clear();
+}
+
+void PWLottieBufferPoolTest::cleanup()
+{
+    PWLottieBufferPool::instance()->setRetentionLimit(defaultBufferPoolRetentionLimit);
+    PWLottieBufferPool::instance()->setMemoryLimit(defaultBufferPoolMemoryLimit);
+    PWLottieBufferPool::instance()->clear();
+}
+
+void PWLottieBufferPoolTest::sizeClasses_data()
+{
+    QTest::addColumn<QSize>("size");
+    QTest::addColumn<qint64>("bufferSize");
+
+    QTest::newRow("1x1") << QSize(1, 1) << qint64(4096);
+    QTest::newRow("32x32") << QSize(32, 32) << qint64(4096);
+    QTest::newRow("33x32") << QSize(33, 32) << qint64(5120);
+    QTest::newRow("100x100") << QSize(100, 100) << qint64(40960);
+    QTest::newRow("128x128") << QSize(128, 128) << qint64(65536);
+    QTest::newRow("129x128") << QSize(129, 128) << qint64(81920);
+}
+
+void PWLottieBufferPoolTest::sizeClasses()
+{
+    QFETCH(QSize, size);
+    QFETCH(qint64, bufferSize);
+
+    const qint64 memoryUsage = PWLottieBufferPool::instance()->memoryUsage();
+    const quint64 allocations = PWLottieBufferPool::instance()->allocations();
+
+    const QImage image = PWLottieBufferPool::instance()->image(size, QImage::Format_ARGB32_Premultiplied);
+
+    QCOMPARE(image.size(), size);
+    QCOMPARE(image.format(), QImage::Format_ARGB32_Premultiplied);
+    QCOMPARE(image.bytesPerLine(), qsizetype(size.width()) * 4);
+    QVERIFY(quintptr(image.constBits()) % bufferAlignment == 0);
+
+    /* Every power of two is split in four classes, small buffers share the minimal one */
+    QCOMPARE(PWLottieBufferPool::instance()->memoryUsage() - memoryUsage, bufferSize);
+    QCOMPARE(PWLottieBufferPool::instance()->allocations() - allocations, quint64(1));
+}
+
+void PWLottieBufferPoolTest::emptySize()
+{
+    const quint64 allocations = PWLottieBufferPool::instance()->allocations();
+
+    QVERIFY(PWLottieBufferPool::instance()->image(QSize(0, 10), QImage::Format_ARGB32_Premultiplied).isNull());
+    QCOMPARE(PWLottieBufferPool::instance()->allocations(), allocations);
+}
+
+void PWLottieBufferPoolTest::reuseInSizeClass()
+{
+    const uchar* buffer = nullptr;
+
+    {
+        const QImage image = PWLottieBufferPool::instance()->image(QSize(100, 100), QImage::Format_ARGB32_Premultiplied);
+        buffer = image.constBits();
+    }
+
+    QCOMPARE(PWLottieBufferPool::instance()->freeMemory(), qint64(40960));
+
+    const quint64 reuses = PWLottieBufferPool::instance()->reuses();
+    const quint64 allocations = PWLottieBufferPool::instance()->allocations();
+
+    /* Other size of the same class and other format get the released buffer */
+    const QImage image = PWLottieBufferPool::instance()->image(QSize(101, 99), QImage::Format_RGBA8888_Premultiplied);
+
+    QCOMPARE(image.constBits(), buffer);
+    QCOMPARE(image.format(), QImage::Format_RGBA8888_Premultiplied);
+    QCOMPARE(PWLottieBufferPool::instance()->reuses() - reuses, quint64(1));
+    QCOMPARE(PWLottieBufferPool::instance()->allocations(), allocations);
+    QCOMPARE(PWLottieBufferPool::instance()->freeMemory(), qint64(0));
+}
+
+void PWLottieBufferPoolTest::otherSizeClassIsAllocated()
+{
+    {
+        const QImage image = PWLottieBufferPool::instance()->image(QSize(100, 100), QImage::Format_ARGB32_Premultiplied);
+    }
+
+    const quint64 reuses = PWLottieBufferPool::instance()->reuses();
+    const quint64 allocations = PWLottieBufferPool::instance()->allocations();
+
+    const QImage image = PWLottieBufferPool::instance()->image(QSize(16, 16), QImage::Format_ARGB32_Premultiplied);
+
+    QCOMPARE(PWLottieBufferPool::instance()->reuses(), reuses);
+    QCOMPARE(PWLottieBufferPool::instance()->allocations() - allocations, quint64(1));
+    QCOMPARE(PWLottieBufferPool::instance()->freeMemory(), qint64(40960));
+}
+
+void PWLottieBufferPoolTest::zeroRetentionLimit()
+{
+    PWLottieBufferPool::instance()->setRetentionLimit(0);
+
+    const qint64 memoryUsage = PWLottieBufferPool::instance()->memoryUsage();
+
+    {
+        const QImage image = PWLottieBufferPool::instance()->image(QSize(100, 100), QImage::Format_ARGB32_Premultiplied);
+
+        QCOMPARE(PWLottieBufferPool::instance()->memoryUsage() - memoryUsage, qint64(40960));
+    }
+
+    /* Released buffer doesn't fit in limit, so it's freed instead of kept */
+    QCOMPARE(PWLottieBufferPool::instance()->memoryUsage(), memoryUsage);
+    QCOMPARE(PWLottieBufferPool::instance()->freeMemory(), qint64(0));
+}
+
+void PWLottieBufferPoolTest::usedBuffersAreKeptOverLimit()
+{
+    const QImage firstImage = PWLottieBufferPool::instance()->image(QSize(100, 100), QImage::Format_ARGB32_Premultiplied);
+
+    {
+        const QImage image = PWLottieBufferPool::instance()->image(QSize(16, 16), QImage::Format_ARGB32_Premultiplied);
+    }
+
+    QCOMPARE(PWLottieBufferPool::instance()->freeMemory(), qint64(4096));
+
+    /* Lowering limit frees only free buffers, used ones stay valid */
+    PWLottieBufferPool::instance()->setRetentionLimit(1);
+
+    QCOMPARE(PWLottieBufferPool::instance()->freeMemory(), qint64(0));
+    QCOMPARE(PWLottieBufferPool::instance()->memoryUsage(), qint64(40960));
+
+    const QImage secondImage = PWLottieBufferPool::instance()->image(QSize(100, 100), QImage::Format_ARGB32_Premultiplied);
+
+    QVERIFY(!secondImage.isNull());
+    QVERIFY(secondImage.constBits() != firstImage.constBits());
+    QCOMPARE(PWLottieBufferPool::instance()->memoryUsage(), qint64(2 * 40960));
+}
+
+void PWLottieBufferPoolTest::memoryLimitIsCap()
+{
+    /* Limit fits two buffers of 100x100 */
+    PWLottieBufferPool::instance()->setMemoryLimit(2 * 40960);
+
+    const quint64 limitHits = PWLottieBufferPool::instance()->limitHits();
+
+    QList<QImage> images;
+
+    for (qint32 image = 0; image < 4; ++image) {
+        images.append(PWLottieBufferPool::instance()->image(QSize(100, 100), QImage::Format_ARGB32_Premultiplied));
+
+        QCOMPARE(images.last().size(), QSize(100, 100));
+        QCOMPARE(images.last().format(), QImage::Format_ARGB32_Premultiplied);
+    }
+
+    /* Images over limit work the same, but pool never grows over it */
+    QCOMPARE(PWLottieBufferPool::instance()->memoryUsage(), qint64(2 * 40960));
+    QCOMPARE(PWLottieBufferPool::instance()->limitHits() - limitHits, quint64(2));
+
+    /* Plain buffers aren't given back to pool */
+    images.clear();
+
+    QCOMPARE(PWLottieBufferPool::instance()->freeMemory(), qint64(2 * 40960));
+    QCOMPARE(PWLottieBufferPool::instance()->memoryUsage(), qint64(2 * 40960));
+}
+
+void PWLottieBufferPoolTest::memoryLimitFreesFreeBuffers()
+{
+    {
+        const QImage image = PWLottieBufferPool::instance()->image(QSize(100, 100), QImage::Format_ARGB32_Premultiplied);
+    }
+
+    QCOMPARE(PWLottieBufferPool::instance()->freeMemory(), qint64(40960));
+
+    /* Free buffer of other class is freed to make room for new one under limit */
+    PWLottieBufferPool::instance()->setMemoryLimit(40960);
+
+    const quint64 limitHits = PWLottieBufferPool::instance()->limitHits();
+    const QImage image = PWLottieBufferPool::instance()->image(QSize(16, 16), QImage::Format_ARGB32_Premultiplied);
+
+    QCOMPARE(PWLottieBufferPool::instance()->limitHits(), limitHits);
+    QCOMPARE(PWLottieBufferPool::instance()->freeMemory(), qint64(0));
+    QCOMPARE(PWLottieBufferPool::instance()->memoryUsage(), qint64(4096));
+
+    /* Lowering limit frees free buffers right away */
+    {
+        const QImage otherImage = PWLottieBufferPool::instance()->image(QSize(32, 32), QImage::Format_ARGB32_Premultiplied);
+    }
+
+    PWLottieBufferPool::instance()->setMemoryLimit(4096);
+
+    QCOMPARE(PWLottieBufferPool::instance()->freeMemory(), qint64(0));
+    QCOMPARE(PWLottieBufferPool::instance()->memoryUsage(), qint64(4096));
+}
+
+QTEST_GUILESS_MAIN(PWLottieBufferPoolTest)
+
+#include "PWLottieBufferPoolTest.moc"
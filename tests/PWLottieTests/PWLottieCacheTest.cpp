@@ -0,0 +1,176 @@
+/*
+ * Copyright (C) PrivateWeb Software (https://github.com/PrivateWebSoftware) - All Rights Reserved
+ *
+ * Licensed under the Apache License 2.0 (the "License"). You may not use
+ * this file except in compliance with the License. You can obtain a copy
+ * in the file LICENSE in the source distribution
+ *
+ * Written by PrivateWeb Software <privatewebsoftware@protonmail.com>, October 2026
+ */
+
+#include <QDir>
+#include <QImage>
+#include <QTest>
+#include <QThread>
+
+#include <PWLottieCache/PWLottieCache.h>
+
+#include <memory>
+#include <vector>
+
+#define cacheTestRenderThreads 4
+
+///
+/// \brief The PWLottieCacheTest class - Checks sharing, eviction and rendering of models in lottie cache.
+///
+class PWLottieCacheTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanup();
+    void modelIsShared();
+    void usedModelIsntEvicted();
+    void evictedModelIsParsedAgain();
+    void concurrentRenders();
+
+private:
+    /*************/
+    /* Functions */
+    /*************/
+
+    ///
+    /// \brief renderFrame - Function renders frame of model in it's default size.
+    /// \param model - Model of lottie animation.
+    /// \param frame - Frame of animation.
+    /// \return Returns rendered frame.
+    ///
+    [[nodiscard]] static QImage renderFrame(const PWLottieModel& model, const qint32 frame);
+
+    /*************/
+    /* Variables */
+    /*************/
+
+    QString m_source;
+};
+
+void PWLottieCacheTest::initTestCase()
+{
+    const QDir corpus(PWLOTTIE_TESTS_CORPUS_PATH);
+    const QStringList fileNames = corpus.entryList({ "*.json" }, QDir::Files, QDir::Name);
+
+    QVERIFY(!fileNames.isEmpty());
+
+    m_source = corpus.filePath(fileNames.first());
+
+    /* Frames aren't analysed in background, so models are used only by tests */
+    PWLottieCache::instance()->setFrameAnalysis(false);
+}
+
+void PWLottieCacheTest::cleanup()
+{
+    PWLottieCache::instance()->setMemoryBudget(defaultCacheMemoryBudget);
+    PWLottieCache::instance()->clear();
+}
+
+void PWLottieCacheTest::modelIsShared()
+{
+    const quint64 hits = PWLottieCache::instance()->hits();
+
+    const std::shared_ptr<const PWLottieModel> model = PWLottieCache::instance()->model(m_source);
+    QVERIFY(model);
+
+    QCOMPARE(PWLottieCache::instance()->model(m_source), model);
+    QCOMPARE(PWLottieCache::instance()->cachedModel(m_source), model);
+    QCOMPARE(PWLottieCache::instance()->hits() - hits, quint64(2));
+
+    /* Only parsed composition is counted, JSON isn't kept after parsing */
+    QCOMPARE(PWLottieCache::instance()->memoryUsage(), model->byteCost());
+    QVERIFY(model->byteCost() > 0);
+}
+
+void PWLottieCacheTest::usedModelIsntEvicted()
+{
+    const std::shared_ptr<const PWLottieModel> model = PWLottieCache::instance()->model(m_source);
+    QVERIFY(model);
+
+    PWLottieCache::instance()->setMemoryBudget(0);
+
+    QCOMPARE(PWLottieCache::instance()->memoryUsage(), model->byteCost());
+    QCOMPARE(PWLottieCache::instance()->cachedModel(m_source), model);
+}
+
+void PWLottieCacheTest::evictedModelIsParsedAgain()
+{
+    QVERIFY(PWLottieCache::instance()->model(m_source));
+
+    PWLottieCache::instance()->setMemoryBudget(0);
+
+    /* Nothing of model stays in memory, rlottie doesn't keep it's composition either */
+    QCOMPARE(PWLottieCache::instance()->memoryUsage(), qint64(0));
+    QVERIFY(!PWLottieCache::instance()->cachedModel(m_source));
+
+    PWLottieCache::instance()->setMemoryBudget(defaultCacheMemoryBudget);
+
+    const quint64 misses = PWLottieCache::instance()->misses();
+
+    QVERIFY(PWLottieCache::instance()->model(m_source));
+    QCOMPARE(PWLottieCache::instance()->misses() - misses, quint64(1));
+}
+
+void PWLottieCacheTest::concurrentRenders()
+{
+    const std::shared_ptr<const PWLottieModel> model = PWLottieCache::instance()->model(m_source);
+    QVERIFY(model);
+    QVERIFY(model->totalFrames() > 0);
+
+    QList<QImage> expectedFrames;
+
+    for (qint32 frame = 0; frame < model->totalFrames(); ++frame) {
+        expectedFrames.append(renderFrame(*model, frame));
+    }
+
+    /* Threads share the only animation of model, every frame has to look like when it's rendered alone */
+    std::vector<QList<QImage>> threadFrames(cacheTestRenderThreads);
+    std::vector<std::unique_ptr<QThread>> renderThreads;
+
+    for (qint32 thread = 0; thread < cacheTestRenderThreads; ++thread) {
+        renderThreads.emplace_back(QThread::create([&model, &frames = threadFrames[thread], thread]() {
+            for (qint32 frame = 0; frame < model->totalFrames(); ++frame) {
+                frames.append(renderFrame(*model, (frame + thread) % model->totalFrames()));
+            }
+        }));
+
+        renderThreads.back()->start();
+    }
+
+    for (const std::unique_ptr<QThread>& renderThread : renderThreads) {
+        QVERIFY(renderThread->wait());
+    }
+
+    for (qint32 thread = 0; thread < cacheTestRenderThreads; ++thread) {
+        for (qint32 frame = 0; frame < model->totalFrames(); ++frame) {
+            QCOMPARE(threadFrames[thread].at(frame), expectedFrames.at((frame + thread) % model->totalFrames()));
+        }
+    }
+}
+
+///
+/// \brief PWLottieCacheTest::renderFrame - Function renders frame of model in it's default size.
+/// \param model - Model of lottie animation.
+/// \param frame - Frame of animation.
+/// \return Returns rendered frame.
+///
+QImage PWLottieCacheTest::renderFrame(const PWLottieModel& model, const qint32 frame)
+{
+    QImage frameImage(model.defaultSize().boundedTo(QSize(128, 128)), QImage::Format_ARGB32_Premultiplied);
+    frameImage.fill(Qt::transparent);
+
+    model.render(frame, rlottie::Surface(reinterpret_cast<uint32_t*>(frameImage.bits()), frameImage.width(), frameImage.height(), frameImage.bytesPerLine()));
+
+    return frameImage;
+}
+
+QTEST_GUILESS_MAIN(PWLottieCacheTest)
+
+#include "PWLottieCacheTest.moc"
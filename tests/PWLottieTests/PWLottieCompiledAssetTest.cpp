@@ -0,0 +1,347 @@
+/*
+ * Copyright (C) PrivateWeb Software (https://github.com/PrivateWebSoftware) - All Rights Reserved
+ *
+ * Licensed under the Apache License 2.0 (the "License"). You may not use
+ * this file except in compliance with the License. You can obtain a copy
+ * in the file LICENSE in the source distribution
+ *
+ * Written by PrivateWeb Software <privatewebsoftware@protonmail.com>, October 2026
+ */
+
+#include <QCryptographicHash>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+#include <QTest>
+#include <QtEndian>
+
+#include <PWLottieCache/PWLottieCompiledAsset.h>
+
+#include <cmath>
+
+///
+/// \brief The PWLottieCompiledAssetTest class - Checks that compiled assets keep animation and can be mapped back.
+///
+class PWLottieCompiledAssetTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void roundTrip_data();
+    void roundTrip();
+    void invalidJson_data();
+    void invalidJson();
+    void otherVersionIsRejected();
+    void compiledSource();
+
+private:
+    /*************/
+    /* Functions */
+    /*************/
+
+    ///
+    /// \brief compileFile - Function compiles lottie file of corpus.
+    /// \param filePath - Path of lottie file.
+    /// \param jsonData - Source JSON of lottie file.
+    /// \return Returns compiled asset.
+    ///
+    [[nodiscard]] static QByteArray compileFile(const QString& filePath, QByteArray& jsonData);
+
+    ///
+    /// \brief writeAsset - Function writes compiled asset into temporary directory.
+    /// \param fileName - Name of asset file.
+    /// \param data - Content of asset.
+    /// \return Returns path of asset.
+    ///
+    [[nodiscard]] QString writeAsset(const QString& fileName, const QByteArray& data) const;
+
+    ///
+    /// \brief jsonKeys - Function collects keys of all JSON objects in order they are written.
+    /// \param jsonData - JSON data.
+    /// \return Returns keys of JSON.
+    ///
+    [[nodiscard]] static QList<QByteArray> jsonKeys(const QByteArray& jsonData);
+
+    ///
+    /// \brief compareValues - Function compares JSON values, numbers can differ only by rounding.
+    /// \param value - Source value.
+    /// \param compiledValue - Compiled value.
+    /// \param tolerance - Maximal difference of numbers.
+    /// \return Returns true if values are equal.
+    ///
+    [[nodiscard]] static bool compareValues(const QJsonValue& value, const QJsonValue& compiledValue, const double tolerance);
+
+    /*************/
+    /* Variables */
+    /*************/
+
+    QTemporaryDir m_directory;
+};
+
+void PWLottieCompiledAssetTest::initTestCase()
+{
+    QVERIFY(m_directory.isValid());
+}
+
+void PWLottieCompiledAssetTest::roundTrip_data()
+{
+    QTest::addColumn<QString>("filePath");
+
+    const QDir corpus(PWLOTTIE_TESTS_CORPUS_PATH);
+
+    for (const QString& fileName : corpus.entryList({ "*.json" }, QDir::Files, QDir::Name)) {
+        QTest::newRow(qPrintable(fileName)) << corpus.filePath(fileName);
+    }
+}
+
+void PWLottieCompiledAssetTest::roundTrip()
+{
+    QFETCH(QString, filePath);
+
+    QByteArray jsonData;
+    const QByteArray compiledAsset = compileFile(filePath, jsonData);
+
+    QVERIFY(!compiledAsset.isEmpty());
+
+    PWLottieCompiledAsset asset;
+    QVERIFY(asset.open(writeAsset(QFileInfo(filePath).completeBaseName() + "." + compiledAssetSuffix, compiledAsset)));
+
+    const QByteArray compiledJson = QByteArray::fromStdString(asset.jsonData());
+
+    QCOMPARE(asset.contentHash(), QCryptographicHash::hash(compiledJson, QCryptographicHash::Sha1));
+    QVERIFY(compiledJson.size() <= jsonData.size());
+
+    /* Minifier copies tokens in order, rlottie needs keys like "ty" of shapes before others */
+    QCOMPARE(jsonKeys(compiledJson), jsonKeys(jsonData));
+
+    /* Numbers are only rounded to precision, everything else is the same */
+    const double tolerance = 0.5 / std::pow(10.0, defaultCompiledAssetPrecision) + 1e-9;
+    QVERIFY(compareValues(QJsonDocument::fromJson(jsonData).object(), QJsonDocument::fromJson(compiledJson).object(), tolerance));
+
+    /* Every frame points at the first frame of it's hold */
+    const QList<qint32> canonicalFrames = asset.canonicalFrames();
+    QVERIFY(!canonicalFrames.isEmpty());
+
+    for (qint32 frame = 0; frame < canonicalFrames.size(); ++frame) {
+        const qint32 canonicalFrame = canonicalFrames.at(frame);
+
+        QVERIFY(canonicalFrame >= 0 && canonicalFrame <= frame);
+        QCOMPARE(canonicalFrames.at(canonicalFrame), canonicalFrame);
+    }
+}
+
+void PWLottieCompiledAssetTest::invalidJson_data()
+{
+    QTest::addColumn<QByteArray>("jsonData");
+
+    QTest::newRow("truncated") << QByteArray(R"({"v":"5.7.4","layers":[)");
+    QTest::newRow("array") << QByteArray("[]");
+    QTest::newRow("not lottie") << QByteArray(R"({"name":"value"})");
+}
+
+void PWLottieCompiledAssetTest::invalidJson()
+{
+    QFETCH(QByteArray, jsonData);
+
+    QString error;
+    QVERIFY(PWLottieCompiledAsset::compile(jsonData, QString(), defaultCompiledAssetPrecision, error).isEmpty());
+    QVERIFY(!error.isEmpty());
+}
+
+void PWLottieCompiledAssetTest::otherVersionIsRejected()
+{
+    const QDir corpus(PWLOTTIE_TESTS_CORPUS_PATH);
+    const QStringList fileNames = corpus.entryList({ "*.json" }, QDir::Files, QDir::Name);
+
+    QVERIFY(!fileNames.isEmpty());
+
+    QByteArray jsonData;
+    QByteArray compiledAsset = compileFile(corpus.filePath(fileNames.first()), jsonData);
+
+    QVERIFY(!compiledAsset.isEmpty());
+
+    /* Truncated asset and asset of other version fall back to JSON source */
+    PWLottieCompiledAsset truncatedAsset;
+    QVERIFY(!truncatedAsset.open(writeAsset("truncated.pwlottie", compiledAsset.left(compiledAsset.size() - 1))));
+
+    qToLittleEndian<quint32>(compiledAssetVersion + 1, compiledAsset.data() + 4);
+
+    PWLottieCompiledAsset otherVersionAsset;
+    QVERIFY(!otherVersionAsset.open(writeAsset("version.pwlottie", compiledAsset)));
+}
+
+void PWLottieCompiledAssetTest::compiledSource()
+{
+    const QDir corpus(PWLOTTIE_TESTS_CORPUS_PATH);
+    const QStringList fileNames = corpus.entryList({ "*.json" }, QDir::Files, QDir::Name);
+
+    QVERIFY(!fileNames.isEmpty());
+
+    QByteArray jsonData;
+    const QByteArray compiledAsset = compileFile(corpus.filePath(fileNames.first()), jsonData);
+
+    QVERIFY(!compiledAsset.isEmpty());
+
+    const QString source = m_directory.filePath("source.json");
+    const QString compiledPath = writeAsset("source.pwlottie", compiledAsset);
+
+    QVERIFY(PWLottieCompiledAsset::isCompiledSource(compiledPath));
+    QVERIFY(!PWLottieCompiledAsset::isCompiledSource(source));
+
+    /* Asset without JSON is the only source */
+    QCOMPARE(PWLottieCompiledAsset::compiledSource(source), compiledPath);
+    QCOMPARE(PWLottieCompiledAsset::compiledSource(m_directory.filePath("other.json")), QString());
+
+    (void)writeAsset("source.json", jsonData);
+    QCOMPARE(PWLottieCompiledAsset::compiledSource(source), compiledPath);
+
+    /* JSON that was edited after it was compiled is loaded instead of stale asset */
+    (void)writeAsset("source.json", jsonData + "\n");
+    QCOMPARE(PWLottieCompiledAsset::compiledSource(source), QString());
+
+    /* Asset that can't be opened isn't used either */
+    (void)writeAsset("source.json", jsonData);
+    (void)writeAsset("source.pwlottie", "PWLC");
+    QCOMPARE(PWLottieCompiledAsset::compiledSource(source), QString());
+}
+
+///
+/// \brief PWLottieCompiledAssetTest::compileFile - Function compiles lottie file of corpus.
+/// \param filePath - Path of lottie file.
+/// \param jsonData - Source JSON of lottie file.
+/// \return Returns compiled asset.
+///
+QByteArray PWLottieCompiledAssetTest::compileFile(const QString& filePath, QByteArray& jsonData)
+{
+    QFile jsonFile(filePath);
+    if (!jsonFile.open(QFile::ReadOnly)) {
+        return {};
+    }
+
+    jsonData = jsonFile.readAll();
+
+    QString error;
+    const QByteArray compiledAsset = PWLottieCompiledAsset::compile(jsonData, QFileInfo(filePath).absolutePath() + "/", defaultCompiledAssetPrecision, error);
+
+    if (compiledAsset.isEmpty()) {
+        qWarning() << "Couldn't compile" << filePath << "with error:" << error;
+    }
+
+    return compiledAsset;
+}
+
+///
+/// \brief PWLottieCompiledAssetTest::writeAsset - Function writes compiled asset into temporary directory.
+/// \param fileName - Name of asset file.
+/// \param data - Content of asset.
+/// \return Returns path of asset.
+///
+QString PWLottieCompiledAssetTest::writeAsset(const QString& fileName, const QByteArray& data) const
+{
+    const QString filePath = m_directory.filePath(fileName);
+
+    QFile assetFile(filePath);
+    if (!assetFile.open(QFile::WriteOnly) || assetFile.write(data) != data.size()) {
+        qFatal("Couldn't write test asset");
+    }
+
+    return filePath;
+}
+
+///
+/// \brief PWLottieCompiledAssetTest::jsonKeys - Function collects keys of all JSON objects in order they are written.
+/// \param jsonData - JSON data.
+/// \return Returns keys of JSON.
+///
+QList<QByteArray> PWLottieCompiledAssetTest::jsonKeys(const QByteArray& jsonData)
+{
+    QList<QByteArray> keys;
+
+    for (qsizetype index = 0; index < jsonData.size(); ++index) {
+        if (jsonData.at(index) != '"') {
+            continue;
+        }
+
+        const qsizetype stringStart = index++;
+
+        while (index < jsonData.size() && jsonData.at(index) != '"') {
+            index += jsonData.at(index) == '\\' ? 2 : 1;
+        }
+
+        /* String is a key when colon follows it */
+        qsizetype next = index + 1;
+
+        while (next < jsonData.size() && (jsonData.at(next) == ' ' || jsonData.at(next) == '\t' || jsonData.at(next) == '\n' || jsonData.at(next) == '\r')) {
+            ++next;
+        }
+
+        if (next < jsonData.size() && jsonData.at(next) == ':') {
+            keys.append(jsonData.mid(stringStart + 1, index - stringStart - 1));
+        }
+    }
+
+    return keys;
+}
+
+///
+/// \brief PWLottieCompiledAssetTest::compareValues - Function compares JSON values, numbers can differ only by rounding.
+/// \param value - Source value.
+/// \param compiledValue - Compiled value.
+/// \param tolerance - Maximal difference of numbers.
+/// \return Returns true if values are equal.
+///
+bool PWLottieCompiledAssetTest::compareValues(const QJsonValue& value, const QJsonValue& compiledValue, const double tolerance)
+{
+    if (value.isDouble() && compiledValue.isDouble()) {
+        return std::abs(value.toDouble() - compiledValue.toDouble()) <= tolerance;
+    }
+
+    if (value.type() != compiledValue.type()) {
+        return false;
+    }
+
+    if (value.isArray()) {
+        const QJsonArray array = value.toArray();
+        const QJsonArray compiledArray = compiledValue.toArray();
+
+        if (array.size() != compiledArray.size()) {
+            return false;
+        }
+
+        for (qsizetype index = 0; index < array.size(); ++index) {
+            if (!compareValues(array.at(index), compiledArray.at(index), tolerance)) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    if (value.isObject()) {
+        const QJsonObject object = value.toObject();
+        const QJsonObject compiledObject = compiledValue.toObject();
+
+        if (object.keys() != compiledObject.keys()) {
+            return false;
+        }
+
+        for (auto member = object.constBegin(); member != object.constEnd(); ++member) {
+            if (!compareValues(member.value(), compiledObject.value(member.key()), tolerance)) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    return value == compiledValue;
+}
+
+QTEST_GUILESS_MAIN(PWLottieCompiledAssetTest)
+
+#include "PWLottieCompiledAssetTest.moc"
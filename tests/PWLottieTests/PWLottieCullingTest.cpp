@@ -0,0 +1,167 @@
+/*
+ * Copyright (C) PrivateWeb Software (https://github.com/PrivateWebSoftware) - All Rights Reserved
+ *
+ * Licensed under the Apache License 2.0 (the "License"). You may not use
+ * this file except in compliance with the License. You can obtain a copy
+ * in the file LICENSE in the source distribution
+ *
+ * Written by PrivateWeb Software <privatewebsoftware@protonmail.com>, October 2026
+ */
+
+#include <QQuickItem>
+#include <QQuickWindow>
+#include <QTest>
+
+#include <PWLottieItem/PWLottieItem.h>
+
+#include <memory>
+
+///
+/// \brief The PWLottieCullingTest class - Checks that items are culled and shown again right away, without waiting for frame clock.
+///
+/// Scene is a clipping viewport with content item inside, like Flickable: item is scrolled by moving content item only.
+///
+class PWLottieCullingTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+    void visibleItem();
+    void scrolledContent();
+    void movedViewport();
+    void hiddenAndTransparentParents();
+    void reparentedItem();
+
+private:
+    /*************/
+    /* Variables */
+    /*************/
+
+    std::unique_ptr<QQuickWindow> m_window;
+
+    QQuickItem* m_viewport = nullptr;
+    QQuickItem* m_content = nullptr;
+    PWLottieItem* m_lottieItem = nullptr;
+};
+
+void PWLottieCullingTest::init()
+{
+    m_window = std::make_unique<QQuickWindow>();
+    m_window->resize(400, 400);
+
+    m_viewport = new QQuickItem(m_window->contentItem());
+    m_viewport->setSize(QSizeF(100, 100));
+    m_viewport->setClip(true);
+
+    m_content = new QQuickItem(m_viewport);
+    m_content->setSize(QSizeF(100, 1000));
+
+    m_lottieItem = new PWLottieItem();
+    m_lottieItem->setSize(QSizeF(50, 50));
+    m_lottieItem->setParentItem(m_content);
+
+    m_window->show();
+    QVERIFY(QTest::qWaitForWindowExposed(m_window.get()));
+
+    /* Exposure of window isn't signalled to items, it's noticed by the next change */
+    m_lottieItem->setVisible(false);
+    m_lottieItem->setVisible(true);
+}
+
+void PWLottieCullingTest::cleanup()
+{
+    m_window.reset();
+}
+
+void PWLottieCullingTest::visibleItem()
+{
+    QVERIFY(!m_lottieItem->culled());
+}
+
+void PWLottieCullingTest::scrolledContent()
+{
+    /* Item is scrolled out of viewport, but it's still inside of window */
+    m_content->setY(-200);
+    QVERIFY(m_lottieItem->culled());
+
+    m_content->setY(-20);
+    QVERIFY(!m_lottieItem->culled());
+
+    m_content->setX(-60);
+    QVERIFY(m_lottieItem->culled());
+
+    m_content->setX(0);
+    QVERIFY(!m_lottieItem->culled());
+}
+
+void PWLottieCullingTest::movedViewport()
+{
+    m_lottieItem->setY(150);
+    QVERIFY(m_lottieItem->culled());
+
+    /* Viewport that grows shows item again */
+    m_viewport->setHeight(200);
+    QVERIFY(!m_lottieItem->culled());
+
+    m_viewport->setClip(false);
+    m_viewport->setHeight(100);
+    QVERIFY(!m_lottieItem->culled());
+
+    m_viewport->setClip(true);
+    QVERIFY(m_lottieItem->culled());
+
+    /* Item outside of window is culled even without clipping parents */
+    m_viewport->setClip(false);
+    m_viewport->setX(-300);
+    QVERIFY(m_lottieItem->culled());
+
+    m_viewport->setX(0);
+    QVERIFY(!m_lottieItem->culled());
+}
+
+void PWLottieCullingTest::hiddenAndTransparentParents()
+{
+    m_viewport->setOpacity(0.0);
+    QVERIFY(m_lottieItem->culled());
+
+    m_viewport->setOpacity(0.5);
+    QVERIFY(!m_lottieItem->culled());
+
+    m_content->setVisible(false);
+    QVERIFY(m_lottieItem->culled());
+
+    m_content->setVisible(true);
+    QVERIFY(!m_lottieItem->culled());
+}
+
+void PWLottieCullingTest::reparentedItem()
+{
+    QQuickItem* const otherViewport = new QQuickItem(m_window->contentItem());
+    otherViewport->setSize(QSizeF(100, 100));
+    otherViewport->setClip(true);
+
+    m_lottieItem->setParentItem(otherViewport);
+    QVERIFY(!m_lottieItem->culled());
+
+    /* Old parents aren't followed anymore, new ones are */
+    m_content->setY(-200);
+    QVERIFY(!m_lottieItem->culled());
+
+    otherViewport->setY(-200);
+    QVERIFY(m_lottieItem->culled());
+
+    otherViewport->setY(0);
+    QVERIFY(!m_lottieItem->culled());
+
+    /* Parent of parent is changed too */
+    otherViewport->setParentItem(m_content);
+    QVERIFY(m_lottieItem->culled());
+
+    m_content->setY(0);
+    QVERIFY(!m_lottieItem->culled());
+}
+
+QTEST_MAIN(PWLottieCullingTest)
+
+#include "PWLottieCullingTest.moc"
@@ -0,0 +1,183 @@
+/*
+ * Copyright (C) PrivateWeb Software (https://github.com/PrivateWebSoftware) - All Rights Reserved
+ *
+ * Licensed under the Apache License 2.0 (the "License"). You may not use
+ * this file except in compliance with the License. You can obtain a copy
+ * in the file LICENSE in the source distribution
+ *
+ * Written by PrivateWeb Software <privatewebsoftware@protonmail.com>, October 2026
+ */
+
+#include <QImage>
+#include <QTest>
+
+#include <PWLottieCache/PWLottieFrameCache.h>
+
+#define frameCacheTestHash "frame-cache-test"
+#define frameCacheTestFormat QImage::Format_ARGB32_Premultiplied
+
+///
+/// \brief The PWLottieFrameCacheTest class - Checks sharing, least recently used eviction and statistics of frame cache.
+///
+class PWLottieFrameCacheTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+    void sharedUsers();
+    void hitsAndMisses();
+    void leastRecentlyUsedEviction();
+    void framesWithoutUsersArentCached();
+    void lastUserDropsFrames();
+    void frameLargerThanBudget();
+
+private:
+    /*************/
+    /* Functions */
+    /*************/
+
+    ///
+    /// \brief frame - Function takes frame from cache and counts renders of frames that weren't cached.
+    /// \param frame - Number of frame.
+    /// \return Returns frame image.
+    ///
+    QImage frame(const qint32 frame);
+
+    /*************/
+    /* Variables */
+    /*************/
+
+    const QSize m_frameSize = QSize(16, 16);
+
+    qint32 m_renders = 0;
+};
+
+void PWLottieFrameCacheTest::init()
+{
+    /* Budget fits exactly two frames */
+    PWLottieFrameCache::instance()->setMemoryBudget(2 * QImage(m_frameSize, frameCacheTestFormat).sizeInBytes());
+    PWLottieFrameCache::instance()->addUser(frameCacheTestHash, m_frameSize, frameCacheTestFormat);
+
+    m_renders = 0;
+}
+
+void PWLottieFrameCacheTest::cleanup()
+{
+    PWLottieFrameCache::instance()->removeUser(frameCacheTestHash, m_frameSize, frameCacheTestFormat);
+    PWLottieFrameCache::instance()->clear();
+    PWLottieFrameCache::instance()->setMemoryBudget(defaultFrameCacheMemoryBudget);
+}
+
+void PWLottieFrameCacheTest::sharedUsers()
+{
+    /* Single user renders it's own frames */
+    QVERIFY(!PWLottieFrameCache::instance()->isShared(frameCacheTestHash, m_frameSize, frameCacheTestFormat));
+
+    PWLottieFrameCache::instance()->addUser(frameCacheTestHash, m_frameSize, frameCacheTestFormat);
+
+    QVERIFY(PWLottieFrameCache::instance()->isShared(frameCacheTestHash, m_frameSize, frameCacheTestFormat));
+    QVERIFY(!PWLottieFrameCache::instance()->isShared(frameCacheTestHash, m_frameSize * 2, frameCacheTestFormat));
+
+    /* Zero budget disables sharing */
+    PWLottieFrameCache::instance()->setMemoryBudget(0);
+    QVERIFY(!PWLottieFrameCache::instance()->isShared(frameCacheTestHash, m_frameSize, frameCacheTestFormat));
+
+    PWLottieFrameCache::instance()->removeUser(frameCacheTestHash, m_frameSize, frameCacheTestFormat);
+}
+
+void PWLottieFrameCacheTest::hitsAndMisses()
+{
+    const quint64 hits = PWLottieFrameCache::instance()->hits();
+    const quint64 misses = PWLottieFrameCache::instance()->misses();
+
+    const QImage renderedFrame = frame(0);
+    const QImage cachedFrame = frame(0);
+
+    QCOMPARE(m_renders, 1);
+    QCOMPARE(cachedFrame, renderedFrame);
+    QCOMPARE(PWLottieFrameCache::instance()->hits() - hits, quint64(1));
+    QCOMPARE(PWLottieFrameCache::instance()->misses() - misses, quint64(1));
+    QCOMPARE(PWLottieFrameCache::instance()->memoryUsage(), qint64(renderedFrame.sizeInBytes()));
+}
+
+void PWLottieFrameCacheTest::leastRecentlyUsedEviction()
+{
+    (void)frame(0);
+    (void)frame(1);
+
+    /* Hit moves the first frame to the back, so the second one is evicted by the third */
+    (void)frame(0);
+    (void)frame(2);
+
+    QCOMPARE(m_renders, 3);
+
+    (void)frame(0);
+    (void)frame(2);
+
+    QCOMPARE(m_renders, 3);
+
+    (void)frame(1);
+
+    QCOMPARE(m_renders, 4);
+    QCOMPARE(PWLottieFrameCache::instance()->memoryUsage(), qint64(2 * QImage(m_frameSize, frameCacheTestFormat).sizeInBytes()));
+}
+
+void PWLottieFrameCacheTest::framesWithoutUsersArentCached()
+{
+    PWLottieFrameCache::instance()->removeUser(frameCacheTestHash, m_frameSize, frameCacheTestFormat);
+
+    (void)frame(0);
+    (void)frame(0);
+
+    QCOMPARE(m_renders, 2);
+    QCOMPARE(PWLottieFrameCache::instance()->memoryUsage(), qint64(0));
+
+    PWLottieFrameCache::instance()->addUser(frameCacheTestHash, m_frameSize, frameCacheTestFormat);
+}
+
+void PWLottieFrameCacheTest::lastUserDropsFrames()
+{
+    (void)frame(0);
+    (void)frame(1);
+
+    QVERIFY(PWLottieFrameCache::instance()->memoryUsage() > 0);
+
+    PWLottieFrameCache::instance()->removeUser(frameCacheTestHash, m_frameSize, frameCacheTestFormat);
+
+    QCOMPARE(PWLottieFrameCache::instance()->memoryUsage(), qint64(0));
+
+    PWLottieFrameCache::instance()->addUser(frameCacheTestHash, m_frameSize, frameCacheTestFormat);
+}
+
+void PWLottieFrameCacheTest::frameLargerThanBudget()
+{
+    PWLottieFrameCache::instance()->setMemoryBudget(QImage(m_frameSize, frameCacheTestFormat).sizeInBytes() - 1);
+
+    (void)frame(0);
+    (void)frame(0);
+
+    QCOMPARE(m_renders, 2);
+    QCOMPARE(PWLottieFrameCache::instance()->memoryUsage(), qint64(0));
+}
+
+///
+/// \brief PWLottieFrameCacheTest::frame - Function takes frame from cache and counts renders of frames that weren't cached.
+/// \param frame - Number of frame.
+/// \return Returns frame image.
+///
+QImage PWLottieFrameCacheTest::frame(const qint32 frame)
+{
+    return PWLottieFrameCache::instance()->frame({ frameCacheTestHash, m_frameSize, frame, frameCacheTestFormat }, [this, frame]() {
+        m_renders += 1;
+
+        QImage image(m_frameSize, frameCacheTestFormat);
+        image.fill(qRgba(frame, frame, frame, 0xFF));
+
+        return image;
+    });
+}
+
+QTEST_GUILESS_MAIN(PWLottieFrameCacheTest)
+
+#include "PWLottieFrameCacheTest.moc"
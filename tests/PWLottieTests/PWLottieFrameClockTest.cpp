@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) PrivateWeb Software (https://github.com/PrivateWebSoftware) - All Rights Reserved
+ *
+ * Licensed under the Apache License 2.0 (the "License"). You may not use
+ * this file except in compliance with the License. You can obtain a copy
+ * in the file LICENSE in the source distribution
+ *
+ * Written by PrivateWeb Software <privatewebsoftware@protonmail.com>, October 2026
+ */
+
+#include <QDir>
+#include <QTest>
+
+#include <PWLottieFrameClock/PWLottieFrameClock.h>
+#include <PWLottieItem/PWLottieItem.h>
+
+#include <memory>
+
+#define frameClockTestTimeout 5000
+
+///
+/// \brief The PWLottieFrameClockTest class - Checks that frame clock runs only for registered items and ticks them.
+///
+class PWLottieFrameClockTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void clockRunsOnlyWithItems();
+    void displayFrameIntervalIsMeasured();
+    void playingItemIsTicked();
+
+private:
+    /*************/
+    /* Variables */
+    /*************/
+
+    QString m_source;
+};
+
+void PWLottieFrameClockTest::initTestCase()
+{
+    const QDir corpus(PWLOTTIE_TESTS_CORPUS_PATH);
+    const QStringList fileNames = corpus.entryList({ "*.json" }, QDir::Files, QDir::Name);
+
+    QVERIFY(!fileNames.isEmpty());
+
+    m_source = corpus.filePath(fileNames.first());
+
+    QCOMPARE(PWLottieFrameClock::instance()->state(), QAbstractAnimation::Stopped);
+}
+
+void PWLottieFrameClockTest::clockRunsOnlyWithItems()
+{
+    /* Items without source never register themselves, so clock is driven only by test */
+    const std::unique_ptr<PWLottieItem> firstItem = std::make_unique<PWLottieItem>();
+    const std::unique_ptr<PWLottieItem> secondItem = std::make_unique<PWLottieItem>();
+
+    PWLottieFrameClock::instance()->registerLottieItem(firstItem.get());
+    QCOMPARE(PWLottieFrameClock::instance()->state(), QAbstractAnimation::Running);
+
+    /* Item is registered only once, so one unregistration is enough */
+    PWLottieFrameClock::instance()->registerLottieItem(firstItem.get());
+    PWLottieFrameClock::instance()->unregisterLottieItem(firstItem.get());
+    QCOMPARE(PWLottieFrameClock::instance()->state(), QAbstractAnimation::Stopped);
+
+    PWLottieFrameClock::instance()->registerLottieItem(firstItem.get());
+    PWLottieFrameClock::instance()->registerLottieItem(secondItem.get());
+
+    PWLottieFrameClock::instance()->unregisterLottieItem(firstItem.get());
+    QCOMPARE(PWLottieFrameClock::instance()->state(), QAbstractAnimation::Running);
+
+    PWLottieFrameClock::instance()->unregisterLottieItem(secondItem.get());
+    QCOMPARE(PWLottieFrameClock::instance()->state(), QAbstractAnimation::Stopped);
+
+    /* Unknown item is ignored */
+    PWLottieFrameClock::instance()->unregisterLottieItem(firstItem.get());
+    QCOMPARE(PWLottieFrameClock::instance()->state(), QAbstractAnimation::Stopped);
+}
+
+void PWLottieFrameClockTest::displayFrameIntervalIsMeasured()
+{
+    const std::unique_ptr<PWLottieItem> lottieItem = std::make_unique<PWLottieItem>();
+
+    QVERIFY(!PWLottieFrameClock::instance()->hasDisplayFrameInterval());
+
+    PWLottieFrameClock::instance()->registerLottieItem(lottieItem.get());
+
+    QTRY_VERIFY_WITH_TIMEOUT(PWLottieFrameClock::instance()->hasDisplayFrameInterval(), frameClockTestTimeout);
+    QVERIFY(PWLottieFrameClock::instance()->displayFrameInterval() > 0.0);
+    QVERIFY(PWLottieFrameClock::instance()->displayFrameInterval() < 1000.0);
+
+    /* Interval of stopped clock is outdated */
+    PWLottieFrameClock::instance()->unregisterLottieItem(lottieItem.get());
+    QVERIFY(!PWLottieFrameClock::instance()->hasDisplayFrameInterval());
+}
+
+void PWLottieFrameClockTest::playingItemIsTicked()
+{
+    const std::unique_ptr<PWLottieItem> lottieItem = std::make_unique<PWLottieItem>();
+    lottieItem->setAsynchronous(false);
+    lottieItem->setSource(m_source);
+
+    /* Item without size has nothing to render */
+    QCOMPARE(PWLottieFrameClock::instance()->state(), QAbstractAnimation::Stopped);
+
+    lottieItem->setSourceSize(QSizeF(24, 24));
+    QCOMPARE(PWLottieFrameClock::instance()->state(), QAbstractAnimation::Running);
+
+    /* Item outside of any window is culled on it's first tick and it isn't rendered */
+    QTRY_VERIFY_WITH_TIMEOUT(lottieItem->culled(), frameClockTestTimeout);
+    QCOMPARE(lottieItem->renderedFrames(), quint64(0));
+
+    lottieItem->pause();
+    QCOMPARE(PWLottieFrameClock::instance()->state(), QAbstractAnimation::Stopped);
+
+    lottieItem->resume();
+    QCOMPARE(PWLottieFrameClock::instance()->state(), QAbstractAnimation::Running);
+
+    lottieItem->pause();
+}
+
+QTEST_MAIN(PWLottieFrameClockTest)
+
+#include "PWLottieFrameClockTest.moc"
@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) PrivateWeb Software (https://github.com/PrivateWebSoftware) - All Rights Reserved
+ *
+ * Licensed under the Apache License 2.0 (the "License"). You may not use
+ * this file except in compliance with the License. You can obtain a copy
+ * in the file LICENSE in the source distribution
+ *
+ * Written by PrivateWeb Software <privatewebsoftware@protonmail.com>, October 2026
+ */
+
+#include <QDir>
+#include <QImage>
+#include <QTest>
+
+#include <PWLottieCache/PWLottieCache.h>
+#include <PWLottieControllers/PWLottieIconController.h>
+
+#include <memory>
+
+#define iconTestFrameSize QSize(24, 24)
+#define iconTestTimeout 30000
+
+///
+/// \brief The PWLottieIconControllerTest class - Checks sharing, budgets and content of sprite sheets of icon controller.
+///
+class PWLottieIconControllerTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void init();
+    void cleanup();
+    void sheetIsShared();
+    void bigAndLongAnimationsAreLive();
+    void memoryBudget();
+    void unusedSheetsAreEvicted();
+    void sheetFrames();
+
+private:
+    /*************/
+    /* Variables */
+    /*************/
+
+    std::shared_ptr<const PWLottieModel> m_model;
+    std::unique_ptr<PWLottieIconController> m_controller;
+};
+
+void PWLottieIconControllerTest::initTestCase()
+{
+    const QDir corpus(PWLOTTIE_TESTS_CORPUS_PATH);
+    const QStringList fileNames = corpus.entryList({ "*.json" }, QDir::Files, QDir::Name);
+
+    QVERIFY(!fileNames.isEmpty());
+
+    PWLottieCache::instance()->setFrameAnalysis(false);
+    m_model = PWLottieCache::instance()->model(corpus.filePath(fileNames.first()));
+
+    QVERIFY(m_model);
+    QVERIFY(m_model->totalFrames() > 0);
+}
+
+void PWLottieIconControllerTest::init()
+{
+    m_controller = std::make_unique<PWLottieIconController>(nullptr);
+
+    /* Every animation of corpus fits in sheet of small frames */
+    m_controller->setMaxFrames(m_model->totalFrames());
+    m_controller->setMemoryBudget(qint64(256) * 1024 * 1024);
+}
+
+void PWLottieIconControllerTest::cleanup()
+{
+    m_controller.reset();
+}
+
+void PWLottieIconControllerTest::sheetIsShared()
+{
+    const std::shared_ptr<const PWLottieSpriteSheet> spriteSheet = m_controller->spriteSheet(m_model, iconTestFrameSize, iconTestFrameSize, QImage::Format_ARGB32_Premultiplied);
+    QVERIFY(spriteSheet);
+
+    /* Items with the same animation, size and format show one sheet, other format gets it's own */
+    QCOMPARE(m_controller->spriteSheet(m_model, iconTestFrameSize, iconTestFrameSize, QImage::Format_ARGB32_Premultiplied), spriteSheet);
+    QVERIFY(m_controller->spriteSheet(m_model, iconTestFrameSize, iconTestFrameSize, QImage::Format_RGBA8888_Premultiplied) != spriteSheet);
+
+    QCOMPARE(spriteSheet->byteCost(), PWLottieSpriteSheet::sheetByteCost(spriteSheet->image().size()));
+}
+
+void PWLottieIconControllerTest::bigAndLongAnimationsAreLive()
+{
+    m_controller->setMaxFramePixels(16 * 16);
+    QVERIFY(!m_controller->spriteSheet(m_model, iconTestFrameSize, iconTestFrameSize, QImage::Format_ARGB32_Premultiplied));
+
+    m_controller->setMaxFramePixels(defaultIconMaxFramePixels);
+    m_controller->setMaxFrames(m_model->totalFrames() - 1);
+    QVERIFY(!m_controller->spriteSheet(m_model, iconTestFrameSize, iconTestFrameSize, QImage::Format_ARGB32_Premultiplied));
+
+    QCOMPARE(m_controller->memoryUsage(), qint64(0));
+}
+
+void PWLottieIconControllerTest::memoryBudget()
+{
+    const qint64 sheetByteCost = PWLottieSpriteSheet::sheetByteCost(PWLottieSpriteSheet::sheetSize(iconTestFrameSize, m_model->totalFrames()));
+
+    /* Budget counts both sheet and it's texture, so sheet that fits only without texture is rendered live */
+    m_controller->setMemoryBudget(sheetByteCost - 1);
+    QVERIFY(!m_controller->spriteSheet(m_model, iconTestFrameSize, iconTestFrameSize, QImage::Format_ARGB32_Premultiplied));
+
+    m_controller->setMemoryBudget(sheetByteCost);
+
+    const std::shared_ptr<const PWLottieSpriteSheet> spriteSheet = m_controller->spriteSheet(m_model, iconTestFrameSize, iconTestFrameSize, QImage::Format_ARGB32_Premultiplied);
+
+    QVERIFY(spriteSheet);
+    QCOMPARE(m_controller->memoryUsage(), sheetByteCost);
+
+    /* Shown sheet is kept, so there is no room for another one */
+    QVERIFY(!m_controller->spriteSheet(m_model, iconTestFrameSize, iconTestFrameSize, QImage::Format_RGBA8888_Premultiplied));
+}
+
+void PWLottieIconControllerTest::unusedSheetsAreEvicted()
+{
+    {
+        const std::shared_ptr<const PWLottieSpriteSheet> spriteSheet = m_controller->spriteSheet(m_model, iconTestFrameSize, iconTestFrameSize, QImage::Format_ARGB32_Premultiplied);
+        QVERIFY(spriteSheet);
+
+        /* Sheet that is still rendering is referenced by it's job */
+        QTRY_VERIFY_WITH_TIMEOUT(spriteSheet->isReady(), iconTestTimeout);
+    }
+
+    QVERIFY(m_controller->memoryUsage() > 0);
+
+    /* Job of sheet can drop it's reference a bit after sheet is ready */
+    QTRY_COMPARE_WITH_TIMEOUT((m_controller->evictUnusedSpriteSheets(), m_controller->memoryUsage()), qint64(0), iconTestTimeout);
+}
+
+void PWLottieIconControllerTest::sheetFrames()
+{
+    const std::shared_ptr<const PWLottieSpriteSheet> spriteSheet = m_controller->spriteSheet(m_model, iconTestFrameSize, iconTestFrameSize, QImage::Format_ARGB32_Premultiplied);
+    QVERIFY(spriteSheet);
+
+    QTRY_VERIFY_WITH_TIMEOUT(spriteSheet->isReady(), iconTestTimeout);
+
+    for (qint32 frame = 0; frame < m_model->totalFrames(); ++frame) {
+        QImage frameImage(iconTestFrameSize, QImage::Format_ARGB32_Premultiplied);
+        frameImage.fill(Qt::transparent);
+
+        m_model->render(frame, rlottie::Surface(reinterpret_cast<uint32_t*>(frameImage.bits()), frameImage.width(), frameImage.height(), frameImage.bytesPerLine()));
+
+        /* Every frame is in it's own cell and gutter repeats edge pixels of frame */
+        const QRect frameRect = spriteSheet->frameRect(frame).toRect();
+
+        QCOMPARE(frameRect.size(), iconTestFrameSize);
+        QCOMPARE(spriteSheet->image().copy(frameRect), frameImage);
+        QCOMPARE(spriteSheet->image().pixel(frameRect.left() - 1, frameRect.top()), frameImage.pixel(0, 0));
+        QCOMPARE(spriteSheet->image().pixel(frameRect.right() + 1, frameRect.bottom()), frameImage.pixel(frameImage.width() - 1, frameImage.height() - 1));
+    }
+}
+
+QTEST_GUILESS_MAIN(PWLottieIconControllerTest)
+
+#include "PWLottieIconControllerTest.moc"
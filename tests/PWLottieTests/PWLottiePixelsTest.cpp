@@ -0,0 +1,169 @@
+/*
+ * Copyright (C) PrivateWeb Software (https://github.com/PrivateWebSoftware) - All Rights Reserved
+ *
+ * Licensed under the Apache License 2.0 (the "License"). You may not use
+ * this file except in compliance with the License. You can obtain a copy
+ * in the file LICENSE in the source distribution
+ *
+ * Written by PrivateWeb Software <privatewebsoftware@protonmail.com>, October 2026
+ */
+
+#include <QImage>
+#include <QRandomGenerator>
+#include <QTest>
+
+#include <PWLottiePixels/PWLottiePixels.h>
+
+///
+/// \brief The PWLottiePixelsTest class - Checks that SIMD kernels give exactly the same pixels as scalar reference.
+///
+/// Widths cover whole vectors of SSE2, AVX2 and NEON kernels and scalar tails after them.
+///
+class PWLottiePixelsTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void downscale_data();
+    void downscale();
+    void downscaleTwice();
+    void convert_data();
+    void convert();
+
+private:
+    ///
+    /// \brief premultipliedImage - Function creates image of random premultiplied pixels, some rows are opaque.
+    /// \param size - Size of image.
+    /// \return Returns image in premultiplied ARGB32.
+    ///
+    [[nodiscard]] static QImage premultipliedImage(const QSize& size);
+
+    ///
+    /// \brief halvedImage - Function halves image with scalar 2x2 box filter, that rounds sum of four channels once.
+    /// \param image - Image in premultiplied ARGB32.
+    /// \return Returns halved image.
+    ///
+    [[nodiscard]] static QImage halvedImage(const QImage& image);
+};
+
+void PWLottiePixelsTest::downscale_data()
+{
+    QTest::addColumn<QSize>("sourceSize");
+
+    for (const qint32 width : { 2, 6, 8, 14, 16, 18, 30, 32, 34, 62, 66, 130 }) {
+        QTest::addRow("%dx6", width) << QSize(width, 6);
+    }
+
+    /* Odd sizes drop the last column and row */
+    QTest::newRow("31x7") << QSize(31, 7);
+}
+
+void PWLottiePixelsTest::downscale()
+{
+    QFETCH(QSize, sourceSize);
+
+    QImage sourceImage = premultipliedImage(sourceSize);
+    const QImage expectedImage = halvedImage(sourceImage);
+
+    QImage targetImage(expectedImage.size(), QImage::Format_ARGB32_Premultiplied);
+    PWLottiePixels::downscale(sourceImage.bits(), sourceImage.bytesPerLine(), sourceImage.size(), targetImage.bits(), targetImage.bytesPerLine(), targetImage.size());
+
+    QCOMPARE(targetImage, expectedImage);
+}
+
+void PWLottiePixelsTest::downscaleTwice()
+{
+    /* The first step is halved in place in source pixels */
+    QImage sourceImage = premultipliedImage(QSize(132, 20));
+    const QImage expectedImage = halvedImage(halvedImage(sourceImage));
+
+    QCOMPARE(PWLottiePixels::downscaledSize(sourceImage.size(), expectedImage.size()), expectedImage.size());
+
+    QImage targetImage(expectedImage.size(), QImage::Format_ARGB32_Premultiplied);
+    PWLottiePixels::downscale(sourceImage.bits(), sourceImage.bytesPerLine(), sourceImage.size(), targetImage.bits(), targetImage.bytesPerLine(), targetImage.size());
+
+    QCOMPARE(targetImage, expectedImage);
+}
+
+void PWLottiePixelsTest::convert_data()
+{
+    QTest::addColumn<QImage::Format>("format");
+
+    QTest::newRow("ARGB32") << QImage::Format_ARGB32;
+    QTest::newRow("RGBA8888") << QImage::Format_RGBA8888;
+    QTest::newRow("RGBA8888_Premultiplied") << QImage::Format_RGBA8888_Premultiplied;
+}
+
+void PWLottiePixelsTest::convert()
+{
+    QFETCH(QImage::Format, format);
+
+    const QImage sourceImage = premultipliedImage(QSize(37, 9));
+    const QImage expectedImage = sourceImage.convertToFormat(format);
+
+    /* Pixels are converted in place, only format of image is changed after it */
+    QImage convertedImage = sourceImage.copy();
+    PWLottiePixels::convert(convertedImage.bits(), convertedImage.bytesPerLine(), convertedImage.size(), format);
+    convertedImage.reinterpretAsFormat(format);
+
+    QCOMPARE(convertedImage, expectedImage);
+}
+
+///
+/// \brief PWLottiePixelsTest::premultipliedImage - Function creates image of random premultiplied pixels, some rows are opaque.
+/// \param size - Size of image.
+/// \return Returns image in premultiplied ARGB32.
+///
+QImage PWLottiePixelsTest::premultipliedImage(const QSize& size)
+{
+    QRandomGenerator random(size.width() * 1000 + size.height());
+    QImage image(size, QImage::Format_ARGB32_Premultiplied);
+
+    for (qint32 line = 0; line < size.height(); ++line) {
+        QRgb* const pixels = reinterpret_cast<QRgb*>(image.scanLine(line));
+
+        for (qint32 column = 0; column < size.width(); ++column) {
+            const quint32 alpha = line % 3 == 0 ? 0xFF : random.bounded(256);
+
+            pixels[column] = qRgba(random.bounded(alpha + 1), random.bounded(alpha + 1), random.bounded(alpha + 1), alpha);
+        }
+    }
+
+    return image;
+}
+
+///
+/// \brief PWLottiePixelsTest::halvedImage - Function halves image with scalar 2x2 box filter, that rounds sum of four channels once.
+/// \param image - Image in premultiplied ARGB32.
+/// \return Returns halved image.
+///
+QImage PWLottiePixelsTest::halvedImage(const QImage& image)
+{
+    QImage halved(image.width() / 2, image.height() / 2, QImage::Format_ARGB32_Premultiplied);
+
+    for (qint32 line = 0; line < halved.height(); ++line) {
+        const QRgb* const row0 = reinterpret_cast<const QRgb*>(image.constScanLine(line * 2));
+        const QRgb* const row1 = reinterpret_cast<const QRgb*>(image.constScanLine(line * 2 + 1));
+        QRgb* const target = reinterpret_cast<QRgb*>(halved.scanLine(line));
+
+        for (qint32 column = 0; column < halved.width(); ++column) {
+            const QRgb pixels[4] = { row0[column * 2], row0[column * 2 + 1], row1[column * 2], row1[column * 2 + 1] };
+
+            qint32 channels[4] = { 2, 2, 2, 2 };
+
+            for (const QRgb pixel : pixels) {
+                channels[0] += qRed(pixel);
+                channels[1] += qGreen(pixel);
+                channels[2] += qBlue(pixel);
+                channels[3] += qAlpha(pixel);
+            }
+
+            target[column] = qRgba(channels[0] >> 2, channels[1] >> 2, channels[2] >> 2, channels[3] >> 2);
+        }
+    }
+
+    return halved;
+}
+
+QTEST_GUILESS_MAIN(PWLottiePixelsTest)
+
+#include "PWLottiePixelsTest.moc"
@@ -0,0 +1,268 @@
+/*
+ * Copyright (C) PrivateWeb Software (https://github.com/PrivateWebSoftware) - All Rights Reserved
+ *
+ * Licensed under the Apache License 2.0 (the "License"). You may not use
+ * this file except in compliance with the License. You can obtain a copy
+ * in the file LICENSE in the source distribution
+ *
+ * Written by PrivateWeb Software <privatewebsoftware@protonmail.com>, October 2026
+ */
+
+#include <QSemaphore>
+#include <QTest>
+#include <QThread>
+
+#include <PWLottieRenderScheduler/PWLottieRenderScheduler.h>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#define schedulerTestTimeout 10000
+
+///
+/// \brief The PWLottieRenderSchedulerTest class - Checks ordering, completeness and restarts of shared render scheduler.
+///
+class PWLottieRenderSchedulerTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void unorderedJobs();
+    void orderedQueues();
+    void jobsSubmittedFromWorkers();
+    void olderJobsArentStarved();
+    void threadCountChangeKeepsJobs();
+    void cancelledQueue();
+
+private:
+    /*************/
+    /* Functions */
+    /*************/
+
+    ///
+    /// \brief submitChain - Function submits job that submits the next job of chain from worker thread.
+    /// \param remainingJobs - Count of jobs that are left in chain.
+    ///
+    void submitChain(const qint32 remainingJobs);
+
+    /*************/
+    /* Variables */
+    /*************/
+
+    /* Semaphore outlives every test, so job that releases it last can't touch destroyed one */
+    QSemaphore m_finishedJobs;
+};
+
+void PWLottieRenderSchedulerTest::initTestCase()
+{
+    PWLottieRenderScheduler::instance()->setThreadCount(4);
+
+    QCOMPARE(PWLottieRenderScheduler::instance()->threadCount(), 4);
+}
+
+void PWLottieRenderSchedulerTest::cleanupTestCase()
+{
+    PWLottieRenderScheduler::instance()->setThreadCount(0);
+}
+
+void PWLottieRenderSchedulerTest::unorderedJobs()
+{
+    const qint32 submitterCount = 4;
+    const qint32 jobCount = 1000;
+
+    std::atomic<qint32> executedJobs = 0;
+
+    /* Jobs are submitted from several threads at once */
+    std::vector<std::unique_ptr<QThread>> submitters;
+
+    for (qint32 submitter = 0; submitter < submitterCount; ++submitter) {
+        submitters.emplace_back(QThread::create([this, &executedJobs]() {
+            for (qint32 job = 0; job < jobCount; ++job) {
+                PWLottieRenderScheduler::instance()->submit([this, &executedJobs]() {
+                    executedJobs.fetch_add(1);
+                    m_finishedJobs.release();
+                });
+            }
+        }));
+
+        submitters.back()->start();
+    }
+
+    for (const std::unique_ptr<QThread>& submitter : submitters) {
+        QVERIFY(submitter->wait(schedulerTestTimeout));
+    }
+
+    QVERIFY(m_finishedJobs.tryAcquire(submitterCount * jobCount, schedulerTestTimeout));
+    QCOMPARE(executedJobs.load(), submitterCount * jobCount);
+}
+
+void PWLottieRenderSchedulerTest::orderedQueues()
+{
+    const qint32 queueCount = 8;
+    const qint32 jobCount = 300;
+
+    struct QueueState {
+        PWLottieRenderScheduler::RenderQueuePtr queue = PWLottieRenderScheduler::createQueue();
+        QList<qint32> executedJobs;
+        std::atomic<qint32> runningJobs = 0;
+        std::atomic<bool> overlapped = false;
+    };
+
+    std::vector<std::unique_ptr<QueueState>> queueStates;
+
+    for (qint32 queue = 0; queue < queueCount; ++queue) {
+        queueStates.push_back(std::make_unique<QueueState>());
+    }
+
+    /* Jobs of different queues are interleaved, every queue has to see only it's own order */
+    for (qint32 job = 0; job < jobCount; ++job) {
+        for (const std::unique_ptr<QueueState>& queueState : queueStates) {
+            QueueState* const state = queueState.get();
+
+            PWLottieRenderScheduler::instance()->submit(state->queue, [this, state, job]() {
+                if (state->runningJobs.fetch_add(1) != 0) {
+                    state->overlapped = true;
+                }
+
+                /* Jobs of one queue never run concurrently, so list doesn't need a lock */
+                state->executedJobs.append(job);
+
+                state->runningJobs.fetch_sub(1);
+                m_finishedJobs.release();
+            });
+        }
+    }
+
+    QVERIFY(m_finishedJobs.tryAcquire(queueCount * jobCount, schedulerTestTimeout));
+
+    QList<qint32> expectedJobs;
+    for (qint32 job = 0; job < jobCount; ++job) {
+        expectedJobs.append(job);
+    }
+
+    for (const std::unique_ptr<QueueState>& queueState : queueStates) {
+        QVERIFY(!queueState->overlapped);
+        QCOMPARE(queueState->executedJobs, expectedJobs);
+    }
+}
+
+void PWLottieRenderSchedulerTest::jobsSubmittedFromWorkers()
+{
+    const qint32 jobCount = 200;
+
+    submitChain(jobCount);
+
+    QVERIFY(m_finishedJobs.tryAcquire(jobCount, schedulerTestTimeout));
+}
+
+void PWLottieRenderSchedulerTest::olderJobsArentStarved()
+{
+    const qint32 chainLength = 50;
+
+    /* With one worker nothing is stolen, so jobs run exactly in order that worker takes them */
+    PWLottieRenderScheduler::instance()->setThreadCount(1);
+
+    QSemaphore olderJobSubmitted;
+    QList<qint32> executedJobs;
+
+    /* Like ordered queue, first job resubmits the next one from worker every time it's done */
+    std::function<void(qint32)> submitNext = [this, &submitNext, &executedJobs](const qint32 job) {
+        PWLottieRenderScheduler::instance()->submit([this, &submitNext, &executedJobs, job]() {
+            executedJobs.append(job);
+
+            if (job + 1 < chainLength) {
+                submitNext(job + 1);
+            }
+
+            m_finishedJobs.release();
+        });
+    };
+
+    PWLottieRenderScheduler::instance()->submit([this, &olderJobSubmitted, &submitNext]() {
+        olderJobSubmitted.acquire();
+        submitNext(0);
+
+        m_finishedJobs.release();
+    });
+
+    PWLottieRenderScheduler::instance()->submit([this, &executedJobs]() {
+        executedJobs.append(-1);
+        m_finishedJobs.release();
+    });
+
+    olderJobSubmitted.release();
+
+    QVERIFY(m_finishedJobs.tryAcquire(chainLength + 2, schedulerTestTimeout));
+
+    /* Job that waited before chain was started runs before the rest of chain */
+    QCOMPARE(executedJobs.size(), chainLength + 1);
+    QCOMPARE(executedJobs.at(0), -1);
+    QCOMPARE(executedJobs.at(1), 0);
+
+    PWLottieRenderScheduler::instance()->setThreadCount(4);
+}
+
+void PWLottieRenderSchedulerTest::threadCountChangeKeepsJobs()
+{
+    const qint32 jobCount = 200;
+
+    const PWLottieRenderScheduler::RenderQueuePtr queue = PWLottieRenderScheduler::createQueue();
+    QList<qint32> executedJobs;
+
+    for (qint32 job = 0; job < jobCount; ++job) {
+        PWLottieRenderScheduler::instance()->submit(queue, [this, &executedJobs, job]() {
+            QThread::usleep(100);
+
+            executedJobs.append(job);
+            m_finishedJobs.release();
+        });
+    }
+
+    /* Workers are restarted while most jobs still wait, they are moved to new workers and keep their order */
+    PWLottieRenderScheduler::instance()->setThreadCount(2);
+
+    QCOMPARE(PWLottieRenderScheduler::instance()->threadCount(), 2);
+    QVERIFY(m_finishedJobs.tryAcquire(jobCount, schedulerTestTimeout));
+
+    for (qint32 job = 0; job < jobCount; ++job) {
+        QCOMPARE(executedJobs.at(job), job);
+    }
+
+    PWLottieRenderScheduler::instance()->setThreadCount(4);
+}
+
+void PWLottieRenderSchedulerTest::cancelledQueue()
+{
+    const PWLottieRenderScheduler::RenderQueuePtr queue = PWLottieRenderScheduler::createQueue();
+    const quint64 version = queue->version;
+
+    QVERIFY(!queue->isStale(version));
+
+    queue->cancel();
+
+    QVERIFY(queue->isStale(version));
+    QVERIFY(!queue->isStale(queue->version));
+}
+
+///
+/// \brief PWLottieRenderSchedulerTest::submitChain - Function submits job that submits the next job of chain from worker thread.
+/// \param remainingJobs - Count of jobs that are left in chain.
+///
+void PWLottieRenderSchedulerTest::submitChain(const qint32 remainingJobs)
+{
+    /* Job that is submitted from worker is kept in it's own deque */
+    PWLottieRenderScheduler::instance()->submit([this, remainingJobs]() {
+        if (remainingJobs > 1) {
+            submitChain(remainingJobs - 1);
+        }
+
+        m_finishedJobs.release();
+    });
+}
+
+QTEST_GUILESS_MAIN(PWLottieRenderSchedulerTest)
+
+#include "PWLottieRenderSchedulerTest.moc"
@@ -0,0 +1,372 @@
+/*
+ * Copyright (C) PrivateWeb Software (https://github.com/PrivateWebSoftware) - All Rights Reserved
+ *
+ * Licensed under the Apache License 2.0 (the "License"). You may not use
+ * this file except in compliance with the License. You can obtain a copy
+ * in the file LICENSE in the source distribution
+ *
+ * Written by PrivateWeb Software <privatewebsoftware@protonmail.com>, October 2026
+ */
+
+#include <QFile>
+#include <QRegularExpression>
+#include <QTemporaryDir>
+#include <QTest>
+#include <QtEndian>
+
+#include <PWLottieCache/PWLottieSourceReader.h>
+
+#ifdef PWLOTTIE_ZLIB
+#include <zlib.h>
+#endif
+
+#define pngSignature "\x89PNG\r\n\x1a\n"
+
+///
+/// \brief The PWLottieSourceReaderTest class - Checks detection, inflation and image embedding of lottie sources.
+///
+class PWLottieSourceReaderTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void plainJson();
+    void resourcePath();
+    void gzip();
+    void gzipGrowsBuffer();
+    void gzipTruncated();
+    void archiveEmbedsImagesInPlace();
+    void archiveDeflated();
+    void archiveWithoutAnimation();
+
+private:
+    ///
+    /// \brief The ArchiveFile struct - File that is written into test archive.
+    ///
+    struct ArchiveFile {
+        QString name;
+        QByteArray data;
+        bool deflated = false;
+    };
+
+    /*************/
+    /* Functions */
+    /*************/
+
+    ///
+    /// \brief writeSource - Function writes source into temporary directory.
+    /// \param fileName - Name of source file.
+    /// \param data - Content of source.
+    /// \return Returns path of source.
+    ///
+    [[nodiscard]] QString writeSource(const QString& fileName, const QByteArray& data) const;
+
+    ///
+    /// \brief readSource - Function reads source with PWLottieSourceReader.
+    /// \param source - Path of source.
+    /// \param jsonData - Lottie JSON.
+    /// \return Returns true if source was read.
+    ///
+    [[nodiscard]] static bool readSource(const QString& source, QByteArray& jsonData);
+
+    ///
+    /// \brief archive - Function builds zip archive, CRC of files is left empty, reader doesn't check it.
+    /// \param files - Files of archive.
+    /// \return Returns archive data.
+    ///
+    [[nodiscard]] static QByteArray archive(const QList<ArchiveFile>& files);
+
+#ifdef PWLOTTIE_ZLIB
+    ///
+    /// \brief deflated - Function compresses data with zlib.
+    /// \param data - Data that is compressed.
+    /// \param windowBits - Window bits of zlib, they select gzip or raw deflate stream.
+    /// \return Returns compressed data.
+    ///
+    [[nodiscard]] static QByteArray deflated(const QByteArray& data, const int windowBits);
+#endif
+
+    /*************/
+    /* Variables */
+    /*************/
+
+    QTemporaryDir m_directory;
+};
+
+void PWLottieSourceReaderTest::initTestCase()
+{
+    QVERIFY(m_directory.isValid());
+}
+
+void PWLottieSourceReaderTest::plainJson()
+{
+    const QByteArray jsonData = R"({"v":"5.7.4", "fr":30, "assets":[{"id":"image_0","u":"images/","p":"img_0.png","e":0}], "layers":[]})";
+    const QString source = writeSource("plain.json", jsonData);
+
+    QVERIFY(PWLottieSourceReader::sourceFormat(reinterpret_cast<const uchar*>(jsonData.constData()), jsonData.size()) == PWLottieSourceReader::SourceFormat::Json);
+
+    /* Images of files on disk are read by rlottie from resource path, so JSON stays as it is */
+    QByteArray readData;
+    QVERIFY(readSource(source, readData));
+    QCOMPARE(readData, jsonData);
+}
+
+void PWLottieSourceReaderTest::resourcePath()
+{
+    const QString source = writeSource("resource.json", "{}");
+
+    /* rlottie appends path of image without separator */
+    QCOMPARE(QString::fromStdString(PWLottieSourceReader::resourcePath(source)), m_directory.path() + "/");
+}
+
+void PWLottieSourceReaderTest::gzip()
+{
+#ifdef PWLOTTIE_ZLIB
+    const QByteArray jsonData = R"({"tgs":1,"v":"5.5.2","fr":60,"ip":0,"op":180,"w":512,"h":512,"layers":[]})";
+    const QByteArray gzipData = deflated(jsonData, 15 + 16);
+
+    QVERIFY(PWLottieSourceReader::sourceFormat(reinterpret_cast<const uchar*>(gzipData.constData()), gzipData.size()) == PWLottieSourceReader::SourceFormat::Gzip);
+
+    QByteArray readData;
+    QVERIFY(readSource(writeSource("sticker.tgs", gzipData), readData));
+    QCOMPARE(readData, jsonData);
+#else
+    QSKIP("Library is built without zlib");
+#endif
+}
+
+void PWLottieSourceReaderTest::gzipGrowsBuffer()
+{
+#ifdef PWLOTTIE_ZLIB
+    /* Inflated size is far above inflation ratio that is trusted up front, so buffer has to grow */
+    const QByteArray jsonData = "{\"nm\":\"" + QByteArray(4 * 1024 * 1024, 'a') + "\",\"layers\":[]}";
+    const QByteArray gzipData = deflated(jsonData, 15 + 16);
+
+    QVERIFY(gzipData.size() * maxInflationRatio < jsonData.size());
+
+    QByteArray readData;
+    QVERIFY(readSource(writeSource("big.tgs", gzipData), readData));
+    QCOMPARE(readData, jsonData);
+#else
+    QSKIP("Library is built without zlib");
+#endif
+}
+
+void PWLottieSourceReaderTest::gzipTruncated()
+{
+#ifdef PWLOTTIE_ZLIB
+    const QByteArray gzipData = deflated(QByteArray(64 * 1024, ' '), 15 + 16);
+
+    QTest::ignoreMessage(QtWarningMsg, QRegularExpression("^Couldn't inflate lottie source"));
+
+    QByteArray readData;
+    QVERIFY(!readSource(writeSource("truncated.tgs", gzipData.left(gzipData.size() / 2)), readData));
+#else
+    QSKIP("Library is built without zlib");
+#endif
+}
+
+void PWLottieSourceReaderTest::archiveEmbedsImagesInPlace()
+{
+    const QByteArray firstImage = QByteArray(pngSignature) + "first";
+    const QByteArray secondImage = QByteArray(pngSignature) + "second";
+
+    /* Keys of assets are in different orders, one asset has no 'e' key, precomposition and embedded image aren't touched */
+    const QByteArray jsonData = R"({"v":"5.7.4","fr":30,"w":2,"h":2,"assets": [ )"
+                                R"({"id":"image_0","w":2,"h":2,"u":"/images/","p":"img_0.png","e":0}, )"
+                                R"({"id":"image_1","p":"img_1.png","u":"i/","w":2,"h":2}, )"
+                                R"({"id":"comp_0","u":"images/","p":"img_0.png","layers":[]}, )"
+                                R"({"id":"image_2","u":"","p":"data:image/png;base64,AAAA","e":1} )"
+                                R"(],"layers":[{"ty":2,"refId":"image_0"}]})";
+
+    /* Only 'u', 'p' and 'e' values of image assets are replaced, everything around them is kept byte by byte */
+    QByteArray expectedData = jsonData;
+    expectedData.replace(R"("u":"/images/","p":"img_0.png","e":0})", R"("u":"","p":"data:image/png;base64,)" + firstImage.toBase64() + R"(","e":1})");
+    expectedData.replace(R"("p":"img_1.png","u":"i/","w":2,"h":2})", R"("p":"data:image/png;base64,)" + secondImage.toBase64() + R"(","u":"","w":2,"h":2,"e":1})");
+
+    /* Animation that is sorted first isn't played, manifest selects another one */
+    const QByteArray archiveData = archive({ { "manifest.json", R"({"animations":[{"id":"main"}]})" },
+        { "animations/aaa.json", R"({"layers":[]})" },
+        { "animations/main.json", jsonData },
+        { "images/img_0.png", firstImage },
+        { "i/img_1.png", secondImage } });
+
+    QVERIFY(PWLottieSourceReader::sourceFormat(reinterpret_cast<const uchar*>(archiveData.constData()), archiveData.size()) == PWLottieSourceReader::SourceFormat::Zip);
+
+    QByteArray readData;
+    QVERIFY(readSource(writeSource("images.lottie", archiveData), readData));
+    QCOMPARE(readData, expectedData);
+}
+
+void PWLottieSourceReaderTest::archiveDeflated()
+{
+#ifdef PWLOTTIE_ZLIB
+    const QByteArray jsonData = R"({"v":"5.7.4","fr":30,"layers":[]})";
+
+    /* Archive without manifest plays it's first animation */
+    QByteArray readData;
+    QVERIFY(readSource(writeSource("deflated.lottie", archive({ { "a/second.json", R"({"layers":[]})", true }, { "a/first.json", jsonData, true } })), readData));
+    QCOMPARE(readData, jsonData);
+#else
+    QSKIP("Library is built without zlib");
+#endif
+}
+
+void PWLottieSourceReaderTest::archiveWithoutAnimation()
+{
+    QTest::ignoreMessage(QtWarningMsg, "dotLottie archive doesn't have any animation");
+
+    QByteArray readData;
+    QVERIFY(!readSource(writeSource("empty.lottie", archive({ { "images/img_0.png", pngSignature } })), readData));
+}
+
+///
+/// \brief PWLottieSourceReaderTest::writeSource - Function writes source into temporary directory.
+/// \param fileName - Name of source file.
+/// \param data - Content of source.
+/// \return Returns path of source.
+///
+QString PWLottieSourceReaderTest::writeSource(const QString& fileName, const QByteArray& data) const
+{
+    const QString source = m_directory.filePath(fileName);
+
+    QFile sourceFile(source);
+    if (!sourceFile.open(QFile::WriteOnly) || sourceFile.write(data) != data.size()) {
+        qFatal("Couldn't write test source");
+    }
+
+    return source;
+}
+
+///
+/// \brief PWLottieSourceReaderTest::readSource - Function reads source with PWLottieSourceReader.
+/// \param source - Path of source.
+/// \param jsonData - Lottie JSON.
+/// \return Returns true if source was read.
+///
+bool PWLottieSourceReaderTest::readSource(const QString& source, QByteArray& jsonData)
+{
+    std::string readData;
+
+    if (!PWLottieSourceReader::read(source, readData, nullptr)) {
+        return false;
+    }
+
+    jsonData = QByteArray(readData.data(), qsizetype(readData.size()));
+
+    return true;
+}
+
+///
+/// \brief PWLottieSourceReaderTest::archive - Function builds zip archive, CRC of files is left empty, reader doesn't check it.
+/// \param files - Files of archive.
+/// \return Returns archive data.
+///
+QByteArray PWLottieSourceReaderTest::archive(const QList<ArchiveFile>& files)
+{
+    const auto append16 = [](QByteArray& data, const quint16 value) {
+        const quint16 littleEndian = qToLittleEndian(value);
+        data.append(reinterpret_cast<const char*>(&littleEndian), sizeof(littleEndian));
+    };
+
+    const auto append32 = [](QByteArray& data, const quint32 value) {
+        const quint32 littleEndian = qToLittleEndian(value);
+        data.append(reinterpret_cast<const char*>(&littleEndian), sizeof(littleEndian));
+    };
+
+    QByteArray archiveData;
+    QByteArray directory;
+
+    for (const ArchiveFile& file : files) {
+        const QByteArray name = file.name.toUtf8();
+#ifdef PWLOTTIE_ZLIB
+        const QByteArray storedData = file.deflated ? deflated(file.data, -15) : file.data;
+#else
+        const QByteArray storedData = file.data;
+#endif
+        const quint16 method = file.deflated ? 8 : 0;
+        const quint32 localHeaderOffset = quint32(archiveData.size());
+
+        append32(archiveData, 0x04034b50);
+        append16(archiveData, 20);
+        append16(archiveData, 0);
+        append16(archiveData, method);
+        append32(archiveData, 0);
+        append32(archiveData, 0);
+        append32(archiveData, quint32(storedData.size()));
+        append32(archiveData, quint32(file.data.size()));
+        append16(archiveData, quint16(name.size()));
+        append16(archiveData, 0);
+        archiveData.append(name);
+        archiveData.append(storedData);
+
+        append32(directory, 0x02014b50);
+        append16(directory, 20);
+        append16(directory, 20);
+        append16(directory, 0);
+        append16(directory, method);
+        append32(directory, 0);
+        append32(directory, 0);
+        append32(directory, quint32(storedData.size()));
+        append32(directory, quint32(file.data.size()));
+        append16(directory, quint16(name.size()));
+        append16(directory, 0);
+        append16(directory, 0);
+        append16(directory, 0);
+        append16(directory, 0);
+        append32(directory, 0);
+        append32(directory, localHeaderOffset);
+        directory.append(name);
+    }
+
+    const quint32 directoryOffset = quint32(archiveData.size());
+    archiveData.append(directory);
+
+    append32(archiveData, 0x06054b50);
+    append16(archiveData, 0);
+    append16(archiveData, 0);
+    append16(archiveData, quint16(files.size()));
+    append16(archiveData, quint16(files.size()));
+    append32(archiveData, quint32(directory.size()));
+    append32(archiveData, directoryOffset);
+    append16(archiveData, 0);
+
+    return archiveData;
+}
+
+#ifdef PWLOTTIE_ZLIB
+///
+/// \brief PWLottieSourceReaderTest::deflated - Function compresses data with zlib.
+/// \param data - Data that is compressed.
+/// \param windowBits - Window bits of zlib, they select gzip or raw deflate stream.
+/// \return Returns compressed data.
+///
+QByteArray PWLottieSourceReaderTest::deflated(const QByteArray& data, const int windowBits)
+{
+    z_stream stream {};
+    if (deflateInit2(&stream, Z_BEST_COMPRESSION, Z_DEFLATED, windowBits, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        qFatal("Couldn't initialise zlib stream");
+    }
+
+    QByteArray output(qsizetype(deflateBound(&stream, uLong(data.size()))), Qt::Uninitialized);
+
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.constData()));
+    stream.avail_in = uInt(data.size());
+    stream.next_out = reinterpret_cast<Bytef*>(output.data());
+    stream.avail_out = uInt(output.size());
+
+    const int result = deflate(&stream, Z_FINISH);
+    output.resize(qsizetype(stream.total_out));
+    deflateEnd(&stream);
+
+    if (result != Z_STREAM_END) {
+        qFatal("Couldn't compress test data");
+    }
+
+    return output;
+}
+#endif
+
+QTEST_GUILESS_MAIN(PWLottieSourceReaderTest)
+
+#include "PWLottieSourceReaderTest.moc"